@@ -39,6 +39,7 @@ public class EmmyLuaIntelliSense : ModuleRules
 				"Slate",
 				"SlateCore",
 				"UnrealEd",
+				"BlueprintGraph",
 				"AssetRegistry",
 				"EditorStyle",
 				"EditorWidgets",
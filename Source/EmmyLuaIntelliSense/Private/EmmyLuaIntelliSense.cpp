@@ -1,12 +1,15 @@
 // Copyright Epic Games, Inc. All Rights Reserved.
 
 #include "EmmyLuaIntelliSense.h"
+#include "EmmyLuaIntelliSenseStats.h"
 #include "LuaExportManager.h"
 #include "LuaExportDialog.h"
+#include "LuaCodeGenerator.h"
 #include "EmmyLuaIntelliSenseSettings.h"
 #include "Engine/Engine.h"
 #include "Framework/Application/SlateApplication.h"
 #include "Misc/CoreDelegates.h"
+#include "UObject/UObjectGlobals.h"
 #include "Editor.h"
 #include "AssetRegistry/AssetRegistryModule.h"
 #include "ISettingsModule.h"
@@ -15,8 +18,45 @@
 
 DEFINE_LOG_CATEGORY(LogEmmyLuaIntelliSense);
 
+DEFINE_STAT(STAT_EmmyLua_CollectNativeTypes);
+DEFINE_STAT(STAT_EmmyLua_FingerprintAsset);
+DEFINE_STAT(STAT_EmmyLua_FingerprintNativeType);
+DEFINE_STAT(STAT_EmmyLua_HashFile);
+DEFINE_STAT(STAT_EmmyLua_LoadExportCache);
+DEFINE_STAT(STAT_EmmyLua_SaveExportCache);
+DEFINE_STAT(STAT_EmmyLua_LoadBlueprint);
+DEFINE_STAT(STAT_EmmyLua_SaveFile);
+DEFINE_STAT(STAT_EmmyLua_RebuildUETable);
+DEFINE_STAT(STAT_EmmyLua_ModuleBundles);
+DEFINE_STAT(STAT_EmmyLua_CopyUELib);
+DEFINE_STAT(STAT_EmmyLua_GenerateType);
+DEFINE_STAT(STAT_EmmyLua_GenerateBlueprint);
+DEFINE_STAT(STAT_EmmyLua_GenerateClass);
+DEFINE_STAT(STAT_EmmyLua_GenerateStruct);
+DEFINE_STAT(STAT_EmmyLua_GenerateEnum);
+DEFINE_STAT(STAT_EmmyLua_GenerateUETable);
+DEFINE_STAT(STAT_EmmyLua_BuildDescriptor);
+DEFINE_STAT(STAT_EmmyLua_RenderDialect);
+DEFINE_STAT(STAT_EmmyLua_TypesGenerated);
+DEFINE_STAT(STAT_EmmyLua_BlueprintsLoaded);
+DEFINE_STAT(STAT_EmmyLua_FilesWritten);
+DEFINE_STAT(STAT_EmmyLua_FilesUnchanged);
+DEFINE_STAT(STAT_EmmyLua_BytesWritten);
+DEFINE_STAT(STAT_EmmyLua_HitchFrames);
+DEFINE_STAT(STAT_EmmyLuaLLM_Plugin);
+DEFINE_STAT(STAT_EmmyLuaLLM_HashCache);
+DEFINE_STAT(STAT_EmmyLuaLLM_PendingChanges);
+DEFINE_STAT(STAT_EmmyLuaLLM_GeneratedCode);
+DEFINE_STAT(STAT_EmmyLuaLLM_ScanResults);
+DEFINE_STAT(STAT_EmmyLuaLLM_Blueprints);
+DEFINE_STAT(STAT_EmmyLuaLLM_SymbolIndex);
+
 void FEmmyLuaIntelliSenseModule::StartupModule()
 {
+	EMMYLUA_LLM_SCOPE(Plugin);
+	// 生成器也会在自动化测试中使用，GC回调在任何模式下都注册
+	PostGarbageCollectHandle = FCoreUObjectDelegates::GetPostGarbageCollect().AddStatic(&FEmmyLuaCodeGenerator::OnPostGarbageCollect);
+
 	// 只在Editor中执行，不在commandlet中执行
 	if (IsRunningCommandlet() || !GIsEditor)
 	{
@@ -30,6 +70,8 @@ void FEmmyLuaIntelliSenseModule::StartupModule()
 
 void FEmmyLuaIntelliSenseModule::ShutdownModule()
 {
+	FCoreUObjectDelegates::GetPostGarbageCollect().Remove(PostGarbageCollectHandle);
+
 	// 只在Editor中执行，不在commandlet中执行
 	if (IsRunningCommandlet() || !GIsEditor)
 	{
@@ -88,6 +130,7 @@ void FEmmyLuaIntelliSenseModule::OnPostEngineInit()
 	FAssetRegistryModule& AssetRegistryModule = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry");
 	IAssetRegistry& AssetRegistry = AssetRegistryModule.Get();
 	
+	// 扫描需要完整的资产列表，仍等到发现结束；发现期间导出管理器已在后台预先计算蓝图指纹
 	if (AssetRegistry.IsLoadingAssets())
 	{
 		AssetRegistry.OnFilesLoaded().AddRaw(this, &FEmmyLuaIntelliSenseModule::OnAssetRegistryFilesLoaded);
@@ -114,17 +157,10 @@ void FEmmyLuaIntelliSenseModule::InitializeLuaExportManager()
 		return;
 	}
 
-#if !PLATFORM_WINDOWS
-	return;
-#endif
-	
-	if (IsRunningCommandlet() || !GIsEditor)
-	{
-		return ;
-	}
-
-	if (!FSlateApplication::IsInitialized())
+	// 不进行启动扫描时，发现阶段预先计算的指纹不再有用
+	if (!ULuaExportManager::CanScanOnStartup() || !FSlateApplication::IsInitialized())
 	{
+		ExportManager->DiscardPrefetchedFingerprints();
 		return;
 	}
 
@@ -18,6 +18,12 @@ UEmmyLuaIntelliSenseSettings* UEmmyLuaIntelliSenseSettings::GetMutable()
     return GetMutableDefault<UEmmyLuaIntelliSenseSettings>();
 }
 
+uint32 UEmmyLuaIntelliSenseSettings::GetEnabledDialectMask() const
+{
+    const uint32 AllDialects = (1u << static_cast<uint32>(EEmmyLuaDialect::Count)) - 1;
+    return (static_cast<uint32>(AdditionalDialects) & AllDialects) | (1u << static_cast<uint32>(EEmmyLuaDialect::EmmyLua));
+}
+
 FName UEmmyLuaIntelliSenseSettings::GetCategoryName() const
 {
     return TEXT("Plugins");
@@ -0,0 +1,61 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Stats/Stats.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+#include "HAL/LowLevelMemTracker.h"
+#include "HAL/LowLevelMemStats.h"
+
+// 控制台输入 stat EmmyLua 查看，Unreal Insights中对应EmmyLua_*事件
+DECLARE_STATS_GROUP(TEXT("EmmyLua"), STATGROUP_EmmyLua, STATCAT_Advanced);
+
+// ----- 导出阶段 -----
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Collect Native Types"), STAT_EmmyLua_CollectNativeTypes, STATGROUP_EmmyLua, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Fingerprint Assets"), STAT_EmmyLua_FingerprintAsset, STATGROUP_EmmyLua, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Fingerprint Native Types"), STAT_EmmyLua_FingerprintNativeType, STATGROUP_EmmyLua, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Hash File"), STAT_EmmyLua_HashFile, STATGROUP_EmmyLua, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Load Export Cache"), STAT_EmmyLua_LoadExportCache, STATGROUP_EmmyLua, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Save Export Cache"), STAT_EmmyLua_SaveExportCache, STATGROUP_EmmyLua, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Load Blueprint"), STAT_EmmyLua_LoadBlueprint, STATGROUP_EmmyLua, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Save File"), STAT_EmmyLua_SaveFile, STATGROUP_EmmyLua, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Rebuild UE Table"), STAT_EmmyLua_RebuildUETable, STATGROUP_EmmyLua, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Module Bundles"), STAT_EmmyLua_ModuleBundles, STATGROUP_EmmyLua, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Copy UELib"), STAT_EmmyLua_CopyUELib, STATGROUP_EmmyLua, );
+
+// ----- 代码生成 -----
+DECLARE_CYCLE_STAT_EXTERN(TEXT("GenerateType"), STAT_EmmyLua_GenerateType, STATGROUP_EmmyLua, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("GenerateBlueprint"), STAT_EmmyLua_GenerateBlueprint, STATGROUP_EmmyLua, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("GenerateClass"), STAT_EmmyLua_GenerateClass, STATGROUP_EmmyLua, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("GenerateStruct"), STAT_EmmyLua_GenerateStruct, STATGROUP_EmmyLua, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("GenerateEnum"), STAT_EmmyLua_GenerateEnum, STATGROUP_EmmyLua, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("GenerateUETable"), STAT_EmmyLua_GenerateUETable, STATGROUP_EmmyLua, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Build Type Descriptor"), STAT_EmmyLua_BuildDescriptor, STATGROUP_EmmyLua, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Render Dialect"), STAT_EmmyLua_RenderDialect, STATGROUP_EmmyLua, );
+
+// ----- 计数（累计值，编辑器运行期间不清零；字节数用QWORD，长时间运行不会溢出） -----
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Types Generated"), STAT_EmmyLua_TypesGenerated, STATGROUP_EmmyLua, );
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Blueprints Loaded"), STAT_EmmyLua_BlueprintsLoaded, STATGROUP_EmmyLua, );
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Files Written"), STAT_EmmyLua_FilesWritten, STATGROUP_EmmyLua, );
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Files Unchanged"), STAT_EmmyLua_FilesUnchanged, STATGROUP_EmmyLua, );
+DECLARE_QWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Bytes Written"), STAT_EmmyLua_BytesWritten, STATGROUP_EmmyLua, );
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Hitch Frames"), STAT_EmmyLua_HitchFrames, STATGROUP_EmmyLua, );
+
+// ----- LLM内存标签（编辑器加 -llm 启动，stat LLMFULL 或 memreport 中查看） -----
+DECLARE_LLM_MEMORY_STAT_EXTERN(TEXT("EmmyLua"), STAT_EmmyLuaLLM_Plugin, STATGROUP_LLMFULL, );
+DECLARE_LLM_MEMORY_STAT_EXTERN(TEXT("EmmyLua HashCache"), STAT_EmmyLuaLLM_HashCache, STATGROUP_LLMFULL, );
+DECLARE_LLM_MEMORY_STAT_EXTERN(TEXT("EmmyLua PendingChanges"), STAT_EmmyLuaLLM_PendingChanges, STATGROUP_LLMFULL, );
+DECLARE_LLM_MEMORY_STAT_EXTERN(TEXT("EmmyLua GeneratedCode"), STAT_EmmyLuaLLM_GeneratedCode, STATGROUP_LLMFULL, );
+DECLARE_LLM_MEMORY_STAT_EXTERN(TEXT("EmmyLua ScanResults"), STAT_EmmyLuaLLM_ScanResults, STATGROUP_LLMFULL, );
+DECLARE_LLM_MEMORY_STAT_EXTERN(TEXT("EmmyLua Blueprints"), STAT_EmmyLuaLLM_Blueprints, STATGROUP_LLMFULL, );
+DECLARE_LLM_MEMORY_STAT_EXTERN(TEXT("EmmyLua SymbolIndex"), STAT_EmmyLuaLLM_SymbolIndex, STATGROUP_LLMFULL, );
+
+/** 把作用域内的分配记到插件的LLM标签上，内层标签优先 */
+#define EMMYLUA_LLM_SCOPE(Name) \
+    LLM_SCOPED_TAG_WITH_STAT(STAT_EmmyLuaLLM_##Name, ELLMTracker::Default)
+
+/** 同时记录Insights事件和stat周期计数 */
+#define EMMYLUA_SCOPE_CYCLE_COUNTER(Name) \
+    TRACE_CPUPROFILER_EVENT_SCOPE(EmmyLua_##Name); \
+    SCOPE_CYCLE_COUNTER(STAT_EmmyLua_##Name)
@@ -0,0 +1,129 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "LuaChangeRecorder.h"
+#include "EmmyLuaIntelliSense.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Dom/JsonObject.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/JsonWriter.h"
+#include "Serialization/JsonReader.h"
+#include "Policies/CondensedJsonPrintPolicy.h"
+
+namespace
+{
+    const TCHAR* EventTypeNames[] = {
+        TEXT("AssetAdded"), TEXT("AssetUpdated"), TEXT("AssetRenamed"), TEXT("AssetRemoved"),
+        TEXT("BlueprintCompiled"), TEXT("ModuleLoaded"), TEXT("ModuleUnloaded")
+    };
+    static_assert(UE_ARRAY_COUNT(EventTypeNames) == static_cast<int32>(ELuaChangeEventType::Count), "Change event name table out of date");
+}
+
+const TCHAR* FLuaChangeEvent::GetTypeName(ELuaChangeEventType Type)
+{
+    return EventTypeNames[static_cast<int32>(Type)];
+}
+
+bool FLuaChangeEvent::ParseTypeName(const FString& Name, ELuaChangeEventType& OutType)
+{
+    for (int32 Index = 0; Index < static_cast<int32>(ELuaChangeEventType::Count); ++Index)
+    {
+        if (Name.Equals(EventTypeNames[Index], ESearchCase::IgnoreCase))
+        {
+            OutType = static_cast<ELuaChangeEventType>(Index);
+            return true;
+        }
+    }
+    return false;
+}
+
+FLuaChangeRecorder::~FLuaChangeRecorder()
+{
+    Stop();
+}
+
+bool FLuaChangeRecorder::Start(const FString& InFilePath)
+{
+    Stop();
+    IFileManager::Get().MakeDirectory(*FPaths::GetPath(InFilePath), true);
+    Writer.Reset(IFileManager::Get().CreateFileWriter(*InFilePath));
+    if (!Writer.IsValid())
+    {
+        UE_LOG(LogEmmyLuaIntelliSense, Error, TEXT("[RECORD] Failed to open recording file: %s"), *InFilePath);
+        return false;
+    }
+    FilePath = InFilePath;
+    StartTime = FPlatformTime::Seconds();
+    EventCount = 0;
+    UE_LOG(LogEmmyLuaIntelliSense, Log, TEXT("[RECORD] Recording change events to: %s"), *FilePath);
+    return true;
+}
+
+void FLuaChangeRecorder::Stop()
+{
+    if (!Writer.IsValid())
+    {
+        return;
+    }
+    Writer->Close();
+    Writer.Reset();
+    UE_LOG(LogEmmyLuaIntelliSense, Log, TEXT("[RECORD] Recorded %d change events in %.1fs: %s"),
+        EventCount, FPlatformTime::Seconds() - StartTime, *FilePath);
+    FilePath.Empty();
+}
+
+void FLuaChangeRecorder::Record(const FLuaChangeEvent& Event)
+{
+    if (!Writer.IsValid())
+    {
+        return;
+    }
+    TSharedPtr<FJsonObject> EventObject = MakeShareable(new FJsonObject);
+    EventObject->SetNumberField(TEXT("Time"), FPlatformTime::Seconds() - StartTime);
+    EventObject->SetStringField(TEXT("Type"), FLuaChangeEvent::GetTypeName(Event.Type));
+    EventObject->SetStringField(TEXT("Path"), Event.Path);
+    if (!Event.OldPath.IsEmpty())
+    {
+        EventObject->SetStringField(TEXT("OldPath"), Event.OldPath);
+    }
+    FString Line;
+    TSharedRef<TJsonWriter<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>> JsonWriter = TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>::Create(&Line);
+    FJsonSerializer::Serialize(EventObject.ToSharedRef(), JsonWriter);
+    Line += TEXT("\n");
+    // 每个事件立即落盘，编辑器崩溃时录制内容也完整
+    FTCHARToUTF8 Converter(*Line, Line.Len());
+    Writer->Serialize(const_cast<ANSICHAR*>(Converter.Get()), Converter.Length());
+    Writer->Flush();
+    ++EventCount;
+}
+
+bool FLuaChangeRecorder::Load(const FString& InFilePath, TArray<FLuaChangeEvent>& OutEvents)
+{
+    OutEvents.Reset();
+    TArray<FString> Lines;
+    if (!FFileHelper::LoadFileToStringArray(Lines, *InFilePath))
+    {
+        UE_LOG(LogEmmyLuaIntelliSense, Error, TEXT("[REPLAY] Failed to read recording: %s"), *InFilePath);
+        return false;
+    }
+    OutEvents.Reserve(Lines.Num());
+    for (const FString& Line : Lines)
+    {
+        TSharedPtr<FJsonObject> EventObject;
+        TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(Line);
+        FString TypeName;
+        FLuaChangeEvent Event;
+        if (Line.IsEmpty() || !FJsonSerializer::Deserialize(Reader, EventObject) || !EventObject.IsValid()
+            || !EventObject->TryGetStringField(TEXT("Type"), TypeName) || !FLuaChangeEvent::ParseTypeName(TypeName, Event.Type)
+            || !EventObject->TryGetStringField(TEXT("Path"), Event.Path))
+        {
+            continue;
+        }
+        EventObject->TryGetNumberField(TEXT("Time"), Event.Time);
+        EventObject->TryGetStringField(TEXT("OldPath"), Event.OldPath);
+        OutEvents.Add(MoveTemp(Event));
+    }
+    return true;
+}
@@ -0,0 +1,174 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "LuaExportManager.h"
+#include "LuaChangeRecorder.h"
+#include "EmmyLuaIntelliSense.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformTime.h"
+#include "Containers/Ticker.h"
+#include "Misc/DateTime.h"
+#include "Misc/Paths.h"
+
+namespace
+{
+    /** 正在进行的重放，同一时间只有一个 */
+    struct FReplaySession
+    {
+        TArray<FLuaChangeEvent> Events;
+        int32                   NextEvent = 0;
+        double                  StartTime = 0.0;
+        float                   Speed = 1.0f;           // 时间倍速，0表示不等待直接按顺序派发
+        bool                    bExportEach = false;    // 每批事件后立即处理，不等合并窗口
+    };
+
+    TUniquePtr<FReplaySession> ActiveReplay;
+
+    /** 重放的输出和导出缓存所在的临时目录，重放的删除和导出不触碰工程的正式输出 */
+    FString GetReplayOutputDir()
+    {
+        return FPaths::Combine(FPaths::ProjectIntermediateDir(), TEXT("EmmyLuaReplay"));
+    }
+
+    void FinishReplay(ULuaExportManager* ExportManager)
+    {
+        // 剩余的事件不等合并窗口，直接作为最后一批处理
+        ExportManager->FlushChangeEvents();
+        ExportManager->EndOutputRedirect();
+        // 统计在重放开始时已清空，这里就是本次重放的数据
+        const FLuaChangeBatchStats& Stats = ExportManager->GetChangeBatchStats();
+        const double ExportMs = Stats.ExportSeconds * 1000.0;
+        UE_LOG(LogEmmyLuaIntelliSense, Log, TEXT("[REPLAY] Replayed %d events in %.2fs: %d batches (%d changes), %d incremental exports, total %.1fms, avg %.1fms, max %.1fms"),
+            ActiveReplay->Events.Num(), FPlatformTime::Seconds() - ActiveReplay->StartTime,
+            Stats.Batches, Stats.Changes, Stats.Exports, ExportMs,
+            Stats.Exports > 0 ? ExportMs / Stats.Exports : 0.0, Stats.MaxExportSeconds * 1000.0);
+        ActiveReplay.Reset();
+    }
+
+    bool TickReplay(float DeltaTime)
+    {
+        ULuaExportManager* ExportManager = ULuaExportManager::Get();
+        if (!ExportManager || !ActiveReplay.IsValid())
+        {
+            // 导出管理器已关闭时由Deinitialize恢复输出
+            ActiveReplay.Reset();
+            return false;
+        }
+        const double Elapsed = (FPlatformTime::Seconds() - ActiveReplay->StartTime) * ActiveReplay->Speed;
+        bool bDispatched = false;
+        while (ActiveReplay->NextEvent < ActiveReplay->Events.Num())
+        {
+            const FLuaChangeEvent& Event = ActiveReplay->Events[ActiveReplay->NextEvent];
+            if (ActiveReplay->Speed > 0.0f && Event.Time > Elapsed)
+            {
+                break;
+            }
+            ExportManager->HandleChangeEvent(Event);
+            ++ActiveReplay->NextEvent;
+            bDispatched = true;
+            // 不等待时每个事件单独成批，否则同一帧到期的事件合为一批
+            if (ActiveReplay->bExportEach && ActiveReplay->Speed <= 0.0f)
+            {
+                ExportManager->FlushChangeEvents();
+            }
+        }
+        if (ActiveReplay->bExportEach && bDispatched)
+        {
+            ExportManager->FlushChangeEvents();
+        }
+        if (ActiveReplay->NextEvent < ActiveReplay->Events.Num())
+        {
+            return true;
+        }
+        FinishReplay(ExportManager);
+        return false;
+    }
+
+    void StartRecording(const TArray<FString>& Args)
+    {
+        ULuaExportManager* ExportManager = ULuaExportManager::Get();
+        if (!ExportManager)
+        {
+            return;
+        }
+        if (ActiveReplay.IsValid())
+        {
+            UE_LOG(LogEmmyLuaIntelliSense, Warning, TEXT("[REPLAY] Cannot record while a replay is running"));
+            return;
+        }
+        FString FilePath = Args.Num() > 0 ? Args[0] : FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("EmmyLuaRecordings"),
+            FString::Printf(TEXT("Session_%s.jsonl"), *FDateTime::Now().ToString()));
+        ExportManager->GetChangeRecorder().Start(FPaths::ConvertRelativePathToFull(FilePath));
+    }
+
+    void StopRecording()
+    {
+        if (ULuaExportManager* ExportManager = ULuaExportManager::Get())
+        {
+            ExportManager->GetChangeRecorder().Stop();
+        }
+    }
+
+    void StartReplay(const TArray<FString>& Args)
+    {
+        if (ActiveReplay.IsValid())
+        {
+            UE_LOG(LogEmmyLuaIntelliSense, Warning, TEXT("[REPLAY] A replay is already running"));
+            return;
+        }
+        if (Args.Num() == 0 || !ULuaExportManager::Get())
+        {
+            UE_LOG(LogEmmyLuaIntelliSense, Warning, TEXT("[REPLAY] Usage: EmmyLua.Replay <File> [Speed=N] [-ExportEach]"));
+            return;
+        }
+        TUniquePtr<FReplaySession> Session = MakeUnique<FReplaySession>();
+        if (!FLuaChangeRecorder::Load(Args[0], Session->Events))
+        {
+            return;
+        }
+        for (int32 Index = 1; Index < Args.Num(); ++Index)
+        {
+            FString Key, Value;
+            if (Args[Index].Equals(TEXT("-ExportEach"), ESearchCase::IgnoreCase))
+            {
+                Session->bExportEach = true;
+            }
+            else if (Args[Index].Split(TEXT("="), &Key, &Value) && Key.Equals(TEXT("Speed"), ESearchCase::IgnoreCase))
+            {
+                Session->Speed = FMath::Max(0.0f, FCString::Atof(*Value));
+            }
+        }
+        UE_LOG(LogEmmyLuaIntelliSense, Log, TEXT("[REPLAY] Replaying %d events from %s (speed %.1f%s)"),
+            Session->Events.Num(), *Args[0], Session->Speed, Session->bExportEach ? TEXT(", export each batch") : TEXT(""));
+        ULuaExportManager* ExportManager = ULuaExportManager::Get();
+        // 重放派发的事件不能再被录制回去
+        if (ExportManager->GetChangeRecorder().IsRecording())
+        {
+            UE_LOG(LogEmmyLuaIntelliSense, Warning, TEXT("[REPLAY] Stopping the active recording: %s"), *ExportManager->GetChangeRecorder().GetFilePath());
+            ExportManager->GetChangeRecorder().Stop();
+        }
+        // 每次重放从空的临时输出开始，录制中的删除和重命名只作用于临时目录
+        const FString ReplayOutputDir = GetReplayOutputDir();
+        IFileManager::Get().DeleteDirectory(*ReplayOutputDir, false, true);
+        ExportManager->BeginOutputRedirect(ReplayOutputDir);
+        ExportManager->ResetChangeBatchStats();
+        Session->StartTime = FPlatformTime::Seconds();
+        ActiveReplay = MoveTemp(Session);
+        FTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateStatic(&TickReplay), 0.0f);
+    }
+
+    FAutoConsoleCommand RecordStartCommand(
+        TEXT("EmmyLua.Record.Start"),
+        TEXT("Record blueprint/module change events to a JSON Lines file for later replay. Usage: EmmyLua.Record.Start [File] (default Saved/EmmyLuaRecordings/Session_<time>.jsonl)"),
+        FConsoleCommandWithArgsDelegate::CreateStatic(&StartRecording));
+
+    FAutoConsoleCommand RecordStopCommand(
+        TEXT("EmmyLua.Record.Stop"),
+        TEXT("Stop recording change events"),
+        FConsoleCommandDelegate::CreateStatic(&StopRecording));
+
+    FAutoConsoleCommand ReplayCommand(
+        TEXT("EmmyLua.Replay"),
+        TEXT("Replay a recorded change session with its original timing and measure incremental export cost. Changes are batched by the coalescing window unless -ExportEach is given. Output and export cache are redirected to Intermediate/EmmyLuaReplay during the replay. Usage: EmmyLua.Replay <File> [Speed=N] [-ExportEach] (Speed=0 dispatches without waiting)"),
+        FConsoleCommandWithArgsDelegate::CreateStatic(&StartReplay));
+}
@@ -2,156 +2,1190 @@
 
 #include "LuaCodeGenerator.h"
 #include "EmmyLuaIntelliSense.h"
+#include "EmmyLuaIntelliSenseStats.h"
 #include "Engine/Blueprint.h"
 #include "Engine/BlueprintGeneratedClass.h"
 #include "Engine/UserDefinedStruct.h"
 #include "Engine/UserDefinedEnum.h"
 #include "Engine/Engine.h"
-#include "Misc/DateTime.h"
+#include "Misc/ScopeLock.h"
+#include "UObject/MetaData.h"
+#include "UObject/Package.h"
+#include "UObject/UnrealType.h"
+
+namespace
+{
+    /** 属性类型分类，决定类型名称的生成方式 */
+    enum class EPropertyKind : uint8
+    {
+        Unknown,
+        Integer,
+        Number,
+        Boolean,
+        String,
+        Enum,
+        Class,
+        SoftClass,
+        SoftObject,
+        Object,
+        WeakObject,
+        LazyObject,
+        Interface,
+        Struct,
+        Array,
+        Map,
+        Set,
+        Count
+    };
+
+    /** 引擎内置属性类的ID（CASTCLASS_标志）到属性分类的映射 */
+    struct FPropertyKindEntry
+    {
+        uint64          Id;
+        EPropertyKind   Kind;
+    };
+
+    constexpr FPropertyKindEntry PropertyKindEntries[] =
+    {
+        { CASTCLASS_FByteProperty,          EPropertyKind::Integer },
+        { CASTCLASS_FInt8Property,          EPropertyKind::Integer },
+        { CASTCLASS_FInt16Property,         EPropertyKind::Integer },
+        { CASTCLASS_FIntProperty,           EPropertyKind::Integer },
+        { CASTCLASS_FInt64Property,         EPropertyKind::Integer },
+        { CASTCLASS_FUInt16Property,        EPropertyKind::Integer },
+        { CASTCLASS_FUInt32Property,        EPropertyKind::Integer },
+        { CASTCLASS_FUInt64Property,        EPropertyKind::Integer },
+        { CASTCLASS_FFloatProperty,         EPropertyKind::Number },
+        { CASTCLASS_FDoubleProperty,        EPropertyKind::Number },
+        { CASTCLASS_FBoolProperty,          EPropertyKind::Boolean },
+        { CASTCLASS_FNameProperty,          EPropertyKind::String },
+        { CASTCLASS_FStrProperty,           EPropertyKind::String },
+        { CASTCLASS_FTextProperty,          EPropertyKind::String },
+        { CASTCLASS_FEnumProperty,          EPropertyKind::Enum },
+        { CASTCLASS_FClassProperty,         EPropertyKind::Class },
+        { CASTCLASS_FSoftClassProperty,     EPropertyKind::SoftClass },
+        { CASTCLASS_FSoftObjectProperty,    EPropertyKind::SoftObject },
+        { CASTCLASS_FObjectProperty,        EPropertyKind::Object },
+        { CASTCLASS_FWeakObjectProperty,    EPropertyKind::WeakObject },
+        { CASTCLASS_FLazyObjectProperty,    EPropertyKind::LazyObject },
+        { CASTCLASS_FInterfaceProperty,     EPropertyKind::Interface },
+        { CASTCLASS_FStructProperty,        EPropertyKind::Struct },
+        { CASTCLASS_FArrayProperty,         EPropertyKind::Array },
+        { CASTCLASS_FMapProperty,           EPropertyKind::Map },
+        { CASTCLASS_FSetProperty,           EPropertyKind::Set },
+    };
+
+    constexpr int32 GetCastFlagBitIndex(uint64 Id)
+    {
+        int32 Index = 0;
+        while (Id > 1)
+        {
+            Id >>= 1;
+            ++Index;
+        }
+        return Index;
+    }
+
+    /** 按CASTCLASS_标志的位序号索引的分类表，编译期构建 */
+    struct FPropertyKindTable
+    {
+        EPropertyKind Kinds[64];
+
+        constexpr FPropertyKindTable()
+            : Kinds{}
+        {
+            for (const FPropertyKindEntry& Entry : PropertyKindEntries)
+            {
+                Kinds[GetCastFlagBitIndex(Entry.Id)] = Entry.Kind;
+            }
+        }
+    };
+
+    constexpr FPropertyKindTable PropertyKindTable;
+
+    /** 非引擎内置的属性类（插件自定义的派生类）走CastField级联分类 */
+    EPropertyKind ClassifyPropertySlow(const FProperty* Property)
+    {
+        if (CastField<FNumericProperty>(Property))
+        {
+            return CastField<FFloatProperty>(Property) || CastField<FDoubleProperty>(Property) ? EPropertyKind::Number : EPropertyKind::Integer;
+        }
+        if (CastField<FBoolProperty>(Property))
+            return EPropertyKind::Boolean;
+        if (CastField<FNameProperty>(Property) || CastField<FStrProperty>(Property) || CastField<FTextProperty>(Property))
+            return EPropertyKind::String;
+        if (CastField<FEnumProperty>(Property))
+            return EPropertyKind::Enum;
+        if (CastField<FClassProperty>(Property))
+            return EPropertyKind::Class;
+        if (CastField<FSoftClassProperty>(Property))
+            return EPropertyKind::SoftClass;
+        if (CastField<FSoftObjectProperty>(Property))
+            return EPropertyKind::SoftObject;
+        if (CastField<FObjectProperty>(Property))
+            return EPropertyKind::Object;
+        if (CastField<FWeakObjectProperty>(Property))
+            return EPropertyKind::WeakObject;
+        if (CastField<FLazyObjectProperty>(Property))
+            return EPropertyKind::LazyObject;
+        if (CastField<FInterfaceProperty>(Property))
+            return EPropertyKind::Interface;
+        if (CastField<FStructProperty>(Property))
+            return EPropertyKind::Struct;
+        if (CastField<FArrayProperty>(Property))
+            return EPropertyKind::Array;
+        if (CastField<FMapProperty>(Property))
+            return EPropertyKind::Map;
+        if (CastField<FSetProperty>(Property))
+            return EPropertyKind::Set;
+        return EPropertyKind::Unknown;
+    }
+
+    /**
+     * 属性类型的形状键
+     * 字段类 + 引用的类型对象 + 容器元素类型名称的驻留索引，形状相同的属性共享同一个类型名称
+     */
+    struct FPropertyShapeKey
+    {
+        const FFieldClass*  FieldClass = nullptr;  // 属性的字段类
+        const void*         TypeObject = nullptr;  // 引用的UEnum/UClass/UScriptStruct，未知属性类型时为属性自身
+        int32               InnerA     = INDEX_NONE; // 容器元素（TMap的键）类型名称索引
+        int32               InnerB     = INDEX_NONE; // TMap的值类型名称索引
+
+        bool operator==(const FPropertyShapeKey& Other) const
+        {
+            return FieldClass == Other.FieldClass
+                && TypeObject == Other.TypeObject
+                && InnerA == Other.InnerA
+                && InnerB == Other.InnerB;
+        }
+
+        friend uint32 GetTypeHash(const FPropertyShapeKey& Key)
+        {
+            uint32 Hash = HashCombine(PointerHash(Key.FieldClass), PointerHash(Key.TypeObject));
+            return HashCombine(Hash, HashCombine(::GetTypeHash(Key.InnerA), ::GetTypeHash(Key.InnerB)));
+        }
+    };
+
+    /**
+     * 类型名称驻留表
+     * 在一次导出过程中共享，按UStruct/UEnum对象和属性形状缓存已生成的类型名称
+     */
+    struct FTypeNameCache
+    {
+        FCriticalSection                        Lock;              // 保护下列容器
+        TArray<FString>                         Names;             // 驻留的类型名称
+        TMap<FString, int32>                    NameToId;          // 类型名称 -> 索引
+        TMap<const UObject*, int32>             ObjectToId;        // UStruct/UEnum等对象 -> 类型名称索引
+        TMap<FPropertyShapeKey, int32>          ShapeToId;         // 属性形状 -> 类型名称索引
+        TMap<const FFieldClass*, EPropertyKind> SlowKinds;         // 自定义属性类的分类结果
+        int32                                   LeafIds[(int32)EPropertyKind::Count]; // 基础类型名称的驻留索引
+
+        FTypeNameCache()
+        {
+            Reset();
+        }
+
+        void Reset()
+        {
+            Names.Reset();
+            NameToId.Reset();
+            ObjectToId.Reset();
+            ShapeToId.Reset();
+            SlowKinds.Reset();
+            for (int32& LeafId : LeafIds)
+            {
+                LeafId = INDEX_NONE;
+            }
+            LeafIds[(int32)EPropertyKind::Unknown] = Intern(TEXT("any"));
+            LeafIds[(int32)EPropertyKind::Integer] = Intern(TEXT("integer"));
+            LeafIds[(int32)EPropertyKind::Number] = Intern(TEXT("number"));
+            LeafIds[(int32)EPropertyKind::Boolean] = Intern(TEXT("boolean"));
+            LeafIds[(int32)EPropertyKind::String] = Intern(TEXT("string"));
+        }
+
+        int32 Intern(const FString& Name)
+        {
+            if (const int32* ExistingId = NameToId.Find(Name))
+            {
+                return *ExistingId;
+            }
+            const int32 Id = Names.Add(Name);
+            NameToId.Add(Name, Id);
+            return Id;
+        }
+
+        EPropertyKind GetPropertyKind(const FProperty* Property)
+        {
+            const FFieldClass* FieldClass = Property->GetClass();
+            const uint64 Id = FieldClass->GetId();
+            if (Id != 0 && (Id & (Id - 1)) == 0)
+            {
+                const EPropertyKind Kind = PropertyKindTable.Kinds[FMath::CountTrailingZeros64(Id)];
+                if (Kind != EPropertyKind::Unknown)
+                {
+                    return Kind;
+                }
+            }
+
+            if (const EPropertyKind* CachedKind = SlowKinds.Find(FieldClass))
+            {
+                return *CachedKind;
+            }
+            const EPropertyKind Kind = ClassifyPropertySlow(Property);
+            SlowKinds.Add(FieldClass, Kind);
+            return Kind;
+        }
+
+        int32 ResolveObject(const UObject* Object)
+        {
+            if (const int32* CachedId = ObjectToId.Find(Object))
+            {
+                return *CachedId;
+            }
+
+            FString Name = Object->GetName();
+            if (Object->IsNative() || !Name.EndsWith(TEXT("_C")))
+            {
+                if (const UStruct* Struct = Cast<UStruct>(Object))
+                {
+                    Name = Struct->GetPrefixCPP() + Name;
+                }
+            }
+
+            const int32 Id = Intern(Name);
+            ObjectToId.Add(Object, Id);
+            return Id;
+        }
+
+        int32 ResolveProperty(const FProperty* Property)
+        {
+            if (!Property)
+            {
+                return LeafIds[(int32)EPropertyKind::Unknown];
+            }
+
+            const EPropertyKind Kind = GetPropertyKind(Property);
+            FPropertyShapeKey Key;
+            Key.FieldClass = Property->GetClass();
+            switch (Kind)
+            {
+            case EPropertyKind::Integer:
+            case EPropertyKind::Number:
+            case EPropertyKind::Boolean:
+            case EPropertyKind::String:
+                return LeafIds[(int32)Kind];
+            case EPropertyKind::Enum:
+                Key.TypeObject = static_cast<const FEnumProperty*>(Property)->GetEnum();
+                break;
+            case EPropertyKind::Class:
+                Key.TypeObject = static_cast<const FClassProperty*>(Property)->MetaClass;
+                break;
+            case EPropertyKind::SoftClass:
+            {
+                const FSoftClassProperty* SoftClassProperty = static_cast<const FSoftClassProperty*>(Property);
+                Key.TypeObject = SoftClassProperty->MetaClass ? SoftClassProperty->MetaClass : SoftClassProperty->PropertyClass;
+                break;
+            }
+            case EPropertyKind::SoftObject:
+            case EPropertyKind::Object:
+            case EPropertyKind::WeakObject:
+            case EPropertyKind::LazyObject:
+                Key.TypeObject = static_cast<const FObjectPropertyBase*>(Property)->PropertyClass;
+                break;
+            case EPropertyKind::Interface:
+                Key.TypeObject = static_cast<const FInterfaceProperty*>(Property)->InterfaceClass;
+                break;
+            case EPropertyKind::Struct:
+                Key.TypeObject = static_cast<const FStructProperty*>(Property)->Struct;
+                break;
+            case EPropertyKind::Array:
+                Key.InnerA = ResolveProperty(static_cast<const FArrayProperty*>(Property)->Inner);
+                break;
+            case EPropertyKind::Map:
+                Key.InnerA = ResolveProperty(static_cast<const FMapProperty*>(Property)->KeyProp);
+                Key.InnerB = ResolveProperty(static_cast<const FMapProperty*>(Property)->ValueProp);
+                break;
+            case EPropertyKind::Set:
+                Key.InnerA = ResolveProperty(static_cast<const FSetProperty*>(Property)->ElementProp);
+                break;
+            default:
+                // 未知属性类型按CPP类型名导出，只能按属性自身缓存
+                Key.TypeObject = Property;
+                break;
+            }
+
+            if (const int32* CachedId = ShapeToId.Find(Key))
+            {
+                return *CachedId;
+            }
+
+            const int32 Id = Intern(BuildPropertyTypeName(Property, Kind, Key));
+            ShapeToId.Add(Key, Id);
+            return Id;
+        }
+
+        FString BuildPropertyTypeName(const FProperty* Property, EPropertyKind Kind, const FPropertyShapeKey& Key) const
+        {
+            switch (Kind)
+            {
+            case EPropertyKind::Enum:
+            {
+                const UEnum* Enum = static_cast<const FEnumProperty*>(Property)->GetEnum();
+                return Enum ? Enum->GetName() : FString(TEXT("integer"));
+            }
+            case EPropertyKind::Class:
+            {
+                const UClass* Class = static_cast<const FClassProperty*>(Property)->MetaClass;
+                if (!Class)
+                {
+                    return TEXT("any");
+                }
+                return FString::Printf(TEXT("TSubclassOf<%s%s>"), Class->GetPrefixCPP(), *Class->GetName());
+            }
+            case EPropertyKind::SoftClass:
+            {
+                const FSoftClassProperty* SoftClassProperty = static_cast<const FSoftClassProperty*>(Property);
+                if (const UClass* Class = SoftClassProperty->MetaClass)
+                {
+                    return FString::Printf(TEXT("TSoftClassPtr<%s%s>"), Class->GetPrefixCPP(), *Class->GetName());
+                }
+                const UClass* Class = SoftClassProperty->PropertyClass;
+                return FString::Printf(TEXT("TSoftObjectPtr<%s%s>"), Class->GetPrefixCPP(), *Class->GetName());
+            }
+            case EPropertyKind::SoftObject:
+            {
+                const UClass* Class = static_cast<const FSoftObjectProperty*>(Property)->PropertyClass;
+                return FString::Printf(TEXT("TSoftObjectPtr<%s%s>"), Class->GetPrefixCPP(), *Class->GetName());
+            }
+            case EPropertyKind::Object:
+            {
+                const UClass* Class = static_cast<const FObjectProperty*>(Property)->PropertyClass;
+                if (Cast<UBlueprintGeneratedClass>(Class))
+                {
+                    return Class->GetName();
+                }
+                return FString::Printf(TEXT("%s%s"), Class->GetPrefixCPP(), *Class->GetName());
+            }
+            case EPropertyKind::WeakObject:
+            {
+                const UClass* Class = static_cast<const FWeakObjectProperty*>(Property)->PropertyClass;
+                return FString::Printf(TEXT("TWeakObjectPtr<%s%s>"), Class->GetPrefixCPP(), *Class->GetName());
+            }
+            case EPropertyKind::LazyObject:
+            {
+                const UClass* Class = static_cast<const FLazyObjectProperty*>(Property)->PropertyClass;
+                return FString::Printf(TEXT("TLazyObjectPtr<%s%s>"), Class->GetPrefixCPP(), *Class->GetName());
+            }
+            case EPropertyKind::Interface:
+            {
+                const UClass* Class = static_cast<const FInterfaceProperty*>(Property)->InterfaceClass;
+                return FString::Printf(TEXT("TScriptInterface<%s%s>"), Class->GetPrefixCPP(), *Class->GetName());
+            }
+            case EPropertyKind::Struct:
+                return static_cast<const FStructProperty*>(Property)->Struct->GetStructCPPName();
+            case EPropertyKind::Array:
+                return FString::Printf(TEXT("TArray<%s>"), *Names[Key.InnerA]);
+            case EPropertyKind::Map:
+                return FString::Printf(TEXT("TMap<%s, %s>"), *Names[Key.InnerA], *Names[Key.InnerB]);
+            case EPropertyKind::Set:
+                return FString::Printf(TEXT("TSet<%s>"), *Names[Key.InnerA]);
+            default:
+                break;
+            }
+
+            FString PropertyTypeName = Property->GetCPPType();
+            if (!PropertyTypeName.IsEmpty())
+            {
+                return PropertyTypeName;
+            }
+
+            return "any";
+        }
+    };
+
+    FTypeNameCache& GetTypeNameCache()
+    {
+        static FTypeNameCache Cache;
+        return Cache;
+    }
+
+    /** 生成器和过滤器使用的字段元数据 */
+    struct FFieldMetaData
+    {
+        FString     Comment;                // Comment元数据
+        bool        bDeprecated = false;    // 是否带有Deprecated元数据
+    };
+
+    /**
+     * 按包批量读取的元数据视图
+     * 首次访问某个包时遍历其UMetaData一次，之后对该包内对象的查询直接命中
+     * 以弱指针为键：分帧导出跨帧保留视图，GC后复用同一地址的新对象序列号不同，不会命中旧条目
+     */
+    struct FMetaDataCache
+    {
+        FCriticalSection                        Lock;            // 保护下列容器
+        TSet<FWeakObjectPtr>                    LoadedPackages;  // 已建立视图的包
+        TMap<FWeakObjectPtr, FFieldMetaData>    ObjectMetaData;  // 对象 -> 元数据
+
+        void Reset()
+        {
+            LoadedPackages.Reset();
+            ObjectMetaData.Reset();
+        }
+
+        FString GetComment(const UObject* Object)
+        {
+            FScopeLock ScopeLock(&Lock);
+            const FFieldMetaData* MetaData = Find(Object);
+            return MetaData ? MetaData->Comment : FString();
+        }
+
+        bool IsDeprecated(const UObject* Object)
+        {
+            FScopeLock ScopeLock(&Lock);
+            const FFieldMetaData* MetaData = Find(Object);
+            return MetaData && MetaData->bDeprecated;
+        }
+
+        const FFieldMetaData* Find(const UObject* Object)
+        {
+            UPackage* Package = Object->GetOutermost();
+            if (Package)
+            {
+                bool bAlreadyLoaded = false;
+                LoadedPackages.Add(FWeakObjectPtr(Package), &bAlreadyLoaded);
+                if (!bAlreadyLoaded)
+                {
+                    LoadPackage(Package);
+                }
+            }
+            return ObjectMetaData.Find(FWeakObjectPtr(Object));
+        }
+
+        void LoadPackage(UPackage* Package)
+        {
+            static const FName NAME_Comment(TEXT("Comment"));
+            static const FName NAME_Deprecated(TEXT("Deprecated"));
+
+            const UMetaData* PackageMetaData = Package->GetMetaData();
+            if (!PackageMetaData)
+            {
+                return;
+            }
+            for (const TPair<FWeakObjectPtr, TMap<FName, FString>>& Pair : PackageMetaData->ObjectMetaDataMap)
+            {
+                if (!Pair.Key.IsValid())
+                {
+                    continue;
+                }
+                const FString* Comment = Pair.Value.Find(NAME_Comment);
+                const bool bDeprecated = Pair.Value.Contains(NAME_Deprecated);
+                if (!Comment && !bDeprecated)
+                {
+                    continue;
+                }
+                FFieldMetaData& MetaData = ObjectMetaData.Add(Pair.Key);
+                MetaData.Comment = Comment ? *Comment : FString();
+                MetaData.bDeprecated = bDeprecated;
+            }
+        }
+    };
+
+    FMetaDataCache& GetMetaDataCache()
+    {
+        static FMetaDataCache Cache;
+        return Cache;
+    }
+
+    /** 获取对象的Comment元数据（按包批量读取） */
+    FString GetCommentMetaData(const UObject* Object)
+    {
+        return GetMetaDataCache().GetComment(Object);
+    }
+
+    /** 对象是否带有Deprecated元数据（按包批量读取） */
+    bool IsDeprecatedMetaData(const UObject* Object)
+    {
+        return GetMetaDataCache().IsDeprecated(Object);
+    }
+
+    /** 获取属性的Comment元数据（FProperty的元数据存放在自身，使用预先构造的FName直接查找） */
+    FString GetCommentMetaData(const FProperty* Property)
+    {
+        static const FName NAME_Comment(TEXT("Comment"));
+        const FString* Comment = Property->FindMetaData(NAME_Comment);
+        return Comment ? *Comment : FString();
+    }
+
+    /** 属性是否带有Deprecated元数据 */
+    bool IsDeprecatedMetaData(const FProperty* Property)
+    {
+        static const FName NAME_Deprecated(TEXT("Deprecated"));
+        return Property->FindMetaData(NAME_Deprecated) != nullptr;
+    }
+
+    /** Lua保留关键字（区分大小写） */
+    constexpr const TCHAR* LuaKeywords[] =
+    {
+        TEXT("and"), TEXT("break"), TEXT("do"), TEXT("else"), TEXT("elseif"),
+        TEXT("end"), TEXT("false"), TEXT("for"), TEXT("function"), TEXT("goto"), TEXT("if"),
+        TEXT("in"), TEXT("local"), TEXT("nil"), TEXT("not"), TEXT("or"),
+        TEXT("repeat"), TEXT("return"), TEXT("then"), TEXT("true"), TEXT("until"), TEXT("while")
+    };
+
+    constexpr int32 LuaKeywordSlotCount = 64;
+
+    constexpr int32 GetKeywordLength(const TCHAR* Keyword)
+    {
+        int32 Length = 0;
+        while (Keyword[Length] != TEXT('\0'))
+        {
+            ++Length;
+        }
+        return Length;
+    }
+
+    /** 关键字的完美哈希：(长度 + 3*首字符 + 13*尾字符) % 64，对上面的关键字表无冲突 */
+    constexpr uint32 HashKeyword(const TCHAR* Name, int32 Length)
+    {
+        return ((uint32)Length + 3u * (uint32)Name[0] + 13u * (uint32)Name[Length - 1]) % LuaKeywordSlotCount;
+    }
+
+    /** 哈希槽 -> 关键字索引，编译期构建 */
+    struct FLuaKeywordTable
+    {
+        int8 Slots[LuaKeywordSlotCount];
+        bool bPerfect;
+
+        constexpr FLuaKeywordTable()
+            : Slots{}
+            , bPerfect(true)
+        {
+            for (int8& Slot : Slots)
+            {
+                Slot = INDEX_NONE;
+            }
+            for (int32 Index = 0; Index < (int32)UE_ARRAY_COUNT(LuaKeywords); ++Index)
+            {
+                const uint32 Hash = HashKeyword(LuaKeywords[Index], GetKeywordLength(LuaKeywords[Index]));
+                bPerfect = bPerfect && Slots[Hash] == INDEX_NONE;
+                Slots[Hash] = (int8)Index;
+            }
+        }
+    };
+
+    constexpr FLuaKeywordTable LuaKeywordTable;
+    static_assert(LuaKeywordTable.bPerfect, "Lua keyword hash has collisions");
+
+    /** 是否为Lua关键字，不分配内存 */
+    bool IsLuaKeyword(const TCHAR* Name, int32 Length)
+    {
+        if (Length < 2 || Length > 8)
+        {
+            return false;
+        }
+        const int32 Slot = LuaKeywordTable.Slots[HashKeyword(Name, Length)];
+        return Slot != INDEX_NONE && FCString::Strcmp(Name, LuaKeywords[Slot]) == 0;
+    }
+
+    /** EscapeComments需要逐字符处理的字符：注释标记和空白 */
+    FORCEINLINE bool IsCommentSpecialChar(TCHAR Char)
+    {
+        return Char == TEXT('*') || Char == TEXT('/') || Char == TEXT(' ') ||
+               Char == TEXT('\t') || Char == TEXT('\n') || Char == TEXT('\r');
+    }
+}
+
+void FEmmyLuaCodeGenerator::ResetExportCaches()
+{
+    {
+        FTypeNameCache& Cache = GetTypeNameCache();
+        FScopeLock Lock(&Cache.Lock);
+        Cache.Reset();
+    }
+    {
+        FMetaDataCache& Cache = GetMetaDataCache();
+        FScopeLock Lock(&Cache.Lock);
+        Cache.Reset();
+    }
+}
+
+void FEmmyLuaCodeGenerator::OnPostGarbageCollect()
+{
+    FTypeNameCache& Cache = GetTypeNameCache();
+    FScopeLock Lock(&Cache.Lock);
+    Cache.Reset();
+}
+
+namespace
+{
+    /** 输出内容配置对类型描述的限制 */
+    struct FOutputProfileOptions
+    {
+        bool bComments = true;          // 是否输出注释
+        bool bFields = true;            // 是否输出属性
+        bool bBlueprintOnly = false;    // 只输出蓝图可读的属性和蓝图可调用的函数
+    };
+
+    FOutputProfileOptions GetOutputProfileOptions()
+    {
+        FOutputProfileOptions Options;
+        const UEmmyLuaIntelliSenseSettings* Settings = UEmmyLuaIntelliSenseSettings::Get();
+        switch (Settings ? Settings->OutputProfile : EEmmyLuaOutputProfile::Full)
+        {
+        case EEmmyLuaOutputProfile::NoComments:
+            Options.bComments = false;
+            break;
+        case EEmmyLuaOutputProfile::BlueprintOnly:
+            Options.bBlueprintOnly = true;
+            break;
+        case EEmmyLuaOutputProfile::SignaturesOnly:
+            Options.bComments = false;
+            Options.bFields = false;
+            break;
+        default:
+            break;
+        }
+        return Options;
+    }
+
+    /** 追加函数的注释、参数和返回值注解，各方言通用 */
+    void AppendFunctionAnnotations(const FLuaFunctionDescriptor& Function, FString& Out)
+    {
+        if (!Function.Comment.IsEmpty())
+        {
+            Out += FString::Printf(TEXT("---%s\n"), *Function.Comment);
+        }
+        for (const FLuaParamDescriptor& Param : Function.Params)
+        {
+            Out += FString::Printf(TEXT("---@param %s %s\n"), *Param.Name, *Param.Type);
+        }
+        if (!Function.ReturnType.IsEmpty())
+        {
+            Out += FString::Printf(TEXT("---@return %s\n"), *Function.ReturnType);
+        }
+    }
+
+    /** 追加函数定义行 */
+    void AppendFunctionDefinition(const FString& Owner, const FLuaFunctionDescriptor& Function, FString& Out)
+    {
+        TArray<FString> ParamNames;
+        ParamNames.Reserve(Function.Params.Num());
+        for (const FLuaParamDescriptor& Param : Function.Params)
+        {
+            ParamNames.Add(Param.Name);
+        }
+        const FString ParamList = FString::Join(ParamNames, TEXT(", "));
+        if (!Owner.IsEmpty())
+        {
+            Out += FString::Printf(TEXT("function %s%s%s(%s) end\n\n"), *Owner, Function.bStatic ? TEXT(".") : TEXT(":"), *Function.Name, *ParamList);
+        }
+        else
+        {
+            Out += FString::Printf(TEXT("function %s(%s) end\n\n"), *Function.Name, *ParamList);
+        }
+    }
+
+    /**
+     * 方言输出策略
+     * 每个策略提供以下静态函数，由RenderType在编译期组合：
+     *   EmitHeader / EmitField / EmitTable / EmitEnumBody / EmitFunction / EmitFooter / FieldsFollowTable
+     */
+
+    /** EmmyLua注解（默认输出，保持原有格式） */
+    struct FEmmyLuaEmitter
+    {
+        static constexpr EEmmyLuaDialect Dialect = EEmmyLuaDialect::EmmyLua;
+
+        static void EmitHeader(const FLuaTypeDescriptor& Desc, bool bStandalone, FString& Out)
+        {
+            switch (Desc.Kind)
+            {
+            case ELuaTypeKind::Blueprint:
+                Out += FString::Printf(TEXT("---@class %s : %s\n"), *Desc.Name, *Desc.SuperName);
+                if (!Desc.Comment.IsEmpty())
+                {
+                    Out += FString::Printf(TEXT("---@comment %s\n"), *Desc.Comment);
+                }
+                break;
+            case ELuaTypeKind::Enum:
+                if (!Desc.Comment.IsEmpty())
+                {
+                    Out += FString::Printf(TEXT("---%s\n"), *Desc.Comment);
+                }
+                Out += FString::Printf(TEXT("---@class %s\n"), *Desc.Name);
+                break;
+            default:
+                Out += FString::Printf(TEXT("---@class %s"), *Desc.Name);
+                if (!Desc.SuperName.IsEmpty())
+                {
+                    Out += FString::Printf(TEXT(" : %s"), *Desc.SuperName);
+                }
+                if (!Desc.Comment.IsEmpty())
+                {
+                    Out += FString::Printf(TEXT(" @%s"), *Desc.Comment);
+                }
+                Out += TEXT("\n");
+                break;
+            }
+        }
+
+        static void EmitField(const FLuaFieldDescriptor& Field, FString& Out)
+        {
+            if (!Field.Comment.IsEmpty())
+            {
+                Out += FString::Printf(TEXT("---@field %s %s @%s\n"), *Field.Name, *Field.Type, *Field.Comment);
+            }
+            else
+            {
+                Out += FString::Printf(TEXT("---@field %s %s\n"), *Field.Name, *Field.Type);
+            }
+        }
+
+        static void EmitTable(const FLuaTypeDescriptor& Desc, FString& Out)
+        {
+            Out += FString::Printf(TEXT("local %s = {}\n\n"), *Desc.Name);
+        }
+
+        static void EmitEnumBody(const FLuaTypeDescriptor& Desc, FString& Out)
+        {
+            for (const FLuaEnumValueDescriptor& Value : Desc.EnumValues)
+            {
+                Out += FString::Printf(TEXT("---@field %s integer\n"), *Value.Name);
+            }
+            EmitTable(Desc, Out);
+        }
+
+        static void EmitFunction(const FLuaTypeDescriptor& Desc, const FLuaFunctionDescriptor& Function, FString& Out)
+        {
+            AppendFunctionAnnotations(Function, Out);
+            AppendFunctionDefinition(Desc.FunctionOwner, Function, Out);
+        }
+
+        static void EmitFooter(const FLuaTypeDescriptor& Desc, FString& Out)
+        {
+            Out += FString::Printf(Desc.Kind == ELuaTypeKind::Enum ? TEXT("return %s\n") : TEXT("\nreturn %s\n"), *Desc.Name);
+        }
+
+        static bool FieldsFollowTable(const FLuaTypeDescriptor& Desc)
+        {
+            return Desc.Kind == ELuaTypeKind::Blueprint;
+        }
+    };
+
+    /** sumneko LuaLS注解 */
+    struct FLuaLSEmitter
+    {
+        static constexpr EEmmyLuaDialect Dialect = EEmmyLuaDialect::LuaLS;
+
+        static void EmitHeader(const FLuaTypeDescriptor& Desc, bool bStandalone, FString& Out)
+        {
+            if (bStandalone)
+            {
+                Out += TEXT("---@meta\n\n");
+            }
+            if (!Desc.Comment.IsEmpty())
+            {
+                Out += FString::Printf(TEXT("---%s\n"), *Desc.Comment);
+            }
+            if (Desc.Kind == ELuaTypeKind::Enum)
+            {
+                Out += FString::Printf(TEXT("---@enum %s\n"), *Desc.Name);
+            }
+            else if (!Desc.SuperName.IsEmpty())
+            {
+                Out += FString::Printf(TEXT("---@class %s : %s\n"), *Desc.Name, *Desc.SuperName);
+            }
+            else
+            {
+                Out += FString::Printf(TEXT("---@class %s\n"), *Desc.Name);
+            }
+        }
+
+        static void EmitField(const FLuaFieldDescriptor& Field, FString& Out)
+        {
+            if (!Field.Comment.IsEmpty())
+            {
+                Out += FString::Printf(TEXT("---@field %s %s # %s\n"), *Field.Name, *Field.Type, *Field.Comment);
+            }
+            else
+            {
+                Out += FString::Printf(TEXT("---@field %s %s\n"), *Field.Name, *Field.Type);
+            }
+        }
+
+        static void EmitTable(const FLuaTypeDescriptor& Desc, FString& Out)
+        {
+            Out += FString::Printf(TEXT("local %s = {}\n\n"), *Desc.Name);
+        }
+
+        static void EmitEnumBody(const FLuaTypeDescriptor& Desc, FString& Out)
+        {
+            // ---@enum要求紧跟带有实际取值的表
+            Out += FString::Printf(TEXT("local %s = {\n"), *Desc.Name);
+            for (const FLuaEnumValueDescriptor& Value : Desc.EnumValues)
+            {
+                Out += FString::Printf(TEXT("    %s = %lld,\n"), *Value.Name, Value.Value);
+            }
+            Out += TEXT("}\n\n");
+        }
+
+        static void EmitFunction(const FLuaTypeDescriptor& Desc, const FLuaFunctionDescriptor& Function, FString& Out)
+        {
+            AppendFunctionAnnotations(Function, Out);
+            AppendFunctionDefinition(Desc.Name, Function, Out);
+        }
+
+        static void EmitFooter(const FLuaTypeDescriptor& Desc, FString& Out)
+        {
+            Out += FString::Printf(TEXT("\nreturn %s\n"), *Desc.Name);
+        }
+
+        static bool FieldsFollowTable(const FLuaTypeDescriptor& Desc)
+        {
+            return false;
+        }
+    };
+
+    /** UnLua IntelliSense格式（local M = {} / return M） */
+    struct FUnLuaEmitter
+    {
+        static constexpr EEmmyLuaDialect Dialect = EEmmyLuaDialect::UnLua;
+
+        static void EmitHeader(const FLuaTypeDescriptor& Desc, bool bStandalone, FString& Out)
+        {
+            if (!Desc.Comment.IsEmpty())
+            {
+                Out += FString::Printf(TEXT("---%s\n"), *Desc.Comment);
+            }
+            if (!Desc.SuperName.IsEmpty())
+            {
+                Out += FString::Printf(TEXT("---@class %s : %s\n"), *Desc.Name, *Desc.SuperName);
+            }
+            else
+            {
+                Out += FString::Printf(TEXT("---@class %s\n"), *Desc.Name);
+            }
+        }
+
+        static void EmitField(const FLuaFieldDescriptor& Field, FString& Out)
+        {
+            if (!Field.Comment.IsEmpty())
+            {
+                Out += FString::Printf(TEXT("---@field public %s %s @%s\n"), *Field.Name, *Field.Type, *Field.Comment);
+            }
+            else
+            {
+                Out += FString::Printf(TEXT("---@field public %s %s\n"), *Field.Name, *Field.Type);
+            }
+        }
+
+        static void EmitTable(const FLuaTypeDescriptor& Desc, FString& Out)
+        {
+            Out += TEXT("local M = {}\n\n");
+        }
+
+        static void EmitEnumBody(const FLuaTypeDescriptor& Desc, FString& Out)
+        {
+            for (const FLuaEnumValueDescriptor& Value : Desc.EnumValues)
+            {
+                Out += FString::Printf(TEXT("---@field public %s integer\n"), *Value.Name);
+            }
+            EmitTable(Desc, Out);
+        }
+
+        static void EmitFunction(const FLuaTypeDescriptor& Desc, const FLuaFunctionDescriptor& Function, FString& Out)
+        {
+            AppendFunctionAnnotations(Function, Out);
+            AppendFunctionDefinition(TEXT("M"), Function, Out);
+        }
+
+        static void EmitFooter(const FLuaTypeDescriptor& Desc, FString& Out)
+        {
+            Out += TEXT("\nreturn M\n");
+        }
+
+        static bool FieldsFollowTable(const FLuaTypeDescriptor& Desc)
+        {
+            return false;
+        }
+    };
+
+    /** 用指定的方言策略渲染类型描述 */
+    template <typename TEmitter>
+    void RenderType(const FLuaTypeDescriptor& Desc, bool bStandalone, FString& Out)
+    {
+        EMMYLUA_SCOPE_CYCLE_COUNTER(RenderDialect);
+        TEmitter::EmitHeader(Desc, bStandalone, Out);
+        if (Desc.Kind == ELuaTypeKind::Enum)
+        {
+            TEmitter::EmitEnumBody(Desc, Out);
+        }
+        else
+        {
+            const bool bFieldsFollowTable = TEmitter::FieldsFollowTable(Desc);
+            if (bFieldsFollowTable)
+            {
+                TEmitter::EmitTable(Desc, Out);
+            }
+            for (const FLuaFieldDescriptor& Field : Desc.Fields)
+            {
+                TEmitter::EmitField(Field, Out);
+            }
+            if (!bFieldsFollowTable)
+            {
+                TEmitter::EmitTable(Desc, Out);
+            }
+            for (const FLuaFunctionDescriptor& Function : Desc.Functions)
+            {
+                TEmitter::EmitFunction(Desc, Function, Out);
+            }
+        }
+        if (bStandalone)
+        {
+            TEmitter::EmitFooter(Desc, Out);
+        }
+    }
+
+    /** 方言在DialectMask中启用时渲染到对应的输出槽 */
+    template <typename TEmitter>
+    void RenderTypeIfEnabled(const FLuaTypeDescriptor& Desc, uint32 DialectMask, bool bStandalone, FLuaDialectCode& OutCode)
+    {
+        const uint32 Index = static_cast<uint32>(TEmitter::Dialect);
+        if (DialectMask & (1u << Index))
+        {
+            RenderType<TEmitter>(Desc, bStandalone, OutCode[Index]);
+        }
+    }
+
+    /** 用默认的EmmyLua方言渲染 */
+    FString RenderEmmyLua(const FLuaTypeDescriptor& Desc, bool bStandalone)
+    {
+        FString Result;
+        RenderType<FEmmyLuaEmitter>(Desc, bStandalone, Result);
+        return Result;
+    }
+}
+
+bool FEmmyLuaCodeGenerator::GenerateType(const UObject* Type, uint32 DialectMask, bool bEmitReturn, FLuaDialectCode& OutCode)
+{
+    EMMYLUA_SCOPE_CYCLE_COUNTER(GenerateType);
+    EMMYLUA_LLM_SCOPE(GeneratedCode);
+    for (uint32 DialectIndex = 0; DialectIndex < static_cast<uint32>(EEmmyLuaDialect::Count); ++DialectIndex)
+    {
+        OutCode[DialectIndex].Reset();
+    }
+    FLuaTypeDescriptor Desc;
+    if (!BuildTypeDescriptor(Type, Desc))
+    {
+        return false;
+    }
+    RenderTypeIfEnabled<FEmmyLuaEmitter>(Desc, DialectMask, bEmitReturn, OutCode);
+    RenderTypeIfEnabled<FLuaLSEmitter>(Desc, DialectMask, bEmitReturn, OutCode);
+    RenderTypeIfEnabled<FUnLuaEmitter>(Desc, DialectMask, bEmitReturn, OutCode);
+    return true;
+}
+
+FString FEmmyLuaCodeGenerator::GetFilePrologue(EEmmyLuaDialect Dialect)
+{
+    return Dialect == EEmmyLuaDialect::LuaLS ? TEXT("---@meta\n\n") : TEXT("");
+}
 
 FString FEmmyLuaCodeGenerator::GenerateBlueprint(const UBlueprint* Blueprint)
 {
-    if (!Blueprint || !Blueprint->GeneratedClass)
+    EMMYLUA_SCOPE_CYCLE_COUNTER(GenerateBlueprint);
+    EMMYLUA_LLM_SCOPE(GeneratedCode);
+    FLuaTypeDescriptor Desc;
+    return BuildTypeDescriptor(Blueprint, Desc) ? RenderEmmyLua(Desc, true) : FString();
+}
+
+FString FEmmyLuaCodeGenerator::GenerateClass(const UClass* Class, bool bEmitReturn)
+{
+    EMMYLUA_SCOPE_CYCLE_COUNTER(GenerateClass);
+    FLuaTypeDescriptor Desc;
+    return BuildTypeDescriptor(Class, Desc) ? RenderEmmyLua(Desc, bEmitReturn) : FString();
+}
+
+FString FEmmyLuaCodeGenerator::GenerateStruct(const UScriptStruct* Struct, bool bEmitReturn)
+{
+    EMMYLUA_SCOPE_CYCLE_COUNTER(GenerateStruct);
+    FLuaTypeDescriptor Desc;
+    return BuildTypeDescriptor(Struct, Desc) ? RenderEmmyLua(Desc, bEmitReturn) : FString();
+}
+
+FString FEmmyLuaCodeGenerator::GenerateEnum(const UEnum* Enum, bool bEmitReturn)
+{
+    EMMYLUA_SCOPE_CYCLE_COUNTER(GenerateEnum);
+    FLuaTypeDescriptor Desc;
+    return BuildTypeDescriptor(Enum, Desc) ? RenderEmmyLua(Desc, bEmitReturn) : FString();
+}
+
+FString FEmmyLuaCodeGenerator::GenerateFunction(const UFunction* Function, const FString& ClassName)
+{
+    if (!Function)
     {
         return TEXT("");
     }
-
+    FLuaFunctionDescriptor FunctionDesc;
+    BuildFunctionDescriptor(Function, FunctionDesc, GetOutputProfileOptions().bComments);
     FString Result;
-    Result += FString::Printf(TEXT("---@class %s : %s\n"), 
-        *Blueprint->GetName(), 
-        *GetTypeName(Blueprint->GeneratedClass->GetSuperClass()));
-    
-    if (!Blueprint->BlueprintDescription.IsEmpty())
+    AppendFunctionAnnotations(FunctionDesc, Result);
+    AppendFunctionDefinition(ClassName, FunctionDesc, Result);
+    return Result;
+}
+
+FString FEmmyLuaCodeGenerator::GenerateProperty(const FProperty* Property)
+{
+    if (!Property)
     {
-        Result += FString::Printf(TEXT("---@comment %s\n"), 
-            *EscapeComments(Blueprint->BlueprintDescription));
+        return TEXT("");
     }
-    
-    Result += FString::Printf(TEXT("local %s = {}\n\n"), *Blueprint->GetName());
-    
-    GenerateClassProperties(Blueprint->GeneratedClass, Result);
-    
-    GenerateClassFunctions(Blueprint->GeneratedClass, Result);
-    
-    GenerateBlueprintSpecific(Blueprint, Result);
-    
-    Result += FString::Printf(TEXT("\nreturn %s\n"), *Blueprint->GetName());
-    
+    FLuaFieldDescriptor FieldDesc;
+    BuildFieldDescriptor(Property, FieldDesc, GetOutputProfileOptions().bComments);
+    FString Result;
+    FEmmyLuaEmitter::EmitField(FieldDesc, Result);
     return Result;
 }
 
-FString FEmmyLuaCodeGenerator::GenerateClass(const UClass* Class)
+bool FEmmyLuaCodeGenerator::BuildTypeDescriptor(const UObject* Type, FLuaTypeDescriptor& Desc)
+{
+    EMMYLUA_SCOPE_CYCLE_COUNTER(BuildDescriptor);
+    bool bBuilt = false;
+    if (const UBlueprint* Blueprint = Cast<UBlueprint>(Type))
+    {
+        bBuilt = BuildBlueprintDescriptor(Blueprint, Desc);
+    }
+    else if (const UClass* Class = Cast<UClass>(Type))
+    {
+        bBuilt = BuildClassDescriptor(Class, Desc);
+    }
+    else if (const UScriptStruct* Struct = Cast<UScriptStruct>(Type))
+    {
+        bBuilt = BuildStructDescriptor(Struct, Desc);
+    }
+    else if (const UEnum* Enum = Cast<UEnum>(Type))
+    {
+        bBuilt = BuildEnumDescriptor(Enum, Desc);
+    }
+    if (bBuilt)
+    {
+        INC_DWORD_STAT(STAT_EmmyLua_TypesGenerated);
+    }
+    return bBuilt;
+}
+
+bool FEmmyLuaCodeGenerator::BuildBlueprintDescriptor(const UBlueprint* Blueprint, FLuaTypeDescriptor& Desc)
+{
+    if (!Blueprint || !Blueprint->GeneratedClass)
+    {
+        return false;
+    }
+
+    Desc.Kind = ELuaTypeKind::Blueprint;
+    Desc.Name = Blueprint->GetName();
+    Desc.SuperName = GetTypeName(Blueprint->GeneratedClass->GetSuperClass());
+    if (GetOutputProfileOptions().bComments && !Blueprint->BlueprintDescription.IsEmpty())
+    {
+        Desc.Comment = EscapeComments(Blueprint->BlueprintDescription);
+    }
+    Desc.FunctionOwner = GetTypeName(Blueprint->GeneratedClass);
+
+    CollectClassProperties(Blueprint->GeneratedClass, Desc);
+    CollectClassFunctions(Blueprint->GeneratedClass, Desc);
+    return true;
+}
+
+bool FEmmyLuaCodeGenerator::BuildClassDescriptor(const UClass* Class, FLuaTypeDescriptor& Desc)
 {
     if (!Class)
     {
         UE_LOG(LogEmmyLuaIntelliSense, Warning, TEXT("GenerateClass: Class is null"));
-        return TEXT("");
+        return false;
     }
     
     if (!IsValid(Class))
     {
-        UE_LOG(LogEmmyLuaIntelliSense, Warning, TEXT("GenerateClass: Class is not valid: %s"), Class ? *Class->GetName() : TEXT("null"));
-        return TEXT("");
+        UE_LOG(LogEmmyLuaIntelliSense, Warning, TEXT("GenerateClass: Class is not valid: %s"), *Class->GetName());
+        return false;
     }
 
-    FString Result;
-    FString ClassName = GetTypeName(Class);
-    if (ClassName.IsEmpty() || ClassName == TEXT("Error") || ClassName == TEXT("Invalid"))
+    Desc.Kind = ELuaTypeKind::Class;
+    Desc.Name = GetTypeName(Class);
+    if (Desc.Name.IsEmpty() || Desc.Name == TEXT("Error") || Desc.Name == TEXT("Invalid"))
     {
         UE_LOG(LogEmmyLuaIntelliSense, Warning, TEXT("GenerateClass: Invalid class name for class: %s"), *Class->GetName());
-        return TEXT("");
+        return false;
     }
     
-    FString ClassComment = Class->GetMetaData(TEXT("Comment"));
     const UClass* SuperClass = Class->GetSuperClass();
-    
     if (SuperClass && IsValid(SuperClass))
     {
         FString SuperClassName = GetTypeName(SuperClass);
         if (!SuperClassName.IsEmpty() && SuperClassName != TEXT("Error") && SuperClassName != TEXT("Invalid"))
         {
-            if (!ClassComment.IsEmpty())
-            {
-                Result += FString::Printf(TEXT("---@class %s : %s @%s\n"), 
-                    *ClassName, 
-                    *SuperClassName,
-                    *EscapeComments(ClassComment));
-            }
-            else
-            {
-                Result += FString::Printf(TEXT("---@class %s : %s\n"), 
-                    *ClassName, 
-                    *SuperClassName);
-            }
+            Desc.SuperName = MoveTemp(SuperClassName);
         }
         else
         {
             UE_LOG(LogEmmyLuaIntelliSense, Warning, TEXT("GenerateClass: Invalid super class name for %s"), *Class->GetName());
-            if (!ClassComment.IsEmpty())
-            {
-                Result += FString::Printf(TEXT("---@class %s @%s\n"), *ClassName, *EscapeComments(ClassComment));
-            }
-            else
-            {
-                Result += FString::Printf(TEXT("---@class %s\n"), *ClassName);
-            }
         }
     }
-    else
+
+    if (GetOutputProfileOptions().bComments)
     {
+        FString ClassComment = GetCommentMetaData(Class);
         if (!ClassComment.IsEmpty())
         {
-            Result += FString::Printf(TEXT("---@class %s @%s\n"), *ClassName, *EscapeComments(ClassComment));
-        }
-        else
-        {
-            Result += FString::Printf(TEXT("---@class %s\n"), *ClassName);
+            Desc.Comment = EscapeComments(ClassComment);
         }
     }
+    Desc.FunctionOwner = Desc.Name;
     
-    GenerateClassProperties(Class, Result);
-    
-    Result += FString::Printf(TEXT("local %s = {}\n\n"), *ClassName);
-    
-    GenerateClassFunctions(Class, Result);
-    
-    Result += FString::Printf(TEXT("\nreturn %s\n"), *ClassName);
-    
-    return Result;
+    CollectClassProperties(Class, Desc);
+    CollectClassFunctions(Class, Desc);
+    return true;
 }
 
-FString FEmmyLuaCodeGenerator::GenerateStruct(const UScriptStruct* Struct)
+bool FEmmyLuaCodeGenerator::BuildStructDescriptor(const UScriptStruct* Struct, FLuaTypeDescriptor& Desc)
 {
     if (!Struct)
     {
         UE_LOG(LogEmmyLuaIntelliSense, Warning, TEXT("GenerateStruct: Struct is null"));
-        return TEXT("");
+        return false;
     }
     
     if (!IsValid(Struct))
     {
-        UE_LOG(LogEmmyLuaIntelliSense, Warning, TEXT("GenerateStruct: Struct is not valid: %s"), Struct ? *Struct->GetName() : TEXT("null"));
-        return TEXT("");
+        UE_LOG(LogEmmyLuaIntelliSense, Warning, TEXT("GenerateStruct: Struct is not valid: %s"), *Struct->GetName());
+        return false;
     }
 
-    FString Result;
-    FString StructName = GetTypeName(Struct);
-    if (StructName.IsEmpty() || StructName == TEXT("Error") || StructName == TEXT("Invalid"))
+    Desc.Kind = ELuaTypeKind::Struct;
+    Desc.Name = GetTypeName(Struct);
+    if (Desc.Name.IsEmpty() || Desc.Name == TEXT("Error") || Desc.Name == TEXT("Invalid"))
     {
         UE_LOG(LogEmmyLuaIntelliSense, Warning, TEXT("GenerateStruct: Invalid struct name for struct: %s"), *Struct->GetName());
-        return TEXT("");
+        return false;
     }
     
-    FString StructComment = Struct->GetMetaData(TEXT("Comment"));
-    if (!StructComment.IsEmpty())
+    if (GetOutputProfileOptions().bComments)
     {
-        Result += FString::Printf(TEXT("---@class %s @%s\n"), *StructName, *EscapeComments(StructComment));
+        FString StructComment = GetCommentMetaData(Struct);
+        if (!StructComment.IsEmpty())
+        {
+            Desc.Comment = EscapeComments(StructComment);
+        }
     }
-    else
+    Desc.FunctionOwner = Desc.Name;
+    
+    const FOutputProfileOptions Options = GetOutputProfileOptions();
+    if (!Options.bFields)
     {
-        Result += FString::Printf(TEXT("---@class %s\n"), *StructName);
+        return true;
     }
     
+    // 结构体没有单独导出父结构体的继承关系，属性包含父结构体的成员
     for (TFieldIterator<FProperty> PropertyIt(Struct); PropertyIt; ++PropertyIt)
     {
         FProperty* Property = *PropertyIt;
@@ -159,69 +1193,64 @@ FString FEmmyLuaCodeGenerator::GenerateStruct(const UScriptStruct* Struct)
         {
             continue;
         }
+        if (Options.bBlueprintOnly && !Property->HasAnyPropertyFlags(CPF_BlueprintVisible))
+        {
+            continue;
+        }
         
-        GenerateProperty(Property, Result);
+        BuildFieldDescriptor(Property, Desc.Fields.AddDefaulted_GetRef(), Options.bComments);
     }
-    
-    Result += FString::Printf(TEXT("local %s = {}\n\n"), *StructName);
-    
-    Result += FString::Printf(TEXT("\nreturn %s\n"), *StructName);
-    
-    return Result;
+    return true;
 }
 
-FString FEmmyLuaCodeGenerator::GenerateEnum(const UEnum* Enum)
+bool FEmmyLuaCodeGenerator::BuildEnumDescriptor(const UEnum* Enum, FLuaTypeDescriptor& Desc)
 {
     if (!Enum)
     {
         UE_LOG(LogEmmyLuaIntelliSense, Warning, TEXT("GenerateEnum: Enum is null"));
-        return TEXT("");
+        return false;
     }
     
     if (!IsValid(Enum))
     {
-        UE_LOG(LogEmmyLuaIntelliSense, Warning, TEXT("GenerateEnum: Enum is not valid: %s"), Enum ? *Enum->GetName() : TEXT("null"));
-        return TEXT("");
+        UE_LOG(LogEmmyLuaIntelliSense, Warning, TEXT("GenerateEnum: Enum is not valid: %s"), *Enum->GetName());
+        return false;
     }
 
-    FString Result;
-    FString EnumName = GetTypeName(Enum);
-    if (EnumName.IsEmpty() || EnumName == TEXT("Error") || EnumName == TEXT("Invalid"))
+    Desc.Kind = ELuaTypeKind::Enum;
+    Desc.Name = GetTypeName(Enum);
+    if (Desc.Name.IsEmpty() || Desc.Name == TEXT("Error") || Desc.Name == TEXT("Invalid"))
     {
         UE_LOG(LogEmmyLuaIntelliSense, Warning, TEXT("GenerateEnum: Invalid enum name for enum: %s"), *Enum->GetName());
-        return TEXT("");
+        return false;
     }
     
-    FString EnumComment = Enum->GetMetaData(TEXT("Comment"));
-    if (!EnumComment.IsEmpty())
+    if (GetOutputProfileOptions().bComments)
     {
-        Result += FString::Printf(TEXT("---%s\n"), *EscapeComments(EnumComment));
+        FString EnumComment = GetCommentMetaData(Enum);
+        if (!EnumComment.IsEmpty())
+        {
+            Desc.Comment = EscapeComments(EnumComment);
+        }
     }
+    Desc.FunctionOwner = Desc.Name;
     
-    Result += FString::Printf(TEXT("---@class %s\n"), *EnumName);
-    
+    // 最后一项是自动生成的_MAX，不导出
+    Desc.EnumValues.Reserve(FMath::Max(Enum->NumEnums() - 1, 0));
     for (int32 i = 0; i < Enum->NumEnums() - 1; ++i)
     {
-        FString EnumValueName = Enum->GetNameStringByIndex(i);
-        int64 EnumValue = Enum->GetValueByIndex(i);
-        
-        Result += FString::Printf(TEXT("---@field %s integer\n"), 
-            *EscapeSymbolName(EnumValueName));
+        FLuaEnumValueDescriptor& Value = Desc.EnumValues.AddDefaulted_GetRef();
+        Value.Name = EscapeSymbolName(Enum->GetNameStringByIndex(i));
+        Value.Value = Enum->GetValueByIndex(i);
     }
-    
-    Result += FString::Printf(TEXT("local %s = {}\n\n"), *EnumName);
-    
-    Result += FString::Printf(TEXT("return %s\n"), *EnumName);
-    
-    return Result;
+    return true;
 }
 
 FString FEmmyLuaCodeGenerator::GenerateUETypes(const TArray<const UField*>& Types)
 {
     FString Result;
     
-    Result += TEXT("-- Generated UE4 Types for Lua\n");
-    Result += FString::Printf(TEXT("-- Generated at: %s\n\n"), *FDateTime::Now().ToString());
+    Result += TEXT("-- Generated UE4 Types for Lua\n\n");
     
     for (const UField* Type : Types)
     {
@@ -244,6 +1273,8 @@ FString FEmmyLuaCodeGenerator::GenerateUETypes(const TArray<const UField*>& Type
 
 FString FEmmyLuaCodeGenerator::GenerateUETable(const TArray<const UField*>& Types)
 {
+    EMMYLUA_SCOPE_CYCLE_COUNTER(GenerateUETable);
+    EMMYLUA_LLM_SCOPE(GeneratedCode);
     FString Content = TEXT("---@class UE\r\n");
     
     for (const UField* Type : Types)
@@ -259,8 +1290,14 @@ FString FEmmyLuaCodeGenerator::GenerateUETable(const TArray<const UField*>& Type
     return Content;
 }
 
-void FEmmyLuaCodeGenerator::GenerateClassProperties(const UClass* Class, FString& Code)
+void FEmmyLuaCodeGenerator::CollectClassProperties(const UClass* Class, FLuaTypeDescriptor& Desc)
 {
+    const FOutputProfileOptions Options = GetOutputProfileOptions();
+    if (!Options.bFields)
+    {
+        return;
+    }
+    
     for (TFieldIterator<FProperty> PropertyIt(Class, EFieldIteratorFlags::ExcludeSuper); PropertyIt; ++PropertyIt)
     {
         FProperty* Property = *PropertyIt;
@@ -268,15 +1305,18 @@ void FEmmyLuaCodeGenerator::GenerateClassProperties(const UClass* Class, FString
         {
             continue;
         }
+        if (Options.bBlueprintOnly && !Property->HasAnyPropertyFlags(CPF_BlueprintVisible))
+        {
+            continue;
+        }
         
-        GenerateProperty(Property, Code);
+        BuildFieldDescriptor(Property, Desc.Fields.AddDefaulted_GetRef(), Options.bComments);
     }
 }
 
-void FEmmyLuaCodeGenerator::GenerateClassFunctions(const UClass* Class, FString& Code)
+void FEmmyLuaCodeGenerator::CollectClassFunctions(const UClass* Class, FLuaTypeDescriptor& Desc)
 {
-    FString ClassName = GetTypeName(Class);
-    
+    const FOutputProfileOptions Options = GetOutputProfileOptions();
     for (TFieldIterator<UFunction> FunctionIt(Class, EFieldIteratorFlags::ExcludeSuper); FunctionIt; ++FunctionIt)
     {
         UFunction* Function = *FunctionIt;
@@ -284,89 +1324,63 @@ void FEmmyLuaCodeGenerator::GenerateClassFunctions(const UClass* Class, FString&
         {
             continue;
         }
+        if (Options.bBlueprintOnly && !Function->HasAnyFunctionFlags(FUNC_BlueprintCallable))
+        {
+            continue;
+        }
         
-        GenerateFunction(Function, Code, ClassName);
+        BuildFunctionDescriptor(Function, Desc.Functions.AddDefaulted_GetRef(), Options.bComments);
     }
 }
 
-void FEmmyLuaCodeGenerator::GenerateBlueprintSpecific(const UBlueprint* Blueprint, FString& Code)
-{
-
-}
-
-void FEmmyLuaCodeGenerator::GenerateProperty(const FProperty* Property, FString& Code)
+void FEmmyLuaCodeGenerator::BuildFieldDescriptor(const FProperty* Property, FLuaFieldDescriptor& Field, bool bIncludeComment)
 {
-    if (!Property)
-    {
-        return;
-    }
+    Field.Type = GetPropertyType(Property);
+    Field.Name = EscapeSymbolName(Property->GetName());
     
-    FString PropertyType = GetPropertyType(Property);
-    FString PropertyName = EscapeSymbolName(Property->GetName());
-    
-    FString PropertyComment = Property->GetMetaData(TEXT("Comment"));
-    if (!PropertyComment.IsEmpty())
-    {
-        Code += FString::Printf(TEXT("---@field %s %s @%s\n"), *PropertyName, *PropertyType, *EscapeComments(PropertyComment));
-    }
-    else
+    if (bIncludeComment)
     {
-        Code += FString::Printf(TEXT("---@field %s %s\n"), *PropertyName, *PropertyType);
+        FString PropertyComment = GetCommentMetaData(Property);
+        if (!PropertyComment.IsEmpty())
+        {
+            Field.Comment = EscapeComments(PropertyComment);
+        }
     }
 }
 
-void FEmmyLuaCodeGenerator::GenerateFunction(const UFunction* Function, FString& Code, const FString& ClassName)
+void FEmmyLuaCodeGenerator::BuildFunctionDescriptor(const UFunction* Function, FLuaFunctionDescriptor& FunctionDesc, bool bIncludeComment)
 {
-    if (!Function)
-    {
-        return;
-    }
-    
-    FString FunctionName = EscapeSymbolName(Function->GetName());
+    FunctionDesc.Name = EscapeSymbolName(Function->GetName());
+    FunctionDesc.bStatic = Function->HasAnyFunctionFlags(FUNC_Static);
     
-    FString FunctionComment = Function->GetMetaData(TEXT("Comment"));
-    if (!FunctionComment.IsEmpty())
+    if (bIncludeComment)
     {
-        Code += FString::Printf(TEXT("---%s\n"), *EscapeComments(FunctionComment));
+        FString FunctionComment = GetCommentMetaData(Function);
+        if (!FunctionComment.IsEmpty())
+        {
+            FunctionDesc.Comment = EscapeComments(FunctionComment);
+        }
     }
     
-    TArray<FString> Parameters;
-    FString ReturnType = TEXT("void");
-    
     for (TFieldIterator<FProperty> ParamIt(Function); ParamIt; ++ParamIt)
     {
         FProperty* Param = *ParamIt;
         
         if (Param->HasAnyPropertyFlags(CPF_ReturnParm))
         {
-            ReturnType = GetPropertyType(Param);
+            FunctionDesc.ReturnType = GetPropertyType(Param);
         }
         else if (!Param->HasAnyPropertyFlags(CPF_OutParm))
         {
-            FString ParamType = GetPropertyType(Param);
-            FString ParamName = EscapeSymbolName(Param->GetName());
-            
-            Code += FString::Printf(TEXT("---@param %s %s\n"), *ParamName, *ParamType);
-            Parameters.Add(ParamName);
+            FLuaParamDescriptor& ParamDesc = FunctionDesc.Params.AddDefaulted_GetRef();
+            ParamDesc.Name = EscapeSymbolName(Param->GetName());
+            ParamDesc.Type = GetPropertyType(Param);
         }
     }
     
-    if (ReturnType != TEXT("void"))
-    {
-        Code += FString::Printf(TEXT("---@return %s\n"), *ReturnType);
-    }
-    
-    FString ParamList = FString::Join(Parameters, TEXT(", "));
-    bool bIsStatic = Function->HasAnyFunctionFlags(FUNC_Static);
-    FString Connector = bIsStatic ? TEXT(".") : TEXT(":");
-    
-    if (!ClassName.IsEmpty())
-    {
-        Code += FString::Printf(TEXT("function %s%s%s(%s) end\n\n"), *ClassName, *Connector, *FunctionName, *ParamList);
-    }
-    else
+    if (FunctionDesc.ReturnType == TEXT("void"))
     {
-        Code += FString::Printf(TEXT("function %s(%s) end\n\n"), *FunctionName, *ParamList);
+        FunctionDesc.ReturnType.Reset();
     }
 }
 
@@ -382,24 +1396,7 @@ FString FEmmyLuaCodeGenerator::GetPropertyType(const FProperty* Property)
 
 FString FEmmyLuaCodeGenerator::GetTypeName(const UField* Field)
 {
-    if (!Field)
-    {
-        return TEXT("");
-    }
-    
-    FString FieldName = Field->GetName();
-    if (!Field->IsNative() && FieldName.EndsWith(TEXT("_C")))
-    {
-        return FieldName;
-    }
-    
-    const UStruct* Struct = Cast<UStruct>(Field);
-    if (Struct)
-    {
-        return Struct->GetPrefixCPP() + Struct->GetName();
-    }
-    
-    return FieldName;
+    return GetTypeName(static_cast<const UObject*>(Field));
 }
 
 FString FEmmyLuaCodeGenerator::GetTypeName(const UObject* Object)
@@ -408,20 +1405,10 @@ FString FEmmyLuaCodeGenerator::GetTypeName(const UObject* Object)
     {
         return TEXT("");
     }
-    
-    FString ObjectName = Object->GetName();
-    if (!Object->IsNative() && ObjectName.EndsWith(TEXT("_C")))
-    {
-        return ObjectName;
-    }
-    
-    const UStruct* Struct = Cast<UStruct>(Object);
-    if (Struct)
-    {
-        return Struct->GetPrefixCPP() + Struct->GetName();
-    }
-    
-    return ObjectName;
+
+    FTypeNameCache& Cache = GetTypeNameCache();
+    FScopeLock Lock(&Cache.Lock);
+    return Cache.Names[Cache.ResolveObject(Object)];
 }
 
 FString FEmmyLuaCodeGenerator::GetTypeName(const FProperty* Property)
@@ -429,178 +1416,111 @@ FString FEmmyLuaCodeGenerator::GetTypeName(const FProperty* Property)
     if (!Property)
         return "any";
 
-    if (CastField<FByteProperty>(Property))
-        return "integer";
-
-    if (CastField<FInt8Property>(Property))
-        return "integer";
-
-    if (CastField<FInt16Property>(Property))
-        return "integer";
-
-    if (CastField<FIntProperty>(Property))
-        return "integer";
-
-    if (CastField<FInt64Property>(Property))
-        return "integer";
-
-    if (CastField<FUInt16Property>(Property))
-        return "integer";
-
-    if (CastField<FUInt32Property>(Property))
-        return "integer";
-
-    if (CastField<FUInt64Property>(Property))
-        return "integer";
-
-    if (CastField<FFloatProperty>(Property))
-        return "number";
-
-    if (CastField<FDoubleProperty>(Property))
-        return "number";
-
-    if (CastField<FEnumProperty>(Property))
-        return ((FEnumProperty*)Property)->GetEnum()->GetName();
+    FTypeNameCache& Cache = GetTypeNameCache();
+    FScopeLock Lock(&Cache.Lock);
+    return Cache.Names[Cache.ResolveProperty(Property)];
+}
 
-    if (CastField<FBoolProperty>(Property))
-        return TEXT("boolean");
+FString FEmmyLuaCodeGenerator::EscapeComments(const FString& Comment)
+{
+    const TCHAR* Source = *Comment;
+    const int32 Length = Comment.Len();
 
-    if (CastField<FClassProperty>(Property))
-    {
-        const UClass* Class = ((FClassProperty*)Property)->MetaClass;
-        return FString::Printf(TEXT("TSubclassOf<%s%s>"), Class->GetPrefixCPP(), *Class->GetName());
-    }
+    FString Result;
+    Result.Reserve(Length);
 
-    if (CastField<FSoftObjectProperty>(Property))
+    bool bPendingSpace = false;
+    int32 Index = 0;
+    while (Index < Length)
     {
-        if (((FSoftObjectProperty*)Property)->PropertyClass->IsChildOf(UClass::StaticClass()))
+        // 快速路径：不含注释标记和空白的连续片段整段拷贝
+        int32 SpanEnd = Index;
+        while (SpanEnd < Length && !IsCommentSpecialChar(Source[SpanEnd]))
+        {
+            ++SpanEnd;
+        }
+        if (SpanEnd > Index)
         {
-            const UClass* Class = ((FSoftClassProperty*)Property)->MetaClass;
-            if (Class)
+            if (bPendingSpace && Result.Len() > 0)
             {
-                return FString::Printf(TEXT("TSoftClassPtr<%s%s>"), Class->GetPrefixCPP(), *Class->GetName());
+                Result.AppendChar(TEXT(' '));
             }
+            bPendingSpace = false;
+            Result.AppendChars(Source + Index, SpanEnd - Index);
+            Index = SpanEnd;
+            continue;
         }
-        const UClass* Class = ((FSoftObjectProperty*)Property)->PropertyClass;
-        return FString::Printf(TEXT("TSoftObjectPtr<%s%s>"), Class->GetPrefixCPP(), *Class->GetName());
-    }
 
-    if (CastField<FObjectProperty>(Property))
-    {
-        const UClass* Class = ((FObjectProperty*)Property)->PropertyClass;
-        if (Cast<UBlueprintGeneratedClass>(Class))
+        const TCHAR Char = Source[Index];
+        const TCHAR Next = Index + 1 < Length ? Source[Index + 1] : TEXT('\0');
+        switch (Char)
         {
-            return FString::Printf(TEXT("%s"), *Class->GetName());
+        case TEXT('*'):
+            // "*"和"*/"都直接丢弃
+            Index += Next == TEXT('/') ? 2 : 1;
+            break;
+        case TEXT('/'):
+            if (Next == TEXT('/'))
+            {
+                Index += 2;
+            }
+            else if (Next == TEXT('*'))
+            {
+                // "/*"、"/**"：丢弃斜杠，星号由下一轮丢弃
+                Index += 1;
+            }
+            else
+            {
+                if (bPendingSpace && Result.Len() > 0)
+                {
+                    Result.AppendChar(TEXT(' '));
+                }
+                bPendingSpace = false;
+                Result.AppendChar(Char);
+                Index += 1;
+            }
+            break;
+        case TEXT('\r'):
+            Index += 1;
+            break;
+        default:
+            // 空格、制表符和换行折叠为单个空格，首尾空白不输出
+            bPendingSpace = true;
+            Index += 1;
+            break;
         }
-        return FString::Printf(TEXT("%s%s"), Class->GetPrefixCPP(), *Class->GetName());
-    }
-
-    if (CastField<FWeakObjectProperty>(Property))
-    {
-        const UClass* Class = ((FWeakObjectProperty*)Property)->PropertyClass;
-        return FString::Printf(TEXT("TWeakObjectPtr<%s%s>"), Class->GetPrefixCPP(), *Class->GetName());
-    }
-
-    if (CastField<FLazyObjectProperty>(Property))
-    {
-        const UClass* Class = ((FLazyObjectProperty*)Property)->PropertyClass;
-        return FString::Printf(TEXT("TLazyObjectPtr<%s%s>"), Class->GetPrefixCPP(), *Class->GetName());
-    }
-
-    if (CastField<FInterfaceProperty>(Property))
-    {
-        const UClass* Class = ((FInterfaceProperty*)Property)->InterfaceClass;
-        return FString::Printf(TEXT("TScriptInterface<%s%s>"), Class->GetPrefixCPP(), *Class->GetName());
-    }
-
-    if (CastField<FNameProperty>(Property))
-        return "string";
-
-    if (CastField<FStrProperty>(Property))
-        return "string";
-
-    if (CastField<FTextProperty>(Property))
-        return "string";
-
-    if (CastField<FArrayProperty>(Property))
-    {
-        const FProperty* Inner = ((FArrayProperty*)Property)->Inner;
-        return FString::Printf(TEXT("TArray<%s>"), *GetTypeName(Inner));
-    }
-
-    if (CastField<FMapProperty>(Property))
-    {
-        const FProperty* KeyProp = ((FMapProperty*)Property)->KeyProp;
-        const FProperty* ValueProp = ((FMapProperty*)Property)->ValueProp;
-        return FString::Printf(TEXT("TMap<%s, %s>"), *GetTypeName(KeyProp), *GetTypeName(ValueProp));
     }
 
-    if (CastField<FSetProperty>(Property))
-    {
-        const FProperty* ElementProp = ((FSetProperty*)Property)->ElementProp;
-        return FString::Printf(TEXT("TSet<%s>"), *GetTypeName(ElementProp));
-    }
-
-    if (CastField<FStructProperty>(Property))
-        return ((FStructProperty*)Property)->Struct->GetStructCPPName();
-
-    FString PropertyTypeName = Property->GetCPPType();
-    if (!PropertyTypeName.IsEmpty())
-    {
-        return PropertyTypeName;
-    }
-
-    return "any";
+    Result.TrimStartAndEndInline();
+    return Result;
 }
 
-FString FEmmyLuaCodeGenerator::EscapeComments(const FString& Comment)
+FString FEmmyLuaCodeGenerator::EscapeSymbolName(const FString& Name)
 {
-    FString Result = Comment;
-    
-    Result = Result.Replace(TEXT("/**"), TEXT(""));
-    Result = Result.Replace(TEXT("*/"), TEXT(""));
-    Result = Result.Replace(TEXT("/*"), TEXT(""));
-    Result = Result.Replace(TEXT("//"), TEXT(""));
-    Result = Result.Replace(TEXT("*"), TEXT(""));
-    
-    Result = Result.Replace(TEXT("\n"), TEXT(" "));
-    Result = Result.Replace(TEXT("\r"), TEXT(""));
-    Result = Result.Replace(TEXT("\t"), TEXT(" "));
-    
-    while (Result.Contains(TEXT("  ")))
-    {
-        Result = Result.Replace(TEXT("  "), TEXT(" "));
-    }
-    
-    return Result.TrimStartAndEnd();
+    return EscapeSymbolName(FString(Name));
 }
 
-FString FEmmyLuaCodeGenerator::EscapeSymbolName(const FString& Name)
+FString FEmmyLuaCodeGenerator::EscapeSymbolName(FString&& Name)
 {
-    FString Result = Name;
-    
-    static const TSet<FString> LuaKeywords = {
-        TEXT("and"), TEXT("break"), TEXT("do"), TEXT("else"), TEXT("elseif"),
-        TEXT("end"), TEXT("false"), TEXT("for"), TEXT("function"), TEXT("if"),
-        TEXT("in"), TEXT("local"), TEXT("nil"), TEXT("not"), TEXT("or"),
-        TEXT("repeat"), TEXT("return"), TEXT("then"), TEXT("true"), TEXT("until"), TEXT("while")
-    };
-    
-    if (LuaKeywords.Contains(Result.ToLower()))
+    const int32 Length = Name.Len();
+    const bool bIsKeyword = IsLuaKeyword(*Name, Length);
+
+    TCHAR* Chars = Name.GetCharArray().GetData();
+    for (int32 Index = 0; Index < Length; ++Index)
     {
-        Result = TEXT("_") + Result;
+        const TCHAR Char = Chars[Index];
+        if (Char == TEXT(' ') || Char == TEXT('-') || Char == TEXT('.'))
+        {
+            Chars[Index] = TEXT('_');
+        }
     }
-    
-    Result = Result.Replace(TEXT(" "), TEXT("_"));
-    Result = Result.Replace(TEXT("-"), TEXT("_"));
-    Result = Result.Replace(TEXT("."), TEXT("_"));
-    
-    if (Result.Len() > 0 && !FChar::IsAlpha(Result[0]) && Result[0] != TEXT('_'))
+
+    if (bIsKeyword || (Length > 0 && !FChar::IsAlpha(Chars[0]) && Chars[0] != TEXT('_')))
     {
-        Result = TEXT("_") + Result;
+        Name.InsertAt(0, TEXT('_'));
     }
-    
-    return Result;
+
+    return MoveTemp(Name);
 }
 
 bool FEmmyLuaCodeGenerator::ShouldSkipType(const UField* Field)
@@ -628,7 +1548,7 @@ bool FEmmyLuaCodeGenerator::ShouldSkipType(const UField* Field)
     
     try
     {
-        if (Field->HasMetaData(TEXT("Deprecated")))
+        if (IsDeprecatedMetaData(Field))
         {
             return true;
         }
@@ -664,7 +1584,7 @@ bool FEmmyLuaCodeGenerator::ShouldSkipProperty(const FProperty* Property)
         return true;
     }
     
-    if (Property->HasMetaData(TEXT("Deprecated")))
+    if (IsDeprecatedMetaData(Property))
     {
         return true;
     }
@@ -690,7 +1610,7 @@ bool FEmmyLuaCodeGenerator::ShouldSkipFunction(const UFunction* Function)
         return true;
     }
     
-    if (Function->HasMetaData(TEXT("Deprecated")))
+    if (IsDeprecatedMetaData(Function))
     {
         return true;
     }
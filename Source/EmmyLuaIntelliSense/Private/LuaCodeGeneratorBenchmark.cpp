@@ -0,0 +1,508 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "LuaCodeGenerator.h"
+#include "EmmyLuaIntelliSense.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/MemoryBase.h"
+#include "HAL/PlatformTLS.h"
+#include "UObject/UObjectIterator.h"
+#include "UObject/UnrealType.h"
+#include "Interfaces/IPluginManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Dom/JsonObject.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/JsonWriter.h"
+#include "Serialization/JsonReader.h"
+#include "Misc/AutomationTest.h"
+
+namespace
+{
+    /** 收集所有已加载UStruct（含UFunction参数）上的属性 */
+    void CollectAllProperties(TArray<const FProperty*>& OutProperties)
+    {
+        for (TObjectIterator<UStruct> It; It; ++It)
+        {
+            for (TFieldIterator<FProperty> PropertyIt(*It, EFieldIteratorFlags::ExcludeSuper); PropertyIt; ++PropertyIt)
+            {
+                OutProperties.Add(*PropertyIt);
+            }
+        }
+    }
+
+    /** GetTypeName微基准的结果 */
+    struct FTypeNameBenchResult
+    {
+        int32           Properties = 0;
+        int32           Iterations = 0;
+        double          ColdSeconds = 0.0;
+        double          WarmSeconds = 0.0;
+        int32           Mismatches = 0;     // 热启动结果与冷启动不一致的属性数
+        int32           EmptyNames = 0;     // 解析出空类型名的属性数
+    };
+
+    /**
+     * 对所有已加载属性运行GetTypeName
+     * 冷启动：每轮开始前清空类型名称缓存；热启动：缓存保留，结果应与冷启动逐项一致
+     */
+    FTypeNameBenchResult BenchmarkTypeNames(int32 Iterations)
+    {
+        FTypeNameBenchResult Result;
+        Result.Iterations = Iterations;
+
+        TArray<const FProperty*> Properties;
+        CollectAllProperties(Properties);
+        Result.Properties = Properties.Num();
+
+        TArray<FString> ColdNames;
+        ColdNames.Reserve(Properties.Num());
+        for (int32 Iteration = 0; Iteration < Iterations; ++Iteration)
+        {
+            FEmmyLuaCodeGenerator::ResetExportCaches();
+            const double StartTime = FPlatformTime::Seconds();
+            for (const FProperty* Property : Properties)
+            {
+                FString TypeName = FEmmyLuaCodeGenerator::GetTypeName(Property);
+                if (Iteration == 0)
+                {
+                    ColdNames.Add(MoveTemp(TypeName));
+                }
+            }
+            Result.ColdSeconds += FPlatformTime::Seconds() - StartTime;
+        }
+
+        for (int32 Iteration = 0; Iteration < Iterations; ++Iteration)
+        {
+            const double StartTime = FPlatformTime::Seconds();
+            for (int32 Index = 0; Index < Properties.Num(); ++Index)
+            {
+                const FString TypeName = FEmmyLuaCodeGenerator::GetTypeName(Properties[Index]);
+                if (Iteration == 0)
+                {
+                    Result.Mismatches += TypeName.Equals(ColdNames[Index], ESearchCase::CaseSensitive) ? 0 : 1;
+                    Result.EmptyNames += TypeName.IsEmpty() ? 1 : 0;
+                }
+            }
+            Result.WarmSeconds += FPlatformTime::Seconds() - StartTime;
+        }
+        FEmmyLuaCodeGenerator::ResetExportCaches();
+        return Result;
+    }
+
+    void LogTypeNameBenchmark(const FTypeNameBenchResult& Result)
+    {
+        const double Lookups = FMath::Max(1.0, (double)Result.Properties * Result.Iterations);
+        UE_LOG(LogEmmyLuaIntelliSense, Log, TEXT("[BENCH] GetTypeName over %d properties x %d iterations"), Result.Properties, Result.Iterations);
+        UE_LOG(LogEmmyLuaIntelliSense, Log, TEXT("[BENCH]   cold: %.3f ms total, %.1f ns/property"), Result.ColdSeconds * 1000.0, Result.ColdSeconds * 1e9 / Lookups);
+        UE_LOG(LogEmmyLuaIntelliSense, Log, TEXT("[BENCH]   warm: %.3f ms total, %.1f ns/property"), Result.WarmSeconds * 1000.0, Result.WarmSeconds * 1e9 / Lookups);
+    }
+
+    /**
+     * GetTypeName微基准
+     * 用法: EmmyLua.BenchTypeNames [Iterations]
+     */
+    void RunTypeNameBenchmark(const TArray<FString>& Args)
+    {
+        const int32 Iterations = Args.Num() > 0 ? FMath::Max(1, FCString::Atoi(*Args[0])) : 10;
+        LogTypeNameBenchmark(BenchmarkTypeNames(Iterations));
+    }
+
+    FAutoConsoleCommand BenchTypeNamesCommand(
+        TEXT("EmmyLua.BenchTypeNames"),
+        TEXT("Benchmark FEmmyLuaCodeGenerator::GetTypeName over every loaded property. Usage: EmmyLua.BenchTypeNames [Iterations]"),
+        FConsoleCommandWithArgsDelegate::CreateStatic(&RunTypeNameBenchmark));
+
+    /**
+     * 统计当前线程分配次数的FMalloc代理
+     * 作用域内临时替换GMalloc，所有调用转发给原分配器，只计数创建作用域的线程上的Malloc/Realloc，
+     * 其它线程的分配不计入，结果不受进程内其它活动影响
+     */
+    class FLuaCountingMalloc final : public FMalloc
+    {
+    public:
+        explicit FLuaCountingMalloc(FMalloc* InInner)
+            : Inner(InInner)
+            , OwnerThreadId(FPlatformTLS::GetCurrentThreadId())
+        {
+        }
+
+        virtual void* Malloc(SIZE_T Count, uint32 Alignment) override
+        {
+            RecordAllocation();
+            return Inner->Malloc(Count, Alignment);
+        }
+        virtual void* TryMalloc(SIZE_T Count, uint32 Alignment) override
+        {
+            RecordAllocation();
+            return Inner->TryMalloc(Count, Alignment);
+        }
+        virtual void* Realloc(void* Original, SIZE_T Count, uint32 Alignment) override
+        {
+            RecordAllocation();
+            return Inner->Realloc(Original, Count, Alignment);
+        }
+        virtual void* TryRealloc(void* Original, SIZE_T Count, uint32 Alignment) override
+        {
+            RecordAllocation();
+            return Inner->TryRealloc(Original, Count, Alignment);
+        }
+        virtual void Free(void* Original) override { Inner->Free(Original); }
+        virtual SIZE_T QuantizeSize(SIZE_T Count, uint32 Alignment) override { return Inner->QuantizeSize(Count, Alignment); }
+        virtual bool GetAllocationSize(void* Original, SIZE_T& SizeOut) override { return Inner->GetAllocationSize(Original, SizeOut); }
+        virtual void Trim(bool bTrimThreadCaches) override { Inner->Trim(bTrimThreadCaches); }
+        virtual void SetupTLSCachesOnCurrentThread() override { Inner->SetupTLSCachesOnCurrentThread(); }
+        virtual void ClearAndDisableTLSCachesOnCurrentThread() override { Inner->ClearAndDisableTLSCachesOnCurrentThread(); }
+        virtual void InitializeStatsMetadata() override { Inner->InitializeStatsMetadata(); }
+        virtual void UpdateStats() override { Inner->UpdateStats(); }
+        virtual void GetAllocatorStats(FGenericMemoryStats& OutStats) override { Inner->GetAllocatorStats(OutStats); }
+        virtual void DumpAllocatorStats(FOutputDevice& Ar) override { Inner->DumpAllocatorStats(Ar); }
+        virtual bool IsInternallyThreadSafe() const override { return Inner->IsInternallyThreadSafe(); }
+        virtual bool ValidateHeap() override { return Inner->ValidateHeap(); }
+        virtual const TCHAR* GetDescriptiveName() override { return TEXT("EmmyLuaCountingMalloc"); }
+
+        int64 GetAllocations() const { return Allocations; }
+
+    private:
+        void RecordAllocation()
+        {
+            if (FPlatformTLS::GetCurrentThreadId() == OwnerThreadId)
+            {
+                ++Allocations;
+            }
+        }
+
+        FMalloc*        Inner;
+        uint32          OwnerThreadId;
+        int64           Allocations = 0;    // 只在OwnerThreadId上读写，无需原子操作
+    };
+
+    /** 在作用域内用FLuaCountingMalloc替换GMalloc，析构时恢复 */
+    class FScopedAllocationCounter
+    {
+    public:
+        FScopedAllocationCounter()
+            : PreviousMalloc(GMalloc)
+            , CountingMalloc(GMalloc)
+        {
+            GMalloc = &CountingMalloc;
+        }
+        ~FScopedAllocationCounter()
+        {
+            GMalloc = PreviousMalloc;
+        }
+
+        int64 GetAllocations() const { return CountingMalloc.GetAllocations(); }
+
+    private:
+        FMalloc*            PreviousMalloc;
+        FLuaCountingMalloc  CountingMalloc;
+    };
+
+    /** 单个生成器入口的测量结果 */
+    struct FPerfResult
+    {
+        FString     Name;
+        int64       Items = 0;          // 处理的条目数（所有迭代累计）
+        int64       Bytes = 0;          // 输出字符数（生成内容基本为ASCII，近似字节数）
+        double      Seconds = 0.0;
+        int64       Allocations = 0;    // 测量线程上的Malloc/Realloc次数
+
+        double GetNsPerItem() const { return Items > 0 ? Seconds * 1e9 / Items : 0.0; }
+        double GetAllocsPerItem() const { return Items > 0 ? (double)Allocations / Items : 0.0; }
+    };
+
+    /**
+     * 测量Body在Items上重复Iterations次的耗时和分配次数，每次迭代前清空导出缓存，与单次导出的冷启动状态一致
+     * 计时与计数分开进行，计数代理的额外开销不计入耗时
+     */
+    template<typename TItem, typename TBody>
+    FPerfResult MeasureEntryPoint(const TCHAR* Name, const TArray<TItem>& Items, int32 Iterations, TBody Body)
+    {
+        FPerfResult Result;
+        Result.Name = Name;
+        for (int32 Iteration = 0; Iteration < Iterations; ++Iteration)
+        {
+            FEmmyLuaCodeGenerator::ResetExportCaches();
+            const double StartTime = FPlatformTime::Seconds();
+            for (const TItem& Item : Items)
+            {
+                Result.Bytes += Body(Item).Len();
+            }
+            Result.Seconds += FPlatformTime::Seconds() - StartTime;
+        }
+        for (int32 Iteration = 0; Iteration < Iterations; ++Iteration)
+        {
+            FEmmyLuaCodeGenerator::ResetExportCaches();
+            FScopedAllocationCounter AllocationCounter;
+            for (const TItem& Item : Items)
+            {
+                Body(Item);
+            }
+            Result.Allocations += AllocationCounter.GetAllocations();
+        }
+        Result.Items = (int64)Items.Num() * Iterations;
+        FEmmyLuaCodeGenerator::ResetExportCaches();
+        return Result;
+    }
+
+    FString GetPerfThresholdsPath()
+    {
+        TSharedPtr<IPlugin> Plugin = IPluginManager::Get().FindPlugin(TEXT("EmmyLuaIntelliSense"));
+        if (Plugin.IsValid())
+        {
+            return FPaths::Combine(Plugin->GetBaseDir(), TEXT("Resources"), TEXT("PerfThresholds.json"));
+        }
+        return FPaths::Combine(FPaths::ProjectConfigDir(), TEXT("EmmyLuaIntelliSense"), TEXT("PerfThresholds.json"));
+    }
+
+    /** 生成器各入口的测试输入，取自所有已加载的反射信息 */
+    struct FPerfInputs
+    {
+        TArray<const UClass*>           Classes;
+        TArray<const UScriptStruct*>    Structs;
+        TArray<const UEnum*>            Enums;
+        TArray<const FProperty*>        Properties;
+        TArray<FString>                 Comments;
+        TArray<FString>                 SymbolNames;
+    };
+
+    void CollectPerfInputs(FPerfInputs& Inputs)
+    {
+        for (TObjectIterator<UField> It; It; ++It)
+        {
+            const UField* Field = *It;
+            if (FEmmyLuaCodeGenerator::ShouldSkipType(Field))
+            {
+                continue;
+            }
+            if (const UClass* Class = Cast<UClass>(Field))
+            {
+                Inputs.Classes.Add(Class);
+            }
+            else if (const UScriptStruct* Struct = Cast<UScriptStruct>(Field))
+            {
+                Inputs.Structs.Add(Struct);
+            }
+            else if (const UEnum* Enum = Cast<UEnum>(Field))
+            {
+                Inputs.Enums.Add(Enum);
+            }
+        }
+        CollectAllProperties(Inputs.Properties);
+        for (const FProperty* Property : Inputs.Properties)
+        {
+            Inputs.SymbolNames.Add(Property->GetName());
+#if WITH_METADATA
+            const FString& ToolTip = Property->GetMetaData(TEXT("ToolTip"));
+            if (!ToolTip.IsEmpty())
+            {
+                Inputs.Comments.Add(ToolTip);
+            }
+#endif
+        }
+        for (TObjectIterator<UFunction> It; It; ++It)
+        {
+            Inputs.SymbolNames.Add(It->GetName());
+        }
+    }
+
+    /** 按名称测量一个生成器入口，名称与PerfThresholds.json中的键一致 */
+    bool MeasureNamedEntryPoint(const FString& Name, const FPerfInputs& Inputs, int32 Iterations, FPerfResult& OutResult)
+    {
+        if (Name == TEXT("GenerateClass"))
+        {
+            OutResult = MeasureEntryPoint(TEXT("GenerateClass"), Inputs.Classes, Iterations, [](const UClass* Class) { return FEmmyLuaCodeGenerator::GenerateClass(Class); });
+        }
+        else if (Name == TEXT("GenerateStruct"))
+        {
+            OutResult = MeasureEntryPoint(TEXT("GenerateStruct"), Inputs.Structs, Iterations, [](const UScriptStruct* Struct) { return FEmmyLuaCodeGenerator::GenerateStruct(Struct); });
+        }
+        else if (Name == TEXT("GenerateEnum"))
+        {
+            OutResult = MeasureEntryPoint(TEXT("GenerateEnum"), Inputs.Enums, Iterations, [](const UEnum* Enum) { return FEmmyLuaCodeGenerator::GenerateEnum(Enum); });
+        }
+        else if (Name == TEXT("GetTypeName"))
+        {
+            OutResult = MeasureEntryPoint(TEXT("GetTypeName"), Inputs.Properties, Iterations, [](const FProperty* Property) { return FEmmyLuaCodeGenerator::GetTypeName(Property); });
+        }
+        else if (Name == TEXT("EscapeComments"))
+        {
+            OutResult = MeasureEntryPoint(TEXT("EscapeComments"), Inputs.Comments, Iterations, [](const FString& Comment) { return FEmmyLuaCodeGenerator::EscapeComments(Comment); });
+        }
+        else if (Name == TEXT("EscapeSymbolName"))
+        {
+            OutResult = MeasureEntryPoint(TEXT("EscapeSymbolName"), Inputs.SymbolNames, Iterations, [](const FString& SymbolName) { return FEmmyLuaCodeGenerator::EscapeSymbolName(SymbolName); });
+        }
+        else
+        {
+            return false;
+        }
+        return true;
+    }
+
+    const TCHAR* const PerfEntryPoints[] =
+    {
+        TEXT("GenerateClass"), TEXT("GenerateStruct"), TEXT("GenerateEnum"),
+        TEXT("GetTypeName"), TEXT("EscapeComments"), TEXT("EscapeSymbolName")
+    };
+
+    constexpr int32 PerfIterations = 3;
+
+    /** PerfThresholds.json的内容：容差和各入口的基线 */
+    struct FPerfBaseline
+    {
+        double                      Tolerance = 1.5;
+        TSharedPtr<FJsonObject>     NsPerItem = MakeShareable(new FJsonObject);
+        TSharedPtr<FJsonObject>     AllocsPerItem = MakeShareable(new FJsonObject);
+    };
+
+    /** 读取PerfThresholds.json，缺失的字段保持默认值 */
+    FPerfBaseline LoadPerfBaseline()
+    {
+        FPerfBaseline Baseline;
+        FString JsonString;
+        if (FFileHelper::LoadFileToString(JsonString, *GetPerfThresholdsPath()))
+        {
+            TSharedPtr<FJsonObject> JsonObject;
+            TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(JsonString);
+            const TSharedPtr<FJsonObject>* StoredBaseline = nullptr;
+            if (FJsonSerializer::Deserialize(Reader, JsonObject) && JsonObject.IsValid())
+            {
+                JsonObject->TryGetNumberField(TEXT("tolerance"), Baseline.Tolerance);
+                if (JsonObject->TryGetObjectField(TEXT("baselineNsPerItem"), StoredBaseline))
+                {
+                    Baseline.NsPerItem = *StoredBaseline;
+                }
+                if (JsonObject->TryGetObjectField(TEXT("baselineAllocsPerItem"), StoredBaseline))
+                {
+                    Baseline.AllocsPerItem = *StoredBaseline;
+                }
+            }
+        }
+        return Baseline;
+    }
+
+    void LogPerfResult(const FPerfResult& Result, double BaselineNs, double BaselineAllocs)
+    {
+        const double Seconds = FMath::Max(Result.Seconds, SMALL_NUMBER);
+        UE_LOG(LogEmmyLuaIntelliSense, Log, TEXT("[PERF] %-16s %8lld items  %10.0f items/s  %8.2f MB/s  %9.1f ns/item  baseline %9.1f  %7.2f allocs/item  baseline %7.2f"),
+            *Result.Name, Result.Items, Result.Items / Seconds, Result.Bytes / Seconds / (1024.0 * 1024.0), Result.GetNsPerItem(),
+            BaselineNs, Result.GetAllocsPerItem(), BaselineAllocs);
+    }
+
+    /**
+     * 用本机的测量结果重写PerfThresholds.json中的基线
+     * 用法: EmmyLua.Perf.UpdateBaseline [Iterations]
+     * 基线检查由自动化测试EmmyLua.Perf.*执行：Automation RunTests EmmyLua.Perf
+     */
+    void UpdatePerfBaseline(const TArray<FString>& Args)
+    {
+        const int32 Iterations = Args.Num() > 0 ? FMath::Max(1, FCString::Atoi(*Args[0])) : PerfIterations;
+        const double Tolerance = LoadPerfBaseline().Tolerance;
+        FPerfInputs Inputs;
+        CollectPerfInputs(Inputs);
+        TSharedPtr<FJsonObject> NewNsPerItem = MakeShareable(new FJsonObject);
+        TSharedPtr<FJsonObject> NewAllocsPerItem = MakeShareable(new FJsonObject);
+        for (const TCHAR* EntryPoint : PerfEntryPoints)
+        {
+            FPerfResult Result;
+            MeasureNamedEntryPoint(EntryPoint, Inputs, Iterations, Result);
+            LogPerfResult(Result, 0.0, 0.0);
+            NewNsPerItem->SetNumberField(Result.Name, Result.GetNsPerItem());
+            NewAllocsPerItem->SetNumberField(Result.Name, Result.GetAllocsPerItem());
+        }
+        const FString ThresholdsPath = GetPerfThresholdsPath();
+        TSharedPtr<FJsonObject> JsonObject = MakeShareable(new FJsonObject);
+        JsonObject->SetNumberField(TEXT("tolerance"), Tolerance);
+        JsonObject->SetObjectField(TEXT("baselineNsPerItem"), NewNsPerItem);
+        JsonObject->SetObjectField(TEXT("baselineAllocsPerItem"), NewAllocsPerItem);
+        FString OutputString;
+        TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&OutputString);
+        FJsonSerializer::Serialize(JsonObject.ToSharedRef(), Writer);
+        if (FFileHelper::SaveStringToFile(OutputString, *ThresholdsPath, FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM))
+        {
+            UE_LOG(LogEmmyLuaIntelliSense, Log, TEXT("[PERF] Baseline updated: %s"), *ThresholdsPath);
+        }
+        else
+        {
+            UE_LOG(LogEmmyLuaIntelliSense, Error, TEXT("[PERF] Failed to write baseline: %s"), *ThresholdsPath);
+        }
+    }
+
+    FAutoConsoleCommand PerfUpdateBaselineCommand(
+        TEXT("EmmyLua.Perf.UpdateBaseline"),
+        TEXT("Measure every FEmmyLuaCodeGenerator entry point over all loaded reflection and rewrite Resources/PerfThresholds.json. Usage: EmmyLua.Perf.UpdateBaseline [Iterations]"),
+        FConsoleCommandWithArgsDelegate::CreateStatic(&UpdatePerfBaseline));
+}
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FEmmyLuaTypeNameBenchmarkTest, "EmmyLua.Perf.TypeNames",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::PerfFilter)
+
+bool FEmmyLuaTypeNameBenchmarkTest::RunTest(const FString& Parameters)
+{
+    const FTypeNameBenchResult Result = BenchmarkTypeNames(10);
+    LogTypeNameBenchmark(Result);
+    TestTrue(TEXT("Loaded reflection has properties"), Result.Properties > 0);
+    TestEqual(TEXT("Cached type names match uncached ones"), Result.Mismatches, 0);
+    if (Result.EmptyNames > 0)
+    {
+        AddWarning(FString::Printf(TEXT("%d properties resolved to an empty type name"), Result.EmptyNames));
+    }
+    return true;
+}
+
+/**
+ * 生成器性能测试，每个入口一个测试：Automation RunTests EmmyLua.Perf
+ * 测量所有已加载反射信息上的ns/条目，超过PerfThresholds.json中 基线 x 容差 视为退化
+ */
+#define EMMYLUA_PERF_TEST(EntryPoint) \
+    IMPLEMENT_SIMPLE_AUTOMATION_TEST(FEmmyLuaPerf##EntryPoint##Test, "EmmyLua.Perf." #EntryPoint, \
+        EAutomationTestFlags::EditorContext | EAutomationTestFlags::PerfFilter) \
+    bool FEmmyLuaPerf##EntryPoint##Test::RunTest(const FString& Parameters) \
+    { \
+        return RunPerfEntryPointTest(*this, TEXT(#EntryPoint)); \
+    }
+
+namespace
+{
+    bool RunPerfEntryPointTest(FAutomationTestBase& Test, const TCHAR* EntryPoint)
+    {
+        const FPerfBaseline Baseline = LoadPerfBaseline();
+        FPerfInputs Inputs;
+        CollectPerfInputs(Inputs);
+        FPerfResult Result;
+        if (!Test.TestTrue(TEXT("Known entry point"), MeasureNamedEntryPoint(EntryPoint, Inputs, PerfIterations, Result)))
+        {
+            return false;
+        }
+        double BaselineNs = 0.0;
+        double BaselineAllocs = 0.0;
+        const bool bHasBaseline = Baseline.NsPerItem->TryGetNumberField(EntryPoint, BaselineNs) && BaselineNs > 0.0
+            && Baseline.AllocsPerItem->TryGetNumberField(EntryPoint, BaselineAllocs);
+        LogPerfResult(Result, BaselineNs, BaselineAllocs);
+        Test.TestTrue(TEXT("Entry point has inputs"), Result.Items > 0);
+        if (!Test.TestTrue(FString::Printf(TEXT("%s has a baseline in %s (record it with EmmyLua.Perf.UpdateBaseline)"), EntryPoint, *GetPerfThresholdsPath()), bHasBaseline))
+        {
+            return false;
+        }
+        Test.TestTrue(FString::Printf(TEXT("%s %.1f ns/item within %.2fx of baseline %.1f ns/item"), EntryPoint, Result.GetNsPerItem(), Baseline.Tolerance, BaselineNs),
+            Result.GetNsPerItem() <= BaselineNs * Baseline.Tolerance);
+        // 分配次数与机器无关，只允许在基线上取整的余量
+        Test.TestTrue(FString::Printf(TEXT("%s %.2f allocs/item within baseline %.2f allocs/item"), EntryPoint, Result.GetAllocsPerItem(), BaselineAllocs),
+            Result.GetAllocsPerItem() <= BaselineAllocs + 0.01);
+        return true;
+    }
+}
+
+EMMYLUA_PERF_TEST(GenerateClass)
+EMMYLUA_PERF_TEST(GenerateStruct)
+EMMYLUA_PERF_TEST(GenerateEnum)
+EMMYLUA_PERF_TEST(GetTypeName)
+EMMYLUA_PERF_TEST(EscapeComments)
+EMMYLUA_PERF_TEST(EscapeSymbolName)
+
+#undef EMMYLUA_PERF_TEST
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,323 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "LuaCodeGenerator.h"
+#include "LuaTestTypeFactory.h"
+#include "EmmyLuaIntelliSense.h"
+#include "EmmyLuaIntelliSenseSettings.h"
+#include "HAL/IConsoleManager.h"
+#include "Interfaces/IPluginManager.h"
+#include "UObject/UnrealType.h"
+#include "UObject/Package.h"
+#include "Engine/Blueprint.h"
+#include "Engine/BlueprintGeneratedClass.h"
+#include "Engine/EngineTypes.h"
+#include "Kismet2/KismetEditorUtilities.h"
+#include "Kismet2/BlueprintEditorUtils.h"
+#include "EdGraphSchema_K2.h"
+#include "Misc/AutomationTest.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Misc/ScopeExit.h"
+#include "Templates/UnrealTemplate.h"
+
+namespace
+{
+    /** 金标准文件目录：<Plugin>/Resources/Golden */
+    FString GetGoldenDir()
+    {
+        TSharedPtr<IPlugin> Plugin = IPluginManager::Get().FindPlugin(TEXT("EmmyLuaIntelliSense"));
+        if (Plugin.IsValid())
+        {
+            return FPaths::Combine(Plugin->GetBaseDir(), TEXT("Resources"), TEXT("Golden"));
+        }
+        return FPaths::Combine(FPaths::ProjectConfigDir(), TEXT("EmmyLuaIntelliSense"), TEXT("Golden"));
+    }
+
+    /** 找到第一处不同的行，返回行号（从1开始） */
+    int32 FindFirstDifferentLine(const FString& Expected, const FString& Actual, FString& OutExpectedLine, FString& OutActualLine)
+    {
+        TArray<FString> ExpectedLines, ActualLines;
+        Expected.ParseIntoArray(ExpectedLines, TEXT("\n"), false);
+        Actual.ParseIntoArray(ActualLines, TEXT("\n"), false);
+        const int32 LineCount = FMath::Max(ExpectedLines.Num(), ActualLines.Num());
+        for (int32 Index = 0; Index < LineCount; ++Index)
+        {
+            OutExpectedLine = ExpectedLines.IsValidIndex(Index) ? ExpectedLines[Index] : TEXT("<end of file>");
+            OutActualLine = ActualLines.IsValidIndex(Index) ? ActualLines[Index] : TEXT("<end of file>");
+            if (!OutExpectedLine.Equals(OutActualLine, ESearchCase::CaseSensitive))
+            {
+                return Index + 1;
+            }
+        }
+        return 0;
+    }
+
+    /** 当前输出与金标准的比较结果 */
+    struct FGoldenStats
+    {
+        int32   Matched = 0;
+        int32   Mismatched = 0;
+        int32   Missing = 0;
+        int32   Updated = 0;
+    };
+
+    /** 比较或更新单个金标准文件，不一致时把实际输出写到Saved目录便于对比 */
+    void CheckGoldenFile(const FString& RelativePath, const FString& Actual, bool bUpdate, FGoldenStats& Stats)
+    {
+        const FString GoldenPath = FPaths::Combine(GetGoldenDir(), RelativePath);
+        if (bUpdate)
+        {
+            FString Existing;
+            if (!FFileHelper::LoadFileToString(Existing, *GoldenPath) || !Existing.Equals(Actual, ESearchCase::CaseSensitive))
+            {
+                FFileHelper::SaveStringToFile(Actual, *GoldenPath, FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM);
+                ++Stats.Updated;
+            }
+            return;
+        }
+        FString Expected;
+        if (!FFileHelper::LoadFileToString(Expected, *GoldenPath))
+        {
+            UE_LOG(LogEmmyLuaIntelliSense, Warning, TEXT("[GOLDEN] Missing golden file: %s (record it with EmmyLua.Golden.Update)"), *RelativePath);
+            ++Stats.Missing;
+            return;
+        }
+        if (Expected.Equals(Actual, ESearchCase::CaseSensitive))
+        {
+            ++Stats.Matched;
+            return;
+        }
+        ++Stats.Mismatched;
+        FString ExpectedLine, ActualLine;
+        const int32 Line = FindFirstDifferentLine(Expected, Actual, ExpectedLine, ActualLine);
+        const FString ActualPath = FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("EmmyLuaGolden"), RelativePath);
+        FFileHelper::SaveStringToFile(Actual, *ActualPath, FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM);
+        UE_LOG(LogEmmyLuaIntelliSense, Error, TEXT("[GOLDEN] %s differs at line %d\n    expected: %s\n    actual:   %s\n    actual output: %s"),
+            *RelativePath, Line, *ExpectedLine.TrimEnd(), *ActualLine.TrimEnd(), *ActualPath);
+    }
+
+    /** 测试类型所在的临时包，不带原生标记，测试结束后由GC回收 */
+    const TCHAR* GoldenPackageName = TEXT("/Temp/EmmyLuaGolden");
+
+    /**
+     * 金标准测试使用的固定类型
+     * 在代码中按固定的名称、成员和注释构造，输出不随引擎版本变化；
+     * 覆盖注释清理、关键字转义、静态函数、结构体属性和各输出配置的过滤规则
+     */
+    struct FGoldenFixtures
+    {
+        TArray<UObject*>        Objects;        // 需要保持Root的对象
+        TArray<const UObject*>  Types;          // 参与比较的类型，按输出文件名排列
+    };
+
+    /** 金标准类型的注释按头文件注释的形式写入Comment元数据 */
+    template <typename TField>
+    void SetGoldenComment(TField* Field, const TCHAR* Comment)
+    {
+        FLuaTestTypeFactory::SetComment(Field, TEXT("Comment"), Comment);
+    }
+
+    UScriptStruct* CreateGoldenStruct(UPackage* Package)
+    {
+        UScriptStruct* Struct = NewObject<UScriptStruct>(Package, TEXT("EmmyLuaGoldenStruct"), RF_Public | RF_Transient);
+        FLuaTestTypeFactory::AddProperty<FStrProperty>(Struct, TEXT("Label"), CPF_Edit);
+        SetGoldenComment(FLuaTestTypeFactory::AddProperty<FIntProperty>(Struct, TEXT("Value"), CPF_Edit | CPF_BlueprintVisible), TEXT("Stored value."));
+        SetGoldenComment(Struct, TEXT("Golden test struct."));
+        Struct->Bind();
+        Struct->StaticLink(true);
+        return Struct;
+    }
+
+    UEnum* CreateGoldenEnum(UPackage* Package)
+    {
+        UEnum* Enum = NewObject<UEnum>(Package, TEXT("EEmmyLuaGolden"), RF_Public | RF_Transient);
+        TArray<TPair<FName, int64>> Names;
+        Names.Emplace(TEXT("EEmmyLuaGolden::First"), 0);
+        Names.Emplace(TEXT("EEmmyLuaGolden::Second"), 1);
+        Names.Emplace(TEXT("EEmmyLuaGolden::Last"), 10);
+        Enum->SetEnums(Names, UEnum::ECppForm::EnumClass);
+        SetGoldenComment(Enum, TEXT("Golden test enum."));
+        return Enum;
+    }
+
+    UClass* CreateGoldenClass(UPackage* Package, UScriptStruct* Struct)
+    {
+        UClass* Class = FLuaTestTypeFactory::NewClass(Package, TEXT("EmmyLuaGoldenObject"), UObject::StaticClass());
+
+        // 属性声明顺序：Health, Speed, Data, end
+        FLuaTestTypeFactory::AddProperty<FStrProperty>(Class, TEXT("end"), CPF_Edit | CPF_BlueprintVisible);
+        FStructProperty* DataProperty = new FStructProperty(Class, TEXT("Data"), RF_Public);
+        DataProperty->Struct = Struct;
+        SetGoldenComment(DataProperty, TEXT("Nested struct."));
+        FLuaTestTypeFactory::AddProperty(Class, DataProperty, CPF_Edit | CPF_BlueprintVisible);
+        FLuaTestTypeFactory::AddProperty<FFloatProperty>(Class, TEXT("Speed"), CPF_Edit);
+        SetGoldenComment(FLuaTestTypeFactory::AddProperty<FIntProperty>(Class, TEXT("Health"), CPF_Edit | CPF_BlueprintVisible), TEXT("Current health."));
+
+        // 函数声明顺序：GetHealth, ApplyDamage, ResetDefaults
+        UFunction* ResetDefaults = FLuaTestTypeFactory::AddFunction(Class, TEXT("ResetDefaults"), FUNC_Public | FUNC_Static);
+        SetGoldenComment(ResetDefaults, TEXT("Native only."));
+
+        UFunction* ApplyDamage = FLuaTestTypeFactory::AddFunction(Class, TEXT("ApplyDamage"), FUNC_Public | FUNC_BlueprintCallable);
+        FObjectProperty* Instigator = FLuaTestTypeFactory::AddProperty<FObjectProperty>(ApplyDamage, TEXT("Instigator"), CPF_Parm);
+        Instigator->PropertyClass = UObject::StaticClass();
+        FLuaTestTypeFactory::AddProperty<FFloatProperty>(ApplyDamage, TEXT("Amount"), CPF_Parm);
+
+        UFunction* GetHealth = FLuaTestTypeFactory::AddFunction(Class, TEXT("GetHealth"), FUNC_Public | FUNC_BlueprintCallable);
+        FLuaTestTypeFactory::AddProperty<FIntProperty>(GetHealth, TEXT("ReturnValue"), CPF_Parm | CPF_OutParm | CPF_ReturnParm);
+        SetGoldenComment(GetHealth, TEXT("Returns the current health."));
+
+        for (UFunction* Function : { ResetDefaults, ApplyDamage, GetHealth })
+        {
+            Function->StaticLink(true);
+        }
+        // 注释中的"/**"、"*"和换行由EscapeComments清理为单行
+        SetGoldenComment(Class, TEXT("/** Golden test class.\n * Second line. */"));
+        Class->Bind();
+        Class->StaticLink(true);
+        return Class;
+    }
+
+    /** 测试蓝图只存在于临时包中，不保存为资源 */
+    UBlueprint* CreateGoldenBlueprint(UPackage* Package)
+    {
+        UBlueprint* Blueprint = FKismetEditorUtilities::CreateBlueprint(UObject::StaticClass(), Package, TEXT("BP_EmmyLuaGolden"), BPTYPE_Normal,
+            UBlueprint::StaticClass(), UBlueprintGeneratedClass::StaticClass());
+        if (!Blueprint)
+        {
+            return nullptr;
+        }
+        FEdGraphPinType PinType;
+        PinType.PinCategory = UEdGraphSchema_K2::PC_Int;
+        FBlueprintEditorUtils::AddMemberVariable(Blueprint, TEXT("Score"), PinType);
+        Blueprint->BlueprintDescription = TEXT("Golden test blueprint.\nSecond line.");
+        FKismetEditorUtilities::CompileBlueprint(Blueprint);
+        return Blueprint;
+    }
+
+    bool CreateGoldenFixtures(FGoldenFixtures& Fixtures)
+    {
+        UPackage* Package = CreatePackage(GoldenPackageName);
+        Package->SetFlags(RF_Transient);
+        UScriptStruct* Struct = CreateGoldenStruct(Package);
+        UClass* Class = CreateGoldenClass(Package, Struct);
+        UEnum* Enum = CreateGoldenEnum(Package);
+        UBlueprint* Blueprint = CreateGoldenBlueprint(CreatePackage(TEXT("/Temp/EmmyLuaGolden/BP_EmmyLuaGolden")));
+        for (UObject* Object : TArray<UObject*>{ Package, Struct, Class, Enum, Blueprint })
+        {
+            if (Object)
+            {
+                Object->AddToRoot();
+                Fixtures.Objects.Add(Object);
+            }
+        }
+        Fixtures.Types = { Blueprint, Enum, Class, Struct };
+        if (!Blueprint)
+        {
+            UE_LOG(LogEmmyLuaIntelliSense, Error, TEXT("[GOLDEN] Failed to create the test blueprint"));
+            Fixtures.Types.Remove(nullptr);
+            return false;
+        }
+        return true;
+    }
+
+    void DestroyGoldenFixtures(FGoldenFixtures& Fixtures)
+    {
+        Fixtures.Types.Empty();
+        FLuaTestTypeFactory::DestroyObjects(Fixtures.Objects);
+    }
+
+    /** UE表只包含原生类型，使用名称固定的引擎类型 */
+    TArray<const UField*> GetGoldenUETableTypes()
+    {
+        return { UObject::StaticClass(), TBaseStructure<FVector>::Get(), StaticEnum<EComponentMobility::Type>() };
+    }
+
+    /**
+     * 在每种输出配置、每种方言下生成测试类型的代码，
+     * 与Resources/Golden/<Profile>/<Dialect>/<Type>.lua逐字节比较，bUpdate时用当前输出重写金标准
+     */
+    bool RunGoldenComparison(bool bUpdate, FGoldenStats& Stats)
+    {
+        FGoldenFixtures Fixtures;
+        bool bPassed = CreateGoldenFixtures(Fixtures);
+        ON_SCOPE_EXIT
+        {
+            DestroyGoldenFixtures(Fixtures);
+        };
+
+        // 输出配置会影响生成结果，测试期间临时切换，离开作用域时恢复
+        UEmmyLuaIntelliSenseSettings* Settings = UEmmyLuaIntelliSenseSettings::GetMutable();
+        TGuardValue<EEmmyLuaOutputProfile> ProfileGuard(Settings->OutputProfile, Settings->OutputProfile);
+        ON_SCOPE_EXIT
+        {
+            FEmmyLuaCodeGenerator::ResetExportCaches();
+        };
+
+        const UEnum* ProfileEnum = StaticEnum<EEmmyLuaOutputProfile>();
+        const UEnum* DialectEnum = StaticEnum<EEmmyLuaDialect>();
+        const uint32 AllDialects = (1u << static_cast<uint32>(EEmmyLuaDialect::Count)) - 1;
+        for (int32 ProfileIndex = 0; ProfileIndex < ProfileEnum->NumEnums() - 1; ++ProfileIndex)
+        {
+            Settings->OutputProfile = static_cast<EEmmyLuaOutputProfile>(ProfileEnum->GetValueByIndex(ProfileIndex));
+            const FString ProfileName = ProfileEnum->GetNameStringByIndex(ProfileIndex);
+            FEmmyLuaCodeGenerator::ResetExportCaches();
+            FLuaDialectCode DialectCode;
+            for (const UObject* Type : Fixtures.Types)
+            {
+                const FString FileName = FPaths::MakeValidFileName(Type->GetName()) + TEXT(".lua");
+                if (!FEmmyLuaCodeGenerator::GenerateType(Type, AllDialects, true, DialectCode))
+                {
+                    UE_LOG(LogEmmyLuaIntelliSense, Error, TEXT("[GOLDEN] Failed to generate %s"), *Type->GetPathName());
+                    bPassed = false;
+                    continue;
+                }
+                for (uint32 DialectIndex = 0; DialectIndex < static_cast<uint32>(EEmmyLuaDialect::Count); ++DialectIndex)
+                {
+                    const FString DialectName = DialectEnum->GetNameStringByValue(DialectIndex);
+                    CheckGoldenFile(FPaths::Combine(ProfileName, DialectName, FileName), DialectCode[DialectIndex], bUpdate, Stats);
+                }
+            }
+        }
+        CheckGoldenFile(TEXT("UE.lua"), FEmmyLuaCodeGenerator::GenerateUETable(GetGoldenUETableTypes()), bUpdate, Stats);
+        return bPassed;
+    }
+
+    /**
+     * 重写金标准文件
+     * 用法: EmmyLua.Golden.Update
+     * 生成器的输出有意变化时运行，再用版本控制检查差异
+     */
+    void UpdateGoldenFiles()
+    {
+        FGoldenStats Stats;
+        RunGoldenComparison(true, Stats);
+        UE_LOG(LogEmmyLuaIntelliSense, Log, TEXT("[GOLDEN] Updated %d golden files in %s"), Stats.Updated, *GetGoldenDir());
+    }
+
+    FAutoConsoleCommand GoldenUpdateCommand(
+        TEXT("EmmyLua.Golden.Update"),
+        TEXT("Regenerate the checked-in golden files in Resources/Golden from the current generator output. Usage: EmmyLua.Golden.Update"),
+        FConsoleCommandDelegate::CreateStatic(&UpdateGoldenFiles));
+}
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+/**
+ * 金标准输出回归测试：Automation RunTests EmmyLua.Golden
+ * 不一致的实际输出写到Saved/EmmyLuaGolden下便于对比
+ */
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FEmmyLuaGoldenOutputTest, "EmmyLua.Golden",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FEmmyLuaGoldenOutputTest::RunTest(const FString& Parameters)
+{
+    FGoldenStats Stats;
+    TestTrue(TEXT("Golden fixtures generated"), RunGoldenComparison(false, Stats));
+    UE_LOG(LogEmmyLuaIntelliSense, Log, TEXT("[GOLDEN] %d matched, %d differ, %d missing"), Stats.Matched, Stats.Mismatched, Stats.Missing);
+    TestTrue(TEXT("Golden files compared"), Stats.Matched + Stats.Mismatched > 0);
+    TestEqual(TEXT("Golden files that differ"), Stats.Mismatched, 0);
+    TestEqual(TEXT("Golden files missing (run EmmyLua.Golden.Update and commit Resources/Golden)"), Stats.Missing, 0);
+    return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
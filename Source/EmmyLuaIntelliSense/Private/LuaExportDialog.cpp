@@ -3,6 +3,7 @@
 #include "LuaExportDialog.h"
 #include "LuaExportManager.h"
 #include "EmmyLuaIntelliSense.h"
+#include "LuaHitchDetector.h"
 #include "Misc/MessageDialog.h"
 #include "Framework/Notifications/NotificationManager.h"
 #include "Widgets/Notifications/SNotificationList.h"
@@ -108,6 +109,7 @@ void FLuaExportDialog::ShowScanConfirmation()
 
 TSharedPtr<SNotificationItem> FLuaExportNotificationManager::ShowExportConfirmation(const FString& Message)
 {
+    EMMYLUA_GAME_THREAD_SCOPE(Notification);
     FNotificationInfo Info(FText::FromString(Message));
     
     Info.ExpireDuration = 0.0f;
@@ -141,6 +143,7 @@ TSharedPtr<SNotificationItem> FLuaExportNotificationManager::ShowExportConfirmat
 
 TSharedPtr<SNotificationItem> FLuaExportNotificationManager::ShowScanConfirmation(const FString& Message)
 {
+    EMMYLUA_GAME_THREAD_SCOPE(Notification);
     
     FNotificationInfo Info(FText::FromString(Message));
     
@@ -186,6 +189,7 @@ TSharedPtr<SNotificationItem> FLuaExportNotificationManager::ShowScanConfirmatio
 
 TSharedPtr<SNotificationItem> FLuaExportNotificationManager::ShowExportSuccess(const FString& Message)
 {
+    EMMYLUA_GAME_THREAD_SCOPE(Notification);
     FNotificationInfo Info(FText::FromString(Message));
     Info.bFireAndForget = true;
     Info.bUseLargeFont = false;
@@ -200,6 +204,7 @@ TSharedPtr<SNotificationItem> FLuaExportNotificationManager::ShowExportSuccess(c
 
 TSharedPtr<SNotificationItem> FLuaExportNotificationManager::ShowExportFailure(const FString& Message)
 {
+    EMMYLUA_GAME_THREAD_SCOPE(Notification);
     FNotificationInfo Info(FText::FromString(Message));
     Info.bFireAndForget = true;
     Info.bUseLargeFont = false;
@@ -212,8 +217,24 @@ TSharedPtr<SNotificationItem> FLuaExportNotificationManager::ShowExportFailure(c
     return FSlateNotificationManager::Get().AddNotification(Info);
 }
 
+TSharedPtr<SNotificationItem> FLuaExportNotificationManager::ShowPerformanceWarning(const FString& Message)
+{
+    EMMYLUA_GAME_THREAD_SCOPE(Notification);
+    FNotificationInfo Info(FText::FromString(Message));
+    Info.bFireAndForget = true;
+    Info.bUseLargeFont = false;
+    Info.bUseThrobber = false;
+    Info.bUseSuccessFailIcons = false;
+    Info.FadeOutDuration = 5.0f;
+    Info.ExpireDuration = 10.0f;
+    Info.Image = FEditorStyle::GetBrush(TEXT("MessageLog.Warning"));
+
+    return FSlateNotificationManager::Get().AddNotification(Info);
+}
+
 TSharedPtr<SNotificationItem> FLuaExportNotificationManager::ShowExportProgress(const FString& Message)
 {
+    EMMYLUA_GAME_THREAD_SCOPE(Notification);
     FNotificationInfo Info(FText::FromString(Message));
     Info.bFireAndForget = false;
     Info.bUseLargeFont = false;
@@ -227,6 +248,7 @@ TSharedPtr<SNotificationItem> FLuaExportNotificationManager::ShowExportProgress(
 
 void FLuaExportNotificationManager::UpdateProgressNotification(TSharedPtr<SNotificationItem> Notification, const FString& Message, float Progress)
 {
+    EMMYLUA_GAME_THREAD_SCOPE(Notification);
     if (Notification.IsValid())
     {
         Notification->SetText(FText::FromString(Message));
@@ -236,6 +258,7 @@ void FLuaExportNotificationManager::UpdateProgressNotification(TSharedPtr<SNotif
 
 void FLuaExportNotificationManager::CompleteProgressNotification(TSharedPtr<SNotificationItem> Notification, const FString& Message, bool bSuccess)
 {
+    EMMYLUA_GAME_THREAD_SCOPE(Notification);
     if (Notification.IsValid())
     {
         Notification->SetText(FText::FromString(Message));
@@ -312,10 +335,22 @@ void FLuaExportNotificationManager::OnScanSkipped()
         CurrentConfirmationNotification->Fadeout();
         CurrentConfirmationNotification.Reset();
     }
+    
+    // 跳过扫描时释放发现阶段预先计算的指纹
+    if (ULuaExportManager* ExportManager = ULuaExportManager::Get())
+    {
+        ExportManager->DiscardPrefetchedFingerprints();
+    }
 }
 
 void FLuaExportNotificationManager::OnScanConfirmationAutoExpire()
 {
+    // 超时未确认等同于跳过扫描
+    if (ULuaExportManager* ExportManager = ULuaExportManager::Get())
+    {
+        ExportManager->DiscardPrefetchedFingerprints();
+    }
+    
     // 安全检查：确保世界和定时器管理器仍然有效
     if (!GWorld || !IsValid(GWorld))
     {
@@ -344,6 +379,7 @@ void FLuaExportNotificationManager::OnScanConfirmationAutoExpire()
 
 TSharedPtr<SNotificationItem> FLuaExportNotificationManager::ShowScanProgress(const FString& Message)
 {
+    EMMYLUA_GAME_THREAD_SCOPE(Notification);
     FNotificationInfo Info(FText::FromString(Message));
     Info.bFireAndForget = false;
     Info.bUseLargeFont = false;
@@ -365,6 +401,7 @@ TSharedPtr<SNotificationItem> FLuaExportNotificationManager::ShowScanProgress(co
 
 void FLuaExportNotificationManager::UpdateScanProgressNotification(TSharedPtr<SNotificationItem> Notification, const FString& Message, float Progress)
 {
+    EMMYLUA_GAME_THREAD_SCOPE(Notification);
     if (Notification.IsValid())
     {
         Notification->SetText(FText::FromString(Message));
@@ -374,6 +411,7 @@ void FLuaExportNotificationManager::UpdateScanProgressNotification(TSharedPtr<SN
 
 void FLuaExportNotificationManager::CompleteScanProgressNotification(TSharedPtr<SNotificationItem> Notification, const FString& Message, bool bSuccess)
 {
+    EMMYLUA_GAME_THREAD_SCOPE(Notification);
     if (Notification.IsValid())
     {
         Notification->SetText(FText::FromString(Message));
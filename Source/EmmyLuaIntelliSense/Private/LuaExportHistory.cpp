@@ -0,0 +1,211 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "LuaExportHistory.h"
+#include "EmmyLuaIntelliSense.h"
+#include "HAL/FileManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Dom/JsonObject.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/JsonWriter.h"
+#include "Serialization/JsonReader.h"
+#include "Policies/CondensedJsonPrintPolicy.h"
+
+namespace
+{
+    // 历史格式变化时递增，旧历史会被丢弃
+    constexpr int32 HistoryVersion = 1;
+
+    // 历史记录的保留天数和条数上限
+    constexpr int32 HistoryRetentionDays = 30;
+    constexpr int32 MaxHistoryRecords = 1000;
+
+    // 计算基线至少需要的同类型运行次数
+    constexpr int32 MinBaselineRuns = 3;
+
+    // 基线和本次耗时都低于该值的阶段不比较，避免计时抖动误报
+    constexpr double MinComparedSeconds = 0.1;
+
+    /** 本轮处理的条目数（各分类扫描和导出数之和），耗时按条目数归一化后再比较 */
+    int64 GetProcessedItems(const FLuaExportRunRecord& Record)
+    {
+        int64 Items = 0;
+        for (const auto& Pair : Record.Counts)
+        {
+            if (Pair.Key.EndsWith(TEXT("Scanned")) || Pair.Key.EndsWith(TEXT("Exported")))
+            {
+                Items += Pair.Value;
+            }
+        }
+        return FMath::Max<int64>(Items, 1);
+    }
+
+    double Median(TArray<double>& Values)
+    {
+        Values.Sort();
+        const int32 Middle = Values.Num() / 2;
+        return Values.Num() % 2 == 1 ? Values[Middle] : (Values[Middle - 1] + Values[Middle]) * 0.5;
+    }
+}
+
+void FLuaExportHistory::Load(const FString& InHistoryFilePath)
+{
+    HistoryFilePath = InHistoryFilePath;
+    Records.Empty();
+    FString JsonString;
+    if (!FFileHelper::LoadFileToString(JsonString, *HistoryFilePath))
+    {
+        return;
+    }
+    TSharedPtr<FJsonObject> JsonObject;
+    TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(JsonString);
+    int32 Version = 0;
+    const TArray<TSharedPtr<FJsonValue>>* RunArray = nullptr;
+    if (!FJsonSerializer::Deserialize(Reader, JsonObject) || !JsonObject.IsValid()
+        || !JsonObject->TryGetNumberField(TEXT("Version"), Version) || Version != HistoryVersion
+        || !JsonObject->TryGetArrayField(TEXT("Runs"), RunArray))
+    {
+        UE_LOG(LogEmmyLuaIntelliSense, Log, TEXT("[HISTORY] Export history is outdated, starting fresh: %s"), *HistoryFilePath);
+        return;
+    }
+    Records.Reserve(RunArray->Num());
+    for (const TSharedPtr<FJsonValue>& RunValue : *RunArray)
+    {
+        const TSharedPtr<FJsonObject>* RunObject = nullptr;
+        FString TimeString;
+        if (!RunValue->TryGetObject(RunObject)
+            || !(*RunObject)->TryGetStringField(TEXT("Time"), TimeString))
+        {
+            continue;
+        }
+        FLuaExportRunRecord& Record = Records.AddDefaulted_GetRef();
+        (*RunObject)->TryGetStringField(TEXT("RunType"), Record.RunType);
+        FDateTime::ParseIso8601(*TimeString, Record.Time);
+        const TSharedPtr<FJsonObject>* PhasesObject = nullptr;
+        if ((*RunObject)->TryGetObjectField(TEXT("Phases"), PhasesObject))
+        {
+            for (const auto& Pair : (*PhasesObject)->Values)
+            {
+                Record.PhaseSeconds.Add(Pair.Key, Pair.Value->AsNumber());
+            }
+        }
+        const TSharedPtr<FJsonObject>* CountsObject = nullptr;
+        if ((*RunObject)->TryGetObjectField(TEXT("Counts"), CountsObject))
+        {
+            for (const auto& Pair : (*CountsObject)->Values)
+            {
+                Record.Counts.Add(Pair.Key, (int64)Pair.Value->AsNumber());
+            }
+        }
+    }
+}
+
+void FLuaExportHistory::Append(FLuaExportRunRecord&& Record)
+{
+    const FDateTime OldestKept = Record.Time - FTimespan::FromDays(HistoryRetentionDays);
+    Records.RemoveAll([&OldestKept](const FLuaExportRunRecord& Existing)
+    {
+        return Existing.Time < OldestKept;
+    });
+    if (Records.Num() >= MaxHistoryRecords)
+    {
+        Records.RemoveAt(0, Records.Num() - MaxHistoryRecords + 1);
+    }
+    Records.Add(MoveTemp(Record));
+    Save();
+}
+
+void FLuaExportHistory::FindRegressions(const FLuaExportRunRecord& Record, int32 BaselineDays, float Threshold, TArray<FLuaPhaseRegression>& OutRegressions) const
+{
+    OutRegressions.Reset();
+    if (Threshold <= 1.0f)
+    {
+        return;
+    }
+    const FDateTime BaselineStart = Record.Time - FTimespan::FromDays(BaselineDays);
+    TArray<const FLuaExportRunRecord*> BaselineRecords;
+    for (const FLuaExportRunRecord& Existing : Records)
+    {
+        if (Existing.RunType == Record.RunType
+            && Existing.Time >= BaselineStart && Existing.Time < Record.Time)
+        {
+            BaselineRecords.Add(&Existing);
+        }
+    }
+    if (BaselineRecords.Num() < MinBaselineRuns)
+    {
+        return;
+    }
+    // 增量导出的规模每次不同，基线取每条目耗时的中位数，再换算到本次的条目数
+    const int64 RecordItems = GetProcessedItems(Record);
+    TArray<double> Samples;
+    for (const auto& Phase : Record.PhaseSeconds)
+    {
+        Samples.Reset();
+        for (const FLuaExportRunRecord* Existing : BaselineRecords)
+        {
+            if (const double* Seconds = Existing->PhaseSeconds.Find(Phase.Key))
+            {
+                Samples.Add(*Seconds / GetProcessedItems(*Existing));
+            }
+        }
+        if (Samples.Num() < MinBaselineRuns)
+        {
+            continue;
+        }
+        const double BaselineSeconds = Median(Samples) * RecordItems;
+        if (FMath::Max(Phase.Value, BaselineSeconds) < MinComparedSeconds || Phase.Value <= BaselineSeconds * Threshold)
+        {
+            continue;
+        }
+        FLuaPhaseRegression& Regression = OutRegressions.AddDefaulted_GetRef();
+        Regression.Phase = Phase.Key;
+        Regression.Seconds = Phase.Value;
+        Regression.BaselineSeconds = BaselineSeconds;
+        Regression.BaselineRuns = Samples.Num();
+    }
+    OutRegressions.Sort([](const FLuaPhaseRegression& A, const FLuaPhaseRegression& B)
+    {
+        return A.Seconds - A.BaselineSeconds > B.Seconds - B.BaselineSeconds;
+    });
+}
+
+void FLuaExportHistory::Save() const
+{
+    if (HistoryFilePath.IsEmpty())
+    {
+        return;
+    }
+    TArray<TSharedPtr<FJsonValue>> RunArray;
+    RunArray.Reserve(Records.Num());
+    for (const FLuaExportRunRecord& Record : Records)
+    {
+        TSharedPtr<FJsonObject> RunObject = MakeShareable(new FJsonObject);
+        RunObject->SetStringField(TEXT("RunType"), Record.RunType);
+        RunObject->SetStringField(TEXT("Time"), Record.Time.ToIso8601());
+        TSharedPtr<FJsonObject> PhasesObject = MakeShareable(new FJsonObject);
+        for (const auto& Pair : Record.PhaseSeconds)
+        {
+            PhasesObject->SetNumberField(Pair.Key, Pair.Value);
+        }
+        RunObject->SetObjectField(TEXT("Phases"), PhasesObject);
+        TSharedPtr<FJsonObject> CountsObject = MakeShareable(new FJsonObject);
+        for (const auto& Pair : Record.Counts)
+        {
+            CountsObject->SetNumberField(Pair.Key, (double)Pair.Value);
+        }
+        RunObject->SetObjectField(TEXT("Counts"), CountsObject);
+        RunArray.Add(MakeShareable(new FJsonValueObject(RunObject)));
+    }
+    TSharedPtr<FJsonObject> JsonObject = MakeShareable(new FJsonObject);
+    JsonObject->SetNumberField(TEXT("Version"), HistoryVersion);
+    JsonObject->SetArrayField(TEXT("Runs"), RunArray);
+    FString JsonString;
+    TSharedRef<TJsonWriter<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>> Writer = TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>::Create(&JsonString);
+    FJsonSerializer::Serialize(JsonObject.ToSharedRef(), Writer);
+    IFileManager::Get().MakeDirectory(*FPaths::GetPath(HistoryFilePath), true);
+    if (!FFileHelper::SaveStringToFile(JsonString, *HistoryFilePath, FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM))
+    {
+        UE_LOG(LogEmmyLuaIntelliSense, Warning, TEXT("[HISTORY] Failed to save export history to: %s"), *HistoryFilePath);
+    }
+}
@@ -15,10 +15,14 @@
 #include "Framework/Notifications/NotificationManager.h"
 #include "Widgets/Notifications/SNotificationList.h"
 #include "EmmyLuaIntelliSense.h"
+#include "EmmyLuaIntelliSenseStats.h"
+#include "LuaHitchDetector.h"
+#include "LuaThrottledPlatformFile.h"
 #include "Modules/ModuleManager.h"
 #include "Engine/Engine.h"
 #include "Engine/World.h"
 #include "Misc/ScopedSlowTask.h"
+#include "Misc/ScopeExit.h"
 #include "Dom/JsonObject.h"
 #include "Serialization/JsonSerializer.h"
 #include "Serialization/JsonWriter.h"
@@ -27,6 +31,7 @@
 #include "Async/Async.h"
 #include "TimerManager.h"
 #include "Editor.h"
+#include "Containers/Ticker.h"
 
 ULuaExportManager::ULuaExportManager()
     : bInitialized(false)
@@ -35,6 +40,13 @@ ULuaExportManager::ULuaExportManager()
     , bIsFramedProcessingInProgress(false)
     , CurrentBlueprintIndex(0)
     , CurrentNativeTypeIndex(0)
+    , bExportCacheDirty(false)
+    , CoalescedEventCount(0)
+    , FirstChangeTime(0.0)
+    , LastChangeTime(0.0)
+    , bIsFlushingChanges(false)
+    , WrittenFileCount(0)
+    , UnchangedFileCount(0)
 {
     FieldHashCache.Empty();
     FieldHashCacheTimestamp.Empty();
@@ -48,6 +60,9 @@ ULuaExportManager::ULuaExportManager()
     {
         ExportCacheFilePath = FPaths::Combine(FPaths::ProjectIntermediateDir(), TEXT("EmmyLuaIntelliSense"), TEXT("ExportCache.json"));
     }
+    ExportReportFilePath = FPaths::Combine(FPaths::GetPath(ExportCacheFilePath), TEXT("ExportReport.json"));
+    ExportFile = MakeUnique<FLuaExportPlatformFile>(ExportReport);
+    ExportFile->Initialize(&FPlatformFileManager::Get().GetPlatformFile(), TEXT(""));
 }
 ULuaExportManager* ULuaExportManager::Get()
 {
@@ -55,6 +70,7 @@ ULuaExportManager* ULuaExportManager::Get()
 }
 void ULuaExportManager::Initialize(FSubsystemCollectionBase& Collection)
 {
+    EMMYLUA_LLM_SCOPE(Plugin);
     Super::Initialize(Collection);
     UE_LOG(LogEmmyLuaIntelliSense, Warning, TEXT("=== ULuaExportManager::Initialize() called ==="));
     if (bInitialized)
@@ -63,7 +79,14 @@ void ULuaExportManager::Initialize(FSubsystemCollectionBase& Collection)
         return;
     }
     OutputDir = GetOutputDirectory();
+    FLuaHitchDetector::Start();
     LoadExportCache();
+    if (!SymbolIndex.Load(FPaths::Combine(OutputDir, TEXT("SymbolIndex.json"))))
+    {
+        // 哈希缓存命中的类型不会重新写出，索引只能从已有输出补建；UELib是拷贝的库文件，不在索引中
+        SymbolIndex.Rebuild(GetDialectOutputDir(EEmmyLuaDialect::EmmyLua), { TEXT("UELib") });
+    }
+    RegisterChangeEvents();
     bInitialized = true;
     UE_LOG(LogEmmyLuaIntelliSense, Log, TEXT("=== LuaExportManager initialized successfully. Output directory: %s ==="), *OutputDir);
 }
@@ -74,7 +97,23 @@ void ULuaExportManager::Deinitialize()
     {
         return;
     }
+    UnregisterChangeEvents();
+    if (CoalesceTickerHandle.IsValid())
+    {
+        FTicker::GetCoreTicker().RemoveTicker(CoalesceTickerHandle);
+        CoalesceTickerHandle.Reset();
+    }
+    CoalescedChanges.Empty();
+    ChangeRecorder.Stop();
+    EndOutputRedirect();
+    bPrefetchStopRequested = true;
+    if (PrefetchTask.IsValid())
+    {
+        FTaskGraphInterface::Get().WaitUntilTaskCompletes(PrefetchTask);
+        PrefetchTask = nullptr;
+    }
     SaveExportCache();
+    FLuaHitchDetector::Stop();
     bInitialized = false;
     PendingBlueprints.Empty();
     PendingNativeTypes.Empty();
@@ -85,59 +124,89 @@ void ULuaExportManager::Deinitialize()
 }
 void ULuaExportManager::ExportAll()
 {
+    EMMYLUA_GAME_THREAD_SCOPE(ExportAll);
+    EMMYLUA_LLM_SCOPE(Plugin);
     if (!bInitialized)
     {
         UE_LOG(LogEmmyLuaIntelliSense, Warning, TEXT("LuaExportManager not initialized."));
         return;
     }
     UE_LOG(LogEmmyLuaIntelliSense, Log, TEXT("Starting full Lua export..."));
-    FAssetRegistryModule& AssetRegistryModule = FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry"));
-    FARFilter Filter;
-    Filter.ClassNames.Add(UBlueprint::StaticClass()->GetFName());
+    BeginExportReport(TEXT("Full"));
+    ValidateOutputSignature();
+    FEmmyLuaCodeGenerator::ResetExportCaches();
+    WrittenFileCount = 0;
+    UnchangedFileCount = 0;
+    bool bExportCancelled = false;
+    ON_SCOPE_EXIT
+    {
+        FEmmyLuaCodeGenerator::ResetExportCaches();
+        FinishExportReport(bExportCancelled);
+    };
     TArray<FAssetData> BlueprintAssets;
-    AssetRegistryModule.Get().GetAssets(Filter, BlueprintAssets);
     TArray<const UField*> NativeTypes;
-    CollectNativeTypes(NativeTypes);
+    {
+        FLuaExportReport::FScopedPhase Phase(ExportReport, TEXT("CollectAssets"));
+        FAssetRegistryModule& AssetRegistryModule = FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry"));
+        FARFilter Filter;
+        Filter.ClassNames.Add(UBlueprint::StaticClass()->GetFName());
+        AssetRegistryModule.Get().GetAssets(Filter, BlueprintAssets);
+        CollectNativeTypes(NativeTypes);
+    }
     int32 TotalCount = BlueprintAssets.Num() + NativeTypes.Num() + 1; 
     int32 ExportedCount = 0; // 添加导出计数器
     FScopedSlowTask SlowTask(TotalCount, FText::FromString(TEXT("正在导出Lua IntelliSense文件...")));
     SlowTask.MakeDialog();
     try
     {
+        ExportReport.AddScanned(ELuaExportCategory::Blueprint, BlueprintAssets.Num());
+        ExportReport.AddScanned(ELuaExportCategory::NativeType, NativeTypes.Num());
         for (const FAssetData& AssetData : BlueprintAssets)
         {
             if (SlowTask.ShouldCancel())
             {
                 UE_LOG(LogEmmyLuaIntelliSense, Warning, TEXT("Lua export cancelled by user."));
+                bExportCancelled = true;
                 return;
             }
             SlowTask.EnterProgressFrame(1.0f, FText::FromString(FString::Printf(TEXT("正在导出蓝图: %s"), *AssetData.AssetName.ToString())));
             if (ShouldExportBlueprint(AssetData, false))
             {
-                if (UBlueprint* Blueprint = LoadObject<UBlueprint>(nullptr, *AssetData.ObjectPath.ToString()))
+                if (UBlueprint* Blueprint = LoadBlueprint(AssetData.ObjectPath.ToString()))
                 {
                     ExportBlueprint(Blueprint);
+                    ExportReport.AddExported(ELuaExportCategory::Blueprint);
                     ExportedCount++; // 增加导出计数
                 }
             }
+            else
+            {
+                ExportReport.AddSkipped(ELuaExportCategory::Blueprint);
+            }
         }
         for (const UField* Field : NativeTypes)
         {
             if (SlowTask.ShouldCancel())
             {
                 UE_LOG(LogEmmyLuaIntelliSense, Warning, TEXT("Lua export cancelled by user."));
+                bExportCancelled = true;
                 return;
             }
             SlowTask.EnterProgressFrame(1.0f, FText::FromString(FString::Printf(TEXT("正在导出原生类型: %s"), *Field->GetName())));
             ExportNativeType(Field);
+            ExportReport.AddExported(ELuaExportCategory::NativeType);
             ExportedCount++; // 增加导出计数
         }
         SlowTask.EnterProgressFrame(1.0f, FText::FromString(TEXT("正在导出UE核心类型...")));
-        ExportUETypes(NativeTypes);
+        {
+            FLuaExportReport::FScopedPhase Phase(ExportReport, TEXT("CoreTypes"));
+            FlushModuleBundles(NativeTypes);
+            ExportUETypes(NativeTypes);
+        }
         ExportedCount++; // UE核心类型也算一项
-        FString Message = FString::Printf(TEXT("Lua IntelliSense文件导出完成，共导出 %d 项！"), ExportedCount);
+        FString Message = FString::Printf(TEXT("Lua IntelliSense文件导出完成，共导出 %d 项！\n%s"), ExportedCount, *ExportReport.GetSummary());
         FLuaExportNotificationManager::ShowExportSuccess(Message);
-        UE_LOG(LogEmmyLuaIntelliSense, Log, TEXT("Full Lua export completed. Exported %d items."), ExportedCount);
+        UE_LOG(LogEmmyLuaIntelliSense, Log, TEXT("Full Lua export completed. Exported %d items, wrote %d files, %d unchanged."), ExportedCount, WrittenFileCount, UnchangedFileCount);
     }
     catch (const std::exception& e)
     {
@@ -146,8 +215,10 @@ void ULuaExportManager::ExportAll()
         UE_LOG(LogEmmyLuaIntelliSense, Error, TEXT("Full Lua export failed: %s"), UTF8_TO_TCHAR(e.what()));
     }
 }
-void ULuaExportManager::ExportIncremental()
+void ULuaExportManager::ExportIncremental(bool bInteractive)
 {
+    EMMYLUA_GAME_THREAD_SCOPE(ExportIncremental);
+    EMMYLUA_LLM_SCOPE(Plugin);
     if (!bInitialized)
     {
         UE_LOG(LogEmmyLuaIntelliSense, Warning, TEXT("LuaExportManager not initialized."));
@@ -159,34 +230,57 @@ void ULuaExportManager::ExportIncremental()
         return;
     }
     UE_LOG(LogEmmyLuaIntelliSense, Log, TEXT("Starting incremental Lua export..."));
+    // 由扫描触发时沿用扫描开始的报告
+    BeginExportReport(TEXT("Incremental"));
+    ValidateOutputSignature();
+    FEmmyLuaCodeGenerator::ResetExportCaches();
+    WrittenFileCount = 0;
+    UnchangedFileCount = 0;
+    bool bExportCancelled = false;
+    ON_SCOPE_EXIT
+    {
+        FEmmyLuaCodeGenerator::ResetExportCaches();
+        FinishExportReport(bExportCancelled);
+    };
     int32 ExportedCount = 0;
     int32 TotalTasks = PendingBlueprints.Num() + PendingNativeTypes.Num();
     if (PendingNativeTypes.Num() > 0)
     {
         TotalTasks++; 
     }
-    FScopedSlowTask SlowTask(TotalTasks, FText::FromString(TEXT("正在进行增量导出...")));
-    SlowTask.MakeDialog();
+    // 变更触发的导出在编辑过程中随时发生，不弹出模态进度框
+    FScopedSlowTask SlowTask(TotalTasks, FText::FromString(TEXT("正在进行增量导出...")), bInteractive);
+    if (bInteractive)
+    {
+        SlowTask.MakeDialog();
+    }
     for (const FString& BlueprintPath : PendingBlueprints)
     {
         if (SlowTask.ShouldCancel())
         {
             UE_LOG(LogEmmyLuaIntelliSense, Warning, TEXT("Incremental export cancelled by user."));
+            bExportCancelled = true;
             return;
         }
         FString BlueprintName = FPaths::GetBaseFilename(BlueprintPath);
         SlowTask.EnterProgressFrame(1.0f, FText::FromString(FString::Printf(TEXT("正在导出蓝图: %s"), *BlueprintName)));
-        if (UBlueprint* Blueprint = LoadObject<UBlueprint>(nullptr, *BlueprintPath))
+        if (UBlueprint* Blueprint = LoadBlueprint(BlueprintPath))
         {
             ExportBlueprint(Blueprint);
+            ExportReport.AddExported(ELuaExportCategory::Blueprint);
             ExportedCount++;
         }
+        else
+        {
+            ExportReport.AddSkipped(ELuaExportCategory::Blueprint);
+        }
     }
     for (const TWeakObjectPtr<const UField>& WeakField : PendingNativeTypes)
     {
         if (SlowTask.ShouldCancel())
         {
             UE_LOG(LogEmmyLuaIntelliSense, Warning, TEXT("Incremental export cancelled by user."));
+            bExportCancelled = true;
             return;
         }
         if (const UField* Field = WeakField.Get())
@@ -196,12 +290,18 @@ void ULuaExportManager::ExportIncremental()
             {
                 SlowTask.EnterProgressFrame(1.0f, FText::FromString(FString::Printf(TEXT("正在导出原生类型: %s"), *Field->GetName())));
                 ExportNativeType(Field);
+                ExportReport.AddExported(ELuaExportCategory::NativeType);
                 ExportedCount++;
             }
+            else
+            {
+                ExportReport.AddSkipped(ELuaExportCategory::NativeType);
+            }
         }
         else
         {
             SlowTask.EnterProgressFrame(1.0f, FText::FromString(TEXT("跳过已失效的原生类型")));
+            ExportReport.AddSkipped(ELuaExportCategory::NativeType);
         }
     }
     if (PendingNativeTypes.Num() > 0)
@@ -209,19 +309,25 @@ void ULuaExportManager::ExportIncremental()
         if (SlowTask.ShouldCancel())
         {
             UE_LOG(LogEmmyLuaIntelliSense, Warning, TEXT("Incremental export cancelled by user."));
+            bExportCancelled = true;
             return;
         }
         SlowTask.EnterProgressFrame(1.0f, FText::FromString(TEXT("正在导出UE核心类型...")));
+        FLuaExportReport::FScopedPhase Phase(ExportReport, TEXT("CoreTypes"));
         TArray<const UField*> AllNativeTypes;
         CollectNativeTypes(AllNativeTypes);
+        FlushModuleBundles(AllNativeTypes);
         ExportUETypes(AllNativeTypes);
         ExportedCount++;
     }
     SaveExportCache();
     ClearPendingChanges();
-    FString Message = FString::Printf(TEXT("增量导出完成，共导出 %d 项"), ExportedCount);
-    FLuaExportNotificationManager::ShowExportSuccess(Message);
-    UE_LOG(LogEmmyLuaIntelliSense, Log, TEXT("Incremental Lua export completed. Exported %d items."), ExportedCount);
+    if (bInteractive)
+    {
+        FString Message = FString::Printf(TEXT("增量导出完成，共导出 %d 项\n%s"), ExportedCount, *ExportReport.GetSummary());
+        FLuaExportNotificationManager::ShowExportSuccess(Message);
+    }
+    UE_LOG(LogEmmyLuaIntelliSense, Log, TEXT("Incremental Lua export completed. Exported %d items, wrote %d files, %d unchanged."), ExportedCount, WrittenFileCount, UnchangedFileCount);
 }
 bool ULuaExportManager::HasPendingChanges() const
 {
@@ -233,6 +339,368 @@ void ULuaExportManager::ClearPendingChanges()
     PendingBlueprints.Empty();
     PendingNativeTypes.Empty();
 }
+void ULuaExportManager::AddToPendingNativeTypes(const UField* Field)
+{
+    EMMYLUA_LLM_SCOPE(PendingChanges);
+    FString FieldName;
+    if (IsValidFieldForExport(Field, FieldName))
+    {
+        PendingNativeTypes.Add(Field);
+    }
+}
+void ULuaExportManager::RemoveExportedModule(const FString& ModuleName)
+{
+    const FString BundleDirectory = FPaths::GetPath(ModuleName);
+    const FString BundleName = FPaths::GetCleanFilename(ModuleName);
+    for (uint32 DialectIndex = 0; DialectIndex < static_cast<uint32>(EEmmyLuaDialect::Count); ++DialectIndex)
+    {
+        const EEmmyLuaDialect Dialect = static_cast<EEmmyLuaDialect>(DialectIndex);
+        const FString DialectDir = GetDialectOutputDir(Dialect);
+        // 按类型输出的文件
+        TArray<FString> Files;
+        ExportFile->FindFiles(Files, *FPaths::Combine(DialectDir, ModuleName), TEXT(".lua"));
+        for (const FString& File : Files)
+        {
+            DeleteFile(ModuleName, FPaths::GetBaseFilename(File), Dialect);
+        }
+        // 模块打包输出的文件及其分块
+        Files.Reset();
+        ExportFile->FindFiles(Files, *FPaths::Combine(DialectDir, BundleDirectory), TEXT(".lua"));
+        for (const FString& File : Files)
+        {
+            const FString BaseName = FPaths::GetBaseFilename(File);
+            if (BaseName == BundleName || (BaseName.StartsWith(BundleName + TEXT("_")) && BaseName.RightChop(BundleName.Len() + 1).IsNumeric()))
+            {
+                DeleteFile(BundleDirectory, BaseName, Dialect);
+            }
+        }
+    }
+    const FString TypePathPrefix = ModuleName + TEXT(".");
+    for (auto It = ExportedFilesHashCache.CreateIterator(); It; ++It)
+    {
+        if (It.Key().ToString().StartsWith(TypePathPrefix))
+        {
+            It.RemoveCurrent();
+            bExportCacheDirty = true;
+        }
+    }
+    DirtyBundleModules.Remove(ModuleName);
+    for (auto It = PendingBundleHashes.CreateIterator(); It; ++It)
+    {
+        if (It.Key().ToString().StartsWith(TypePathPrefix))
+        {
+            It.RemoveCurrent();
+        }
+    }
+    SaveExportCache();
+    UE_LOG(LogEmmyLuaIntelliSense, Log, TEXT("[EXPORT] Removed exported files for module: %s"), *ModuleName);
+}
+
+void ULuaExportManager::RemoveExportedBlueprint(const FString& AssetPath)
+{
+    const FString FileName = GetBlueprintFileName(AssetPath, FindObject<UBlueprint>(nullptr, *AssetPath));
+    for (uint32 DialectIndex = 0; DialectIndex < static_cast<uint32>(EEmmyLuaDialect::Count); ++DialectIndex)
+    {
+        DeleteFile(TEXT("/Game"), FileName, static_cast<EEmmyLuaDialect>(DialectIndex));
+    }
+    PendingBlueprints.Remove(AssetPath);
+    if (ExportedFilesHashCache.Remove(FName(*AssetPath)) > 0)
+    {
+        bExportCacheDirty = true;
+    }
+    UE_LOG(LogEmmyLuaIntelliSense, Log, TEXT("[EXPORT] Removed exported files for blueprint: %s"), *AssetPath);
+}
+
+void ULuaExportManager::HandleChangeEvent(const FLuaChangeEvent& Event)
+{
+    EMMYLUA_LLM_SCOPE(PendingChanges);
+    ChangeRecorder.Record(Event);
+    UE_LOG(LogEmmyLuaIntelliSense, Verbose, TEXT("[CHANGE] %s %s"), FLuaChangeEvent::GetTypeName(Event.Type), *Event.Path);
+    const double Now = FPlatformTime::Seconds();
+    if (CoalescedChanges.Num() == 0)
+    {
+        FirstChangeTime = Now;
+    }
+    LastChangeTime = Now;
+    ++CoalescedEventCount;
+    if (FLuaChangeEvent* Existing = CoalescedChanges.Find(Event.Path))
+    {
+        // 编译事件绕过文件哈希强制导出，之后的保存不能把它降级
+        const bool bKeepCompiled = Existing->Type == ELuaChangeEventType::BlueprintCompiled
+            && (Event.Type == ELuaChangeEventType::AssetUpdated || Event.Type == ELuaChangeEventType::AssetAdded);
+        if (!bKeepCompiled)
+        {
+            Existing->Type = Event.Type;
+        }
+        // 重命名的原路径要保留下来，合并后仍需删除原路径的导出文件
+        if (Existing->OldPath.IsEmpty())
+        {
+            Existing->OldPath = Event.OldPath;
+        }
+    }
+    else
+    {
+        CoalescedChanges.Add(Event.Path, Event);
+    }
+    if (!CoalesceTickerHandle.IsValid())
+    {
+        CoalesceTickerHandle = FTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateUObject(this, &ULuaExportManager::TickChangeCoalescing), 0.1f);
+    }
+}
+
+bool ULuaExportManager::TickChangeCoalescing(float DeltaTime)
+{
+    const UEmmyLuaIntelliSenseSettings* Settings = UEmmyLuaIntelliSenseSettings::Get();
+    const double Now = FPlatformTime::Seconds();
+    const bool bQuiet = Now - LastChangeTime >= (Settings ? Settings->ChangeQuiescenceSeconds : 1.0f);
+    const bool bOverdue = Now - FirstChangeTime >= (Settings ? Settings->ChangeMaxDelaySeconds : 10.0f);
+    if (!bQuiet && !bOverdue)
+    {
+        return true;
+    }
+    // 扫描、分帧导出或上一批导出进行中时等它结束，避免与其结果交错
+    if (bIsAsyncScanningInProgress || bIsFramedProcessingInProgress || bIsFlushingChanges)
+    {
+        return true;
+    }
+    CoalesceTickerHandle.Reset();
+    FlushChangeEvents(!Settings || Settings->bAutoExportOnChange);
+    return false;
+}
+
+void ULuaExportManager::FlushChangeEvents(bool bExport)
+{
+    EMMYLUA_GAME_THREAD_SCOPE(ChangeFlush);
+    if (bIsFlushingChanges)
+    {
+        return;
+    }
+    if (CoalesceTickerHandle.IsValid())
+    {
+        FTicker::GetCoreTicker().RemoveTicker(CoalesceTickerHandle);
+        CoalesceTickerHandle.Reset();
+    }
+    if (CoalescedChanges.Num() == 0)
+    {
+        return;
+    }
+    TGuardValue<bool> FlushingGuard(bIsFlushingChanges, true);
+    TMap<FString, FLuaChangeEvent> Changes = MoveTemp(CoalescedChanges);
+    CoalescedChanges.Reset();
+    const int32 EventCount = CoalescedEventCount;
+    CoalescedEventCount = 0;
+    for (const TPair<FString, FLuaChangeEvent>& Change : Changes)
+    {
+        ApplyChangeEvent(Change.Value);
+    }
+    ++ChangeBatchStats.Batches;
+    ChangeBatchStats.Events += EventCount;
+    ChangeBatchStats.Changes += Changes.Num();
+    UE_LOG(LogEmmyLuaIntelliSense, Log, TEXT("[CHANGE] Coalesced %d events into %d changes over %.2fs"),
+        EventCount, Changes.Num(), LastChangeTime - FirstChangeTime);
+    if (!bExport || !HasPendingChanges())
+    {
+        return;
+    }
+    // 整批只做一次增量导出：UE.lua重建一次，缓存提交一次
+    const double StartTime = FPlatformTime::Seconds();
+    ExportIncremental(false);
+    const double Seconds = FPlatformTime::Seconds() - StartTime;
+    ++ChangeBatchStats.Exports;
+    ChangeBatchStats.ExportSeconds += Seconds;
+    ChangeBatchStats.MaxExportSeconds = FMath::Max(ChangeBatchStats.MaxExportSeconds, Seconds);
+}
+
+void ULuaExportManager::ApplyChangeEvent(const FLuaChangeEvent& Event)
+{
+    EMMYLUA_LLM_SCOPE(PendingChanges);
+    IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry")).Get();
+    if (!Event.OldPath.IsEmpty())
+    {
+        RemoveExportedBlueprint(Event.OldPath);
+    }
+    switch (Event.Type)
+    {
+    case ELuaChangeEventType::AssetAdded:
+    case ELuaChangeEventType::AssetUpdated:
+    case ELuaChangeEventType::AssetRenamed:
+        {
+            const FAssetData AssetData = AssetRegistry.GetAssetByObjectPath(FName(*Event.Path));
+            if (AssetData.IsValid())
+            {
+                AddToPendingBlueprints(AssetData);
+            }
+        }
+        break;
+    case ELuaChangeEventType::AssetRemoved:
+        RemoveExportedBlueprint(Event.Path);
+        break;
+    case ELuaChangeEventType::BlueprintCompiled:
+        {
+            // 编译后未保存时资源文件不变，文件哈希判断不出变化，直接加入待导出列表
+            const FAssetData AssetData = AssetRegistry.GetAssetByObjectPath(FName(*Event.Path));
+            if (AssetData.IsValid() && ShouldExportBlueprint(AssetData))
+            {
+                PendingBlueprints.Add(Event.Path);
+            }
+        }
+        break;
+    case ELuaChangeEventType::ModuleLoaded:
+        if (UPackage* Package = FindPackage(nullptr, *Event.Path))
+        {
+            // 与全量扫描使用同一过滤规则，包中的委托签名函数等不会进入待导出列表
+            TArray<UObject*> Objects;
+            GetObjectsWithOuter(Package, Objects, false);
+            for (const UObject* Object : Objects)
+            {
+                const UField* Field = Cast<UField>(Object);
+                if (Field && IsExportableNativeType(Field))
+                {
+                    AddToPendingNativeTypes(Field);
+                }
+            }
+        }
+        break;
+    case ELuaChangeEventType::ModuleUnloaded:
+        {
+            // 运行时卸载（热重载、禁用插件）后模块通常会再次加载，已导出的文件保留，只丢弃尚未导出的类型
+            const FString PackagePrefix = Event.Path + TEXT(".");
+            for (auto It = PendingNativeTypes.CreateIterator(); It; ++It)
+            {
+                if (!It->IsValid() || (*It)->GetPathName().StartsWith(PackagePrefix))
+                {
+                    It.RemoveCurrent();
+                }
+            }
+        }
+        break;
+    default:
+        break;
+    }
+}
+
+void ULuaExportManager::RegisterChangeEvents()
+{
+    // commandlet中没有交互编辑，不监听变更
+    if (IsRunningCommandlet())
+    {
+        return;
+    }
+    IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry")).Get();
+    AssetAddedHandle = AssetRegistry.OnAssetAdded().AddUObject(this, &ULuaExportManager::OnAssetAdded);
+    AssetRemovedHandle = AssetRegistry.OnAssetRemoved().AddUObject(this, &ULuaExportManager::OnAssetRemoved);
+    AssetRenamedHandle = AssetRegistry.OnAssetRenamed().AddUObject(this, &ULuaExportManager::OnAssetRenamed);
+    AssetUpdatedHandle = AssetRegistry.OnAssetUpdated().AddUObject(this, &ULuaExportManager::OnAssetUpdated);
+    if (GEditor)
+    {
+        BlueprintPreCompileHandle = GEditor->OnBlueprintPreCompile().AddUObject(this, &ULuaExportManager::OnBlueprintPreCompile);
+        BlueprintCompiledHandle = GEditor->OnBlueprintCompiled().AddUObject(this, &ULuaExportManager::OnBlueprintCompiled);
+    }
+    ModulesChangedHandle = FModuleManager::Get().OnModulesChanged().AddUObject(this, &ULuaExportManager::OnModulesChanged);
+}
+void ULuaExportManager::UnregisterChangeEvents()
+{
+    if (FAssetRegistryModule* AssetRegistryModule = FModuleManager::GetModulePtr<FAssetRegistryModule>(TEXT("AssetRegistry")))
+    {
+        IAssetRegistry& AssetRegistry = AssetRegistryModule->Get();
+        AssetRegistry.OnAssetAdded().Remove(AssetAddedHandle);
+        AssetRegistry.OnAssetRemoved().Remove(AssetRemovedHandle);
+        AssetRegistry.OnAssetRenamed().Remove(AssetRenamedHandle);
+        AssetRegistry.OnAssetUpdated().Remove(AssetUpdatedHandle);
+    }
+    if (GEditor)
+    {
+        GEditor->OnBlueprintPreCompile().Remove(BlueprintPreCompileHandle);
+        GEditor->OnBlueprintCompiled().Remove(BlueprintCompiledHandle);
+    }
+    FModuleManager::Get().OnModulesChanged().Remove(ModulesChangedHandle);
+    CompilingBlueprints.Empty();
+}
+bool ULuaExportManager::IsWatchingChanges() const
+{
+    const UEmmyLuaIntelliSenseSettings* Settings = UEmmyLuaIntelliSenseSettings::Get();
+    return ChangeRecorder.IsRecording() || (Settings && Settings->bWatchEditorChanges);
+}
+bool ULuaExportManager::IsDiscoveringAssets() const
+{
+    // 启动时资产注册表发现已有资产、加载插件模块也会触发回调，这部分由启动扫描统一处理
+    return !bInitialized || FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry")).Get().IsLoadingAssets();
+}
+void ULuaExportManager::OnAssetAdded(const FAssetData& AssetData)
+{
+    if (!IsBlueprint(AssetData))
+    {
+        return;
+    }
+    if (IsDiscoveringAssets())
+    {
+        // 发现阶段不产生变更事件，但可以趁注册表还在发现时在后台先算好指纹，扫描时直接使用
+        QueueFingerprintPrefetch(AssetData);
+        return;
+    }
+    if (!IsWatchingChanges())
+    {
+        return;
+    }
+    HandleChangeEvent(FLuaChangeEvent(ELuaChangeEventType::AssetAdded, AssetData.ObjectPath.ToString()));
+}
+void ULuaExportManager::OnAssetRemoved(const FAssetData& AssetData)
+{
+    if (IsBlueprint(AssetData) && !IsDiscoveringAssets() && IsWatchingChanges())
+    {
+        HandleChangeEvent(FLuaChangeEvent(ELuaChangeEventType::AssetRemoved, AssetData.ObjectPath.ToString()));
+    }
+}
+void ULuaExportManager::OnAssetRenamed(const FAssetData& AssetData, const FString& OldObjectPath)
+{
+    if (IsBlueprint(AssetData) && !IsDiscoveringAssets() && IsWatchingChanges())
+    {
+        HandleChangeEvent(FLuaChangeEvent(ELuaChangeEventType::AssetRenamed, AssetData.ObjectPath.ToString(), OldObjectPath));
+    }
+}
+void ULuaExportManager::OnAssetUpdated(const FAssetData& AssetData)
+{
+    if (IsBlueprint(AssetData) && !IsDiscoveringAssets() && IsWatchingChanges())
+    {
+        HandleChangeEvent(FLuaChangeEvent(ELuaChangeEventType::AssetUpdated, AssetData.ObjectPath.ToString()));
+    }
+}
+void ULuaExportManager::OnBlueprintPreCompile(UBlueprint* Blueprint)
+{
+    if (Blueprint && !IsDiscoveringAssets() && IsWatchingChanges())
+    {
+        CompilingBlueprints.Add(Blueprint);
+    }
+}
+void ULuaExportManager::OnBlueprintCompiled()
+{
+    // 一次编译可能包含多个蓝图（依赖重编译），编译完成后逐个转为事件
+    TSet<TWeakObjectPtr<UBlueprint>> Compiled = MoveTemp(CompilingBlueprints);
+    CompilingBlueprints.Reset();
+    for (const TWeakObjectPtr<UBlueprint>& Blueprint : Compiled)
+    {
+        if (Blueprint.IsValid() && !Blueprint->HasAnyFlags(RF_Transient) && Blueprint->GetOutermost() != GetTransientPackage())
+        {
+            HandleChangeEvent(FLuaChangeEvent(ELuaChangeEventType::BlueprintCompiled, Blueprint->GetPathName()));
+        }
+    }
+}
+void ULuaExportManager::OnModulesChanged(FName ModuleName, EModuleChangeReason Reason)
+{
+    if (IsDiscoveringAssets() || IsEngineExitRequested() || !IsWatchingChanges())
+    {
+        return;
+    }
+    const FString ModulePath = FString(TEXT("/Script/")) + ModuleName.ToString();
+    if (Reason == EModuleChangeReason::ModuleLoaded)
+    {
+        HandleChangeEvent(FLuaChangeEvent(ELuaChangeEventType::ModuleLoaded, ModulePath));
+    }
+    else if (Reason == EModuleChangeReason::ModuleUnloaded)
+    {
+        HandleChangeEvent(FLuaChangeEvent(ELuaChangeEventType::ModuleUnloaded, ModulePath));
+    }
+}
 
 int32 ULuaExportManager::GetPendingFilesCount() const
 {
@@ -259,6 +727,7 @@ int32 ULuaExportManager::GetPendingCoreFilesCount() const
 }
 bool ULuaExportManager::AddToPendingBlueprints(const FAssetData& AssetData)
 {
+    EMMYLUA_LLM_SCOPE(PendingChanges);
     if (!ShouldExportBlueprint(AssetData))
     {
         return false;
@@ -284,7 +753,7 @@ bool ULuaExportManager::AddToPendingBlueprints(const FAssetData& AssetData)
     {
         return false;
     }
-    if (!FPaths::FileExists(AssetFilePath))
+    if (!ExportFile->FileExists(*AssetFilePath))
     {
         return false;
     }
@@ -297,72 +766,99 @@ bool ULuaExportManager::AddToPendingBlueprints(const FAssetData& AssetData)
 }
 void ULuaExportManager::ExportBlueprint(const UBlueprint* Blueprint)
 {
+    EMMYLUA_LLM_SCOPE(GeneratedCode);
 	if (!Blueprint || !Blueprint->GeneratedClass)
 	{
 		return;
 	}
 	FString BlueprintPath = Blueprint->GetPathName();
-	FString LuaCode = FEmmyLuaCodeGenerator::GenerateBlueprint(Blueprint);
-	if (!LuaCode.IsEmpty())
+	const double StartTime = FPlatformTime::Seconds();
+	ON_SCOPE_EXIT
 	{
-		FString FileName = FEmmyLuaCodeGenerator::GetTypeName(Blueprint->GeneratedClass);
-		if (FileName.EndsWith(TEXT("_C")))
+		ExportReport.RecordTypeCost(BlueprintPath, FPlatformTime::Seconds() - StartTime);
+	};
+	const UEmmyLuaIntelliSenseSettings* Settings = UEmmyLuaIntelliSenseSettings::Get();
+	const uint32 DialectMask = Settings ? Settings->GetEnabledDialectMask() : 1u;
+	FLuaDialectCode DialectCode;
+	bool bGenerated = false;
+	{
+		FLuaExportReport::FScopedPhase Phase(ExportReport, TEXT("Generate"));
+		bGenerated = FEmmyLuaCodeGenerator::GenerateType(Blueprint, DialectMask, true, DialectCode);
+	}
+	if (bGenerated)
+	{
+		const FString FileName = GetBlueprintFileName(BlueprintPath, Blueprint);
+		for (uint32 DialectIndex = 0; DialectIndex < static_cast<uint32>(EEmmyLuaDialect::Count); ++DialectIndex)
 		{
-			FileName.LeftChopInline(2);
+			if (!DialectCode[DialectIndex].IsEmpty())
+			{
+				SaveFile(TEXT("/Game"), FileName, DialectCode[DialectIndex], static_cast<EEmmyLuaDialect>(DialectIndex));
+			}
 		}
-		SaveFile(TEXT("/Game"), FileName, LuaCode);
 		UE_LOG(LogEmmyLuaIntelliSense, Log, TEXT("[EXPORT] Blueprint exported successfully: %s -> %s.lua"), *BlueprintPath, *FileName);
-		FString BlueprintHash = GetAssetHash(BlueprintPath);
-		UpdateExportCacheByHash(BlueprintPath, BlueprintHash);
-		UE_LOG(LogEmmyLuaIntelliSense, Log, TEXT("[EXPORT] Updated cache for Blueprint: %s with hash: %s"), *BlueprintPath, *BlueprintHash);
+		const FSHAHash BlueprintHash = GetAssetHash(BlueprintPath);
+		UpdateExportCacheByHash(FName(*BlueprintPath), BlueprintHash);
+		UE_LOG(LogEmmyLuaIntelliSense, Log, TEXT("[EXPORT] Updated cache for Blueprint: %s with hash: %s"), *BlueprintPath, *BlueprintHash.ToString());
 	}
 	else
 	{
 		UE_LOG(LogEmmyLuaIntelliSense, Warning, TEXT("[EXPORT] Failed to generate Lua code for Blueprint: %s"), *BlueprintPath);
 	}
 }
+
+FString ULuaExportManager::GetBlueprintFileName(const FString& BlueprintPath, const UBlueprint* Blueprint)
+{
+    // 资源已删除或未加载时没有生成类，非原生生成类的类型名就是对象名<资源名>_C，由资源路径推出同样的名字
+    FString FileName = Blueprint && Blueprint->GeneratedClass
+        ? FEmmyLuaCodeGenerator::GetTypeName(Blueprint->GeneratedClass)
+        : FPackageName::ObjectPathToObjectName(BlueprintPath) + TEXT("_C");
+    FileName.RemoveFromEnd(TEXT("_C"));
+    return FileName;
+}
+
 void ULuaExportManager::ExportNativeType(const UField* Field)
 {
+    EMMYLUA_LLM_SCOPE(GeneratedCode);
     FString FieldName;
     if (!IsValidFieldForExport(Field, FieldName))
     {
         return;
     }
     FString NativeTypePath = Field->GetPathName();
-    FString LuaCode;
-    if (const UClass* Class = Cast<UClass>(Field))
-    {
-        if (IsValid(Class))
-        {
-            LuaCode = FEmmyLuaCodeGenerator::GenerateClass(Class);
-        }
-    }
-    else if (const UScriptStruct* Struct = Cast<UScriptStruct>(Field))
+    const UPackage* Package = Field->GetPackage();
+    FString ModuleName = Package ? Package->GetName() : TEXT("");
+    const UEmmyLuaIntelliSenseSettings* Settings = UEmmyLuaIntelliSenseSettings::Get();
+    if (Settings && Settings->OutputLayout == EEmmyLuaOutputLayout::PerModule && !ModuleName.IsEmpty())
     {
-        if (IsValid(Struct))
-        {
-            LuaCode = FEmmyLuaCodeGenerator::GenerateStruct(Struct);
-        }
+        // 模块打包模式：只标记模块，导出结束时统一打包
+        // 哈希在模块写入后才更新到导出缓存，打包前中断时下次仍会重新导出
+        DirtyBundleModules.Add(ModuleName);
+        PendingBundleHashes.Add(FName(*NativeTypePath), GetCachedFieldHash(Field));
+        UE_LOG(LogEmmyLuaIntelliSense, Log, TEXT("[EXPORT] Native Type queued for module bundle: %s -> %s"), *NativeTypePath, *ModuleName);
+        return;
     }
-    else if (const UEnum* Enum = Cast<UEnum>(Field))
+    const double StartTime = FPlatformTime::Seconds();
+    ON_SCOPE_EXIT
     {
-        if (IsValid(Enum))
-        {
-            LuaCode = FEmmyLuaCodeGenerator::GenerateEnum(Enum);
-        }
-    }
-    if (!LuaCode.IsEmpty())
+        ExportReport.RecordTypeCost(NativeTypePath, FPlatformTime::Seconds() - StartTime);
+    };
+    FLuaDialectCode DialectCode;
+    if (GenerateNativeTypeCode(Field, true, DialectCode))
     {
-        const UPackage* Package = Field->GetPackage();
-        FString ModuleName = Package ? Package->GetName() : TEXT("");
         FString FileName = FEmmyLuaCodeGenerator::GetTypeName(Field);
         if (!FileName.IsEmpty() && FileName != TEXT("Error") && FileName != TEXT("Invalid"))
         {
-            SaveFile(ModuleName, FileName, LuaCode);
+            for (uint32 DialectIndex = 0; DialectIndex < static_cast<uint32>(EEmmyLuaDialect::Count); ++DialectIndex)
+            {
+                if (!DialectCode[DialectIndex].IsEmpty())
+                {
+                    SaveFile(ModuleName, FileName, DialectCode[DialectIndex], static_cast<EEmmyLuaDialect>(DialectIndex));
+                }
+            }
             UE_LOG(LogEmmyLuaIntelliSense, Log, TEXT("[EXPORT] Native Type exported successfully: %s -> %s/%s.lua"), *NativeTypePath, *ModuleName, *FileName);
-            FString FieldHash = GetCachedFieldHash(Field);
-            UpdateExportCacheByHash(NativeTypePath, FieldHash);
-            UE_LOG(LogEmmyLuaIntelliSense, Log, TEXT("[EXPORT] Updated cache for Native Type: %s with hash: %s"), *NativeTypePath, *FieldHash);
+            const FSHAHash FieldHash = GetCachedFieldHash(Field);
+            UpdateExportCacheByHash(FName(*NativeTypePath), FieldHash);
+            UE_LOG(LogEmmyLuaIntelliSense, Log, TEXT("[EXPORT] Updated cache for Native Type: %s with hash: %s"), *NativeTypePath, *FieldHash.ToString());
         }
         else
         {
@@ -376,102 +872,262 @@ void ULuaExportManager::ExportNativeType(const UField* Field)
 }
 void ULuaExportManager::ExportUETypes(const TArray<const UField*>& Types)
 {
+    EMMYLUA_SCOPE_CYCLE_COUNTER(RebuildUETable);
+    const UEmmyLuaIntelliSenseSettings* Settings = UEmmyLuaIntelliSenseSettings::Get();
+    const uint32 DialectMask = Settings ? Settings->GetEnabledDialectMask() : 1u;
     FString UELuaCode = FEmmyLuaCodeGenerator::GenerateUETable(Types);
-    if (!UELuaCode.IsEmpty())
-    {
-        SaveFile(TEXT(""), TEXT("UE"), UELuaCode);
-    }
     FString UE4LuaCode = TEXT("---@type UE\r\nUE4 = UE\r\n");
-    SaveFile(TEXT(""), TEXT("UE4"), UE4LuaCode);
     FString UnLuaCode = GenerateUnLuaDefinitions();
-    if (!UnLuaCode.IsEmpty())
+    // UE表和库文件在各方言中通用，每个输出目录各写一份
+    for (uint32 DialectIndex = 0; DialectIndex < static_cast<uint32>(EEmmyLuaDialect::Count); ++DialectIndex)
     {
-        SaveFile(TEXT(""), TEXT("UnLua"), UnLuaCode);
+        if (!(DialectMask & (1u << DialectIndex)))
+        {
+            continue;
+        }
+        const EEmmyLuaDialect Dialect = static_cast<EEmmyLuaDialect>(DialectIndex);
+        if (!UELuaCode.IsEmpty())
+        {
+            SaveFile(TEXT(""), TEXT("UE"), UELuaCode, Dialect);
+        }
+        SaveFile(TEXT(""), TEXT("UE4"), UE4LuaCode, Dialect);
+        if (!UnLuaCode.IsEmpty())
+        {
+            SaveFile(TEXT(""), TEXT("UnLua"), UnLuaCode, Dialect);
+        }
+        CopyUELibFolder(GetDialectOutputDir(Dialect));
     }
-    CopyUELibFolder();
 }
 void ULuaExportManager::CollectNativeTypes(TArray<const UField*>& Types)
 {
+    EMMYLUA_LLM_SCOPE(ScanResults);
+    EMMYLUA_SCOPE_CYCLE_COUNTER(CollectNativeTypes);
+    FLuaExportReport::FScopedPhase Phase(ExportReport, TEXT("CollectNativeTypes"));
     Types.Empty();
     for (TObjectIterator<UClass> It; It; ++It)
     {
-        const UClass* Class = *It;
-        FString ClassName;
-        if (!IsValidFieldForExport(Class, ClassName))
+        if (IsExportableNativeType(*It))
         {
-            continue;
+            Types.Add(*It);
         }
-        if (!Class->HasAnyClassFlags(CLASS_Native))
+    }
+    for (TObjectIterator<UScriptStruct> It; It; ++It)
+    {
+        if (IsExportableNativeType(*It))
         {
-            continue;
+            Types.Add(*It);
+        }
+    }
+    for (TObjectIterator<UEnum> It; It; ++It)
+    {
+        if (IsExportableNativeType(*It))
+        {
+            Types.Add(*It);
+        }
+    }
+    // 按路径排序，保证输出顺序不依赖对象加载顺序
+    TArray<TPair<FString, const UField*>> SortedTypes;
+    SortedTypes.Reserve(Types.Num());
+    for (const UField* Field : Types)
+    {
+        SortedTypes.Emplace(Field->GetPathName(), Field);
+    }
+    SortedTypes.Sort([](const TPair<FString, const UField*>& A, const TPair<FString, const UField*>& B)
+    {
+        return A.Key.Compare(B.Key, ESearchCase::CaseSensitive) < 0;
+    });
+    for (int32 Index = 0; Index < SortedTypes.Num(); ++Index)
+    {
+        Types[Index] = SortedTypes[Index].Value;
+    }
+    UE_LOG(LogEmmyLuaIntelliSense, Log, TEXT("CollectNativeTypes: Collected %d valid types"), Types.Num());
+}
+bool ULuaExportManager::IsExportableNativeType(const UField* Field) const
+{
+    FString FieldName;
+    if (!IsValidFieldForExport(Field, FieldName))
+    {
+        return false;
+    }
+    const bool bSynthetic = SyntheticTypePackages.Num() > 0 && SyntheticTypePackages.Contains(Field->GetOutermost()->GetFName());
+    if (const UClass* Class = Cast<UClass>(Field))
+    {
+        if (!Class->HasAnyClassFlags(CLASS_Native) && !bSynthetic)
+        {
+            return false;
+        }
+    }
+    else if (Cast<UScriptStruct>(Field) || Cast<UEnum>(Field))
+    {
+        if (!Field->IsNative() && !bSynthetic)
+        {
+            return false;
         }
-        if (ClassName.StartsWith(TEXT("SKEL_")) || 
-            ClassName.StartsWith(TEXT("REINST_")) ||
-            ClassName.StartsWith(TEXT("TRASHCLASS_")) ||
-            ClassName.StartsWith(TEXT("HOTRELOADED_")) ||
-            ClassName.StartsWith(TEXT("PLACEHOLDER_")))
+    }
+    else
+    {
+        // 委托签名等UFunction不作为独立类型导出
+        return false;
+    }
+    if (FieldName.StartsWith(TEXT("SKEL_")) || 
+        FieldName.StartsWith(TEXT("REINST_")) ||
+        FieldName.StartsWith(TEXT("TRASHCLASS_")) ||
+        FieldName.StartsWith(TEXT("HOTRELOADED_")) ||
+        FieldName.StartsWith(TEXT("PLACEHOLDER_")))
+    {
+        return false;
+    }
+    return !FEmmyLuaCodeGenerator::ShouldSkipType(Field);
+}
+bool ULuaExportManager::GenerateNativeTypeCode(const UField* Field, bool bEmitReturn, FLuaDialectCode& OutCode) const
+{
+    EMMYLUA_LLM_SCOPE(GeneratedCode);
+    FLuaExportReport::FScopedPhase Phase(ExportReport, TEXT("Generate"));
+    const UEmmyLuaIntelliSenseSettings* Settings = UEmmyLuaIntelliSenseSettings::Get();
+    const uint32 DialectMask = Settings ? Settings->GetEnabledDialectMask() : 1u;
+    return FEmmyLuaCodeGenerator::GenerateType(Field, DialectMask, bEmitReturn, OutCode);
+}
+void ULuaExportManager::FlushModuleBundles(const TArray<const UField*>& AllNativeTypes)
+{
+    EMMYLUA_SCOPE_CYCLE_COUNTER(ModuleBundles);
+    if (DirtyBundleModules.Num() == 0)
+    {
+        return;
+    }
+    TMap<FString, TArray<const UField*>> TypesByModule;
+    for (const UField* Field : AllNativeTypes)
+    {
+        const UPackage* Package = Field ? Field->GetPackage() : nullptr;
+        if (Package && DirtyBundleModules.Contains(Package->GetName()))
+        {
+            TypesByModule.FindOrAdd(Package->GetName()).Add(Field);
+        }
+    }
+    for (const FString& ModuleName : DirtyBundleModules)
+    {
+        const TArray<const UField*>* ModuleTypes = TypesByModule.Find(ModuleName);
+        SaveModuleBundle(ModuleName, ModuleTypes ? *ModuleTypes : TArray<const UField*>());
+    }
+    UE_LOG(LogEmmyLuaIntelliSense, Log, TEXT("[BUNDLE] Rebuilt %d module bundles"), DirtyBundleModules.Num());
+    DirtyBundleModules.Empty();
+    PendingBundleHashes.Empty();
+}
+void ULuaExportManager::SaveModuleBundle(const FString& ModuleName, const TArray<const UField*>& ModuleTypes)
+{
+    EMMYLUA_LLM_SCOPE(GeneratedCode);
+    const UEmmyLuaIntelliSenseSettings* Settings = UEmmyLuaIntelliSenseSettings::Get();
+    const uint32 DialectMask = Settings ? Settings->GetEnabledDialectMask() : 1u;
+    // 按字符数近似字节数（生成内容基本为ASCII）
+    const int64 MaxChunkLength = Settings && Settings->MaxBundleSizeKB > 0 ? (int64)Settings->MaxBundleSizeKB * 1024 : MAX_int64;
+    const FString BundleDirectory = FPaths::GetPath(ModuleName);
+    const FString BundleName = FPaths::GetCleanFilename(ModuleName);
+    constexpr uint32 DialectCount = static_cast<uint32>(EEmmyLuaDialect::Count);
+
+    /** 一个类型的输出块，ChunkKey由类型名计算，与其他类型的大小无关 */
+    struct FBundleBlock
+    {
+        uint32  ChunkKey;
+        FString Code;
+    };
+    TStaticArray<TArray<FBundleBlock>, DialectCount> Blocks;
+    TStaticArray<int64, DialectCount> TotalLengths;
+    for (uint32 DialectIndex = 0; DialectIndex < DialectCount; ++DialectIndex)
+    {
+        TotalLengths[DialectIndex] = 0;
+    }
+    TArray<const UField*> GeneratedTypes;
+    FLuaDialectCode DialectCode;
+    for (const UField* Field : ModuleTypes)
+    {
+        // 每个类型只遍历一次，所有方言的渲染结果分别收集
+        const double StartTime = FPlatformTime::Seconds();
+        const bool bGenerated = GenerateNativeTypeCode(Field, false, DialectCode);
+        ExportReport.RecordTypeCost(Field->GetPathName(), FPlatformTime::Seconds() - StartTime);
+        if (!bGenerated)
         {
             continue;
         }
-        if (FEmmyLuaCodeGenerator::ShouldSkipType(Class))
+        GeneratedTypes.Add(Field);
+        const uint32 ChunkKey = FCrc::StrCrc32(*Field->GetName());
+        for (uint32 DialectIndex = 0; DialectIndex < DialectCount; ++DialectIndex)
         {
-            continue;
+            if (DialectCode[DialectIndex].IsEmpty())
+            {
+                continue;
+            }
+            // 每个类型放在独立的do块中，避免模块内的local数量超过Lua的限制
+            FBundleBlock& Block = Blocks[DialectIndex].AddDefaulted_GetRef();
+            Block.ChunkKey = ChunkKey;
+            Block.Code = FString::Printf(TEXT("do\n%send\n\n"), *DialectCode[DialectIndex]);
+            TotalLengths[DialectIndex] += Block.Code.Len();
         }
-        Types.Add(Class);
     }
-    for (TObjectIterator<UScriptStruct> It; It; ++It)
+    int32 WrittenChunkCount = 0;
+    for (uint32 DialectIndex = 0; DialectIndex < DialectCount; ++DialectIndex)
     {
-        const UScriptStruct* Struct = *It;
-        FString StructName;
-        if (!IsValidFieldForExport(Struct, StructName))
+        if (!(DialectMask & (1u << DialectIndex)))
         {
             continue;
         }
-        if (!Struct->IsNative())
+        const EEmmyLuaDialect Dialect = static_cast<EEmmyLuaDialect>(DialectIndex);
+        const TArray<FBundleBlock>& DialectBlocks = Blocks[DialectIndex];
+        // 类型按名称哈希固定分配到块中，某个类型变化只改变它所在的块，其余块内容不变，SaveFile不会重写。
+        // 块数取2的幂并保留一半余量（哈希分配不均匀），只有模块总大小翻倍时才变化
+        int32 ChunkCount = DialectBlocks.Num() > 0 ? 1 : 0;
+        while (ChunkCount > 0 && ChunkCount < DialectBlocks.Num() && (int64)ChunkCount * MaxChunkLength < TotalLengths[DialectIndex] * 2)
         {
-            continue;
+            ChunkCount *= 2;
         }
-        if (StructName.StartsWith(TEXT("SKEL_")) || 
-            StructName.StartsWith(TEXT("REINST_")) ||
-            StructName.StartsWith(TEXT("TRASHCLASS_")) ||
-            StructName.StartsWith(TEXT("HOTRELOADED_")) ||
-            StructName.StartsWith(TEXT("PLACEHOLDER_")))
+        TArray<FString> DialectChunks;
+        DialectChunks.SetNum(ChunkCount);
+        for (FString& Chunk : DialectChunks)
         {
-            continue;
+            Chunk = FEmmyLuaCodeGenerator::GetFilePrologue(Dialect);
         }
-        if (FEmmyLuaCodeGenerator::ShouldSkipType(Struct))
+        for (const FBundleBlock& Block : DialectBlocks)
         {
-            continue;
+            DialectChunks[Block.ChunkKey % (uint32)ChunkCount] += Block.Code;
         }
-        Types.Add(Struct);
-    }
-    for (TObjectIterator<UEnum> It; It; ++It)
-    {
-        const UEnum* Enum = *It;
-        FString EnumName;
-        if (!IsValidFieldForExport(Enum, EnumName))
+        // 空块也写出，块编号保持连续，残留旧块的清理按编号进行
+        for (int32 ChunkIndex = 0; ChunkIndex < DialectChunks.Num(); ++ChunkIndex)
         {
-            continue;
+            const FString ChunkName = ChunkIndex == 0 ? BundleName : FString::Printf(TEXT("%s_%d"), *BundleName, ChunkIndex);
+            SaveFile(BundleDirectory, ChunkName, DialectChunks[ChunkIndex], Dialect);
         }
-        if (!Enum->IsNative())
+        WrittenChunkCount = FMath::Max(WrittenChunkCount, DialectChunks.Num());
+        // 删除块数减少后残留的旧块
+        if (DialectChunks.Num() == 0)
         {
-            continue;
+            DeleteFile(BundleDirectory, BundleName, Dialect);
         }
-        if (EnumName.StartsWith(TEXT("SKEL_")) || 
-            EnumName.StartsWith(TEXT("REINST_")) ||
-            EnumName.StartsWith(TEXT("TRASHCLASS_")) ||
-            EnumName.StartsWith(TEXT("HOTRELOADED_")) ||
-            EnumName.StartsWith(TEXT("PLACEHOLDER_")))
+        for (int32 ChunkIndex = FMath::Max(DialectChunks.Num(), 1); ; ++ChunkIndex)
         {
-            continue;
+            const FString ChunkName = FString::Printf(TEXT("%s_%d"), *BundleName, ChunkIndex);
+            if (!ExportFile->FileExists(*FPaths::Combine(GetDialectOutputDir(Dialect), BundleDirectory, ChunkName + TEXT(".lua"))))
+            {
+                break;
+            }
+            DeleteFile(BundleDirectory, ChunkName, Dialect);
         }
-        if (FEmmyLuaCodeGenerator::ShouldSkipType(Enum))
+    }
+    // 模块已写入，更新本轮排队打包的类型的导出缓存
+    for (const UField* Field : GeneratedTypes)
+    {
+        const FName TypePath(*Field->GetPathName());
+        if (const FSHAHash* Hash = PendingBundleHashes.Find(TypePath))
         {
-            continue;
+            UpdateExportCacheByHash(TypePath, *Hash);
         }
-        Types.Add(Enum);
     }
-    UE_LOG(LogEmmyLuaIntelliSense, Log, TEXT("CollectNativeTypes: Collected %d valid types"), Types.Num());
+    UE_LOG(LogEmmyLuaIntelliSense, Log, TEXT("[BUNDLE] Module %s: %d types in %d chunks"), *ModuleName, ModuleTypes.Num(), WrittenChunkCount);
+}
+UBlueprint* ULuaExportManager::LoadBlueprint(const FString& ObjectPath) const
+{
+    EMMYLUA_LLM_SCOPE(Blueprints);
+    EMMYLUA_SCOPE_CYCLE_COUNTER(LoadBlueprint);
+    FLuaExportReport::FScopedPhase Phase(ExportReport, TEXT("LoadBlueprint"));
+    INC_DWORD_STAT(STAT_EmmyLua_BlueprintsLoaded);
+    return LoadObject<UBlueprint>(nullptr, *ObjectPath);
 }
 bool ULuaExportManager::IsBlueprint(const FAssetData& AssetData)
 {
@@ -496,7 +1152,7 @@ bool ULuaExportManager::ShouldExportBlueprint(const FAssetData& AssetData, bool
     }
     if (bLoad)
     {
-        if (UBlueprint* Blueprint = LoadObject<UBlueprint>(nullptr, *AssetData.ObjectPath.ToString()))
+        if (UBlueprint* Blueprint = LoadBlueprint(AssetData.ObjectPath.ToString()))
         {
             return Blueprint->GeneratedClass != nullptr;
         }
@@ -504,50 +1160,75 @@ bool ULuaExportManager::ShouldExportBlueprint(const FAssetData& AssetData, bool
     }
     return true;
 }
-void ULuaExportManager::SaveFile(const FString& ModuleName, const FString& FileName, const FString& Content)
+void ULuaExportManager::SaveFile(const FString& ModuleName, const FString& FileName, const FString& Content, EEmmyLuaDialect Dialect)
 {
-    FString Directory = OutputDir;
+    EMMYLUA_LLM_SCOPE(GeneratedCode);
+    EMMYLUA_SCOPE_CYCLE_COUNTER(SaveFile);
+    FLuaExportReport::FScopedPhase Phase(ExportReport, TEXT("SaveFile"));
+    FString Directory = GetDialectOutputDir(Dialect);
     if (!ModuleName.IsEmpty())
     {
         Directory = FPaths::Combine(Directory, ModuleName);
     }
-    IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
-    if (!PlatformFile.DirectoryExists(*Directory))
+    if (!ExportFile->DirectoryExists(*Directory))
     {
-        PlatformFile.CreateDirectoryTree(*Directory);
+        ExportFile->CreateDirectoryTree(*Directory);
     }
     FString FilePath = FPaths::Combine(Directory, FileName + TEXT(".lua"));
+    // 符号索引只覆盖EmmyLua输出
+    const bool bUpdateSymbolIndex = Dialect == EEmmyLuaDialect::EmmyLua;
+    const FString RelativePath = GetRelativeOutputPath(ModuleName, FileName);
     FString ExistingContent;
-    if (FFileHelper::LoadFileToString(ExistingContent, *FilePath))
+    if (ExportFile->LoadFileToString(ExistingContent, *FilePath))
     {
-        if (ExistingContent == Content)
+        if (ExistingContent.Equals(Content, ESearchCase::CaseSensitive))
         {
+            UnchangedFileCount++;
+            INC_DWORD_STAT(STAT_EmmyLua_FilesUnchanged);
+            ExportReport.AddFileUnchanged();
+            // 内容未变时只在索引缺失该文件时补建
+            if (bUpdateSymbolIndex && !SymbolIndex.ContainsFile(RelativePath))
+            {
+                SymbolIndex.UpdateFile(RelativePath, Content);
+            }
             return; 
         }
     }
-    if (!FFileHelper::SaveStringToFile(Content, *FilePath, FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM))
+    if (!ExportFile->SaveStringToFile(Content, *FilePath))
     {
         UE_LOG(LogEmmyLuaIntelliSense, Error, TEXT("Failed to save Lua file: %s"), *FilePath);
     }
     else
     {
+        const int32 ContentBytes = FTCHARToUTF8_Convert::ConvertedLength(*Content, Content.Len());
+        WrittenFileCount++;
+        INC_DWORD_STAT(STAT_EmmyLua_FilesWritten);
+        INC_QWORD_STAT_BY(STAT_EmmyLua_BytesWritten, ContentBytes);
+        ExportReport.AddFileWritten();
         UE_LOG(LogEmmyLuaIntelliSense, Verbose, TEXT("Saved Lua file: %s"), *FilePath);
+        if (bUpdateSymbolIndex)
+        {
+            SymbolIndex.UpdateFile(RelativePath, Content);
+        }
     }
 }
-void ULuaExportManager::DeleteFile(const FString& ModuleName, const FString& FileName)
+void ULuaExportManager::DeleteFile(const FString& ModuleName, const FString& FileName, EEmmyLuaDialect Dialect)
 {
-    FString Directory = OutputDir;
+    FString Directory = GetDialectOutputDir(Dialect);
     if (!ModuleName.IsEmpty())
     {
         Directory = FPaths::Combine(Directory, ModuleName);
     }
     FString FilePath = FPaths::Combine(Directory, FileName + TEXT(".lua"));
-    IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
-    if (PlatformFile.FileExists(*FilePath))
+    if (ExportFile->FileExists(*FilePath))
     {
-        if (PlatformFile.DeleteFile(*FilePath))
+        if (ExportFile->DeleteFile(*FilePath))
         {
             UE_LOG(LogEmmyLuaIntelliSense, Log, TEXT("Deleted Lua file: %s"), *FilePath);
+            if (Dialect == EEmmyLuaDialect::EmmyLua)
+            {
+                SymbolIndex.RemoveFile(GetRelativeOutputPath(ModuleName, FileName));
+            }
         }
         else
         {
@@ -555,6 +1236,21 @@ void ULuaExportManager::DeleteFile(const FString& ModuleName, const FString& Fil
         }
     }
 }
+FString ULuaExportManager::GetRelativeOutputPath(const FString& ModuleName, const FString& FileName)
+{
+    FString RelativePath = ModuleName.IsEmpty() ? FileName + TEXT(".lua") : FPaths::Combine(ModuleName, FileName + TEXT(".lua"));
+    RelativePath.RemoveFromStart(TEXT("/"));
+    return RelativePath;
+}
+FString ULuaExportManager::GetDialectOutputDir(EEmmyLuaDialect Dialect) const
+{
+    switch (Dialect)
+    {
+    case EEmmyLuaDialect::LuaLS:    return OutputDir + TEXT("_LuaLS");
+    case EEmmyLuaDialect::UnLua:    return OutputDir + TEXT("_UnLua");
+    default:                        return OutputDir;
+    }
+}
 FString ULuaExportManager::GetOutputDirectory() const
 {
     TSharedPtr<IPlugin> Plugin = IPluginManager::Get().FindPlugin(TEXT("EmmyLuaIntelliSense"));
@@ -583,19 +1279,23 @@ FString ULuaExportManager::GenerateUnLuaDefinitions() const
 }
 void ULuaExportManager::LoadExportCache()
 {
+    EMMYLUA_LLM_SCOPE(HashCache);
+    EMMYLUA_SCOPE_CYCLE_COUNTER(LoadExportCache);
     double StartTime = FPlatformTime::Seconds();
     ExportedFilesHashCache.Empty();
+    CachedOutputSignature.Empty();
+    bExportCacheDirty = false;
     UE_LOG(LogEmmyLuaIntelliSense, Log, TEXT("Loading export cache from: %s"), *ExportCacheFilePath);
-    if (!FPaths::FileExists(ExportCacheFilePath))
+    int64 FileSize = ExportFile->FileSize(*ExportCacheFilePath);
+    if (FileSize < 0)
     {
         UE_LOG(LogEmmyLuaIntelliSense, Log, TEXT("Export cache file not found, starting fresh export. Path: %s"), *ExportCacheFilePath);
         return;
     }
-    int64 FileSize = IFileManager::Get().FileSize(*ExportCacheFilePath);
     UE_LOG(LogEmmyLuaIntelliSense, Log, TEXT("Export cache file size: %lld bytes"), FileSize);
     FString JsonString;
     double LoadStartTime = FPlatformTime::Seconds();
-    if (!FFileHelper::LoadFileToString(JsonString, *ExportCacheFilePath))
+    if (!ExportFile->LoadFileToString(JsonString, *ExportCacheFilePath))
     {
         UE_LOG(LogEmmyLuaIntelliSense, Warning, TEXT("Failed to load export cache file: %s"), *ExportCacheFilePath);
         return;
@@ -614,22 +1314,32 @@ void ULuaExportManager::LoadExportCache()
     UE_LOG(LogEmmyLuaIntelliSense, Log, TEXT("JSON parsing took: %.3f ms"), (ParseEndTime - ParseStartTime) * 1000.0);
     double ProcessStartTime = FPlatformTime::Seconds();
     int32 FilteredCount = 0;
+    JsonObject->TryGetStringField(TEXT("OutputSignature"), CachedOutputSignature);
     const TSharedPtr<FJsonObject>* HashCachePtr = nullptr;
     if (JsonObject->TryGetObjectField(TEXT("HashCache"), HashCachePtr))
     {
         if (HashCachePtr && HashCachePtr->IsValid())
         {
+            ExportedFilesHashCache.Reserve((*HashCachePtr)->Values.Num());
             for (const auto& Pair : (*HashCachePtr)->Values)
             {
                 if (ShouldExcludeFromExport(Pair.Key))
                 {
                     FilteredCount++;
+                    bExportCacheDirty = true;
                     continue;
                 }
-                FString HashString = Pair.Value->AsString();
-                if (!HashString.IsEmpty())
+                // 文件中以十六进制保存，内存中只保留20字节摘要；长度不符的旧条目丢弃，下次重新导出
+                const FString HashString = Pair.Value->AsString();
+                if (HashString.Len() == 40)
+                {
+                    FSHAHash Hash;
+                    Hash.FromString(HashString);
+                    ExportedFilesHashCache.Add(FName(*Pair.Key), Hash);
+                }
+                else if (!HashString.IsEmpty())
                 {
-                    ExportedFilesHashCache.Add(Pair.Key, HashString);
+                    bExportCacheDirty = true;
                 }
             }
         }
@@ -639,6 +1349,8 @@ void ULuaExportManager::LoadExportCache()
     else
     {
         UE_LOG(LogEmmyLuaIntelliSense, Log, TEXT("Old format cache detected, starting fresh with hash-based caching"));
+        // 旧格式没有可用条目，标记为已修改，下次保存时以新格式覆盖
+        bExportCacheDirty = true;
     }
     double ProcessEndTime = FPlatformTime::Seconds();
     UE_LOG(LogEmmyLuaIntelliSense, Log, TEXT("Cache processing took: %.3f ms, filtered %d excluded paths"), (ProcessEndTime - ProcessStartTime) * 1000.0, FilteredCount);
@@ -648,22 +1360,41 @@ void ULuaExportManager::LoadExportCache()
 }
 void ULuaExportManager::SaveExportCache()
 {
+    EMMYLUA_GAME_THREAD_SCOPE(SaveExportCache);
+    EMMYLUA_SCOPE_CYCLE_COUNTER(SaveExportCache);
+    SymbolIndex.Save();
+    if (!bExportCacheDirty)
+    {
+        UE_LOG(LogEmmyLuaIntelliSense, Log, TEXT("Export cache unchanged, skipping save"));
+        return;
+    }
     double StartTime = FPlatformTime::Seconds();
     UE_LOG(LogEmmyLuaIntelliSense, Log, TEXT("Saving export cache with %d hash entries to: %s"), 
         ExportedFilesHashCache.Num(), *ExportCacheFilePath);
     FString CacheDir = FPaths::GetPath(ExportCacheFilePath);
-    if (!FPaths::DirectoryExists(CacheDir))
+    if (!ExportFile->DirectoryExists(*CacheDir))
     {
         UE_LOG(LogEmmyLuaIntelliSense, Log, TEXT("Creating cache directory: %s"), *CacheDir);
-        IFileManager::Get().MakeDirectory(*CacheDir, true);
+        ExportFile->CreateDirectoryTree(*CacheDir);
     }
     double SerializeStartTime = FPlatformTime::Seconds();
     TSharedPtr<FJsonObject> JsonObject = MakeShareable(new FJsonObject);
     TSharedPtr<FJsonObject> HashCache = MakeShareable(new FJsonObject);
-    for (const auto& Pair : ExportedFilesHashCache)
+    TArray<TPair<FString, FString>> SortedEntries;
+    SortedEntries.Reserve(ExportedFilesHashCache.Num());
+    for (const TPair<FName, FSHAHash>& Pair : ExportedFilesHashCache)
+    {
+        SortedEntries.Emplace(Pair.Key.ToString(), Pair.Value.ToString().ToLower());
+    }
+    SortedEntries.Sort([](const TPair<FString, FString>& A, const TPair<FString, FString>& B)
+    {
+        return A.Key.Compare(B.Key, ESearchCase::CaseSensitive) < 0;
+    });
+    for (const TPair<FString, FString>& Entry : SortedEntries)
     {
-        HashCache->SetStringField(Pair.Key, Pair.Value);
+        HashCache->SetStringField(Entry.Key, Entry.Value);
     }
+    JsonObject->SetStringField(TEXT("OutputSignature"), CachedOutputSignature);
     JsonObject->SetObjectField(TEXT("HashCache"), HashCache);
     FString JsonString;
     TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&JsonString);
@@ -675,30 +1406,73 @@ void ULuaExportManager::SaveExportCache()
     double SerializeEndTime = FPlatformTime::Seconds();
     UE_LOG(LogEmmyLuaIntelliSense, Log, TEXT("JSON serialization took: %.3f ms, size: %d characters"), (SerializeEndTime - SerializeStartTime) * 1000.0, JsonString.Len());
     double SaveStartTime = FPlatformTime::Seconds();
-    if (FFileHelper::SaveStringToFile(JsonString, *ExportCacheFilePath))
+    if (ExportFile->SaveStringToFile(JsonString, *ExportCacheFilePath))
     {
         double SaveEndTime = FPlatformTime::Seconds();
         UE_LOG(LogEmmyLuaIntelliSense, Log, TEXT("File saving took: %.3f ms"), (SaveEndTime - SaveStartTime) * 1000.0);
-        int64 FileSize = IFileManager::Get().FileSize(*ExportCacheFilePath);
-        UE_LOG(LogEmmyLuaIntelliSense, Log, TEXT("Saved file size: %lld bytes"), FileSize);
     }
     else
     {
         UE_LOG(LogEmmyLuaIntelliSense, Warning, TEXT("Failed to save export cache to: %s"), *ExportCacheFilePath);
         return;
     }
+    bExportCacheDirty = false;
     double TotalTime = FPlatformTime::Seconds() - StartTime;
     UE_LOG(LogEmmyLuaIntelliSense, Log, TEXT("SaveExportCache completed in %.3f ms"), TotalTime * 1000.0);
 }
+
+void ULuaExportManager::BeginOutputRedirect(const FString& RootDir)
+{
+    if (!ensureMsgf(!SavedOutputState.IsSet(), TEXT("Output is already redirected")))
+    {
+        return;
+    }
+    // 先把正式输出的缓存和索引落盘，重定向期间不再触碰它们
+    SaveExportCache();
+    FLuaSavedOutputState& Saved = SavedOutputState.Emplace();
+    Saved.OutputDir = MoveTemp(OutputDir);
+    Saved.ExportCacheFilePath = MoveTemp(ExportCacheFilePath);
+    Saved.CachedOutputSignature = MoveTemp(CachedOutputSignature);
+    Saved.ExportedFilesHashCache = MoveTemp(ExportedFilesHashCache);
+    Saved.SymbolIndex = MoveTemp(SymbolIndex);
+    Saved.bExportCacheDirty = bExportCacheDirty;
+    OutputDir = FPaths::Combine(RootDir, TEXT("LuaIntelliSense"));
+    ExportCacheFilePath = FPaths::Combine(RootDir, TEXT("ExportCache.json"));
+    CachedOutputSignature.Empty();
+    ExportedFilesHashCache.Empty();
+    bExportCacheDirty = false;
+    SymbolIndex = FLuaSymbolIndex();
+    SymbolIndex.Load(FPaths::Combine(OutputDir, TEXT("SymbolIndex.json")));
+    UE_LOG(LogEmmyLuaIntelliSense, Log, TEXT("[EXPORT] Output redirected to: %s"), *RootDir);
+}
+
+void ULuaExportManager::EndOutputRedirect()
+{
+    if (!SavedOutputState.IsSet())
+    {
+        return;
+    }
+    SaveExportCache();
+    FLuaSavedOutputState& Saved = SavedOutputState.GetValue();
+    OutputDir = MoveTemp(Saved.OutputDir);
+    ExportCacheFilePath = MoveTemp(Saved.ExportCacheFilePath);
+    CachedOutputSignature = MoveTemp(Saved.CachedOutputSignature);
+    ExportedFilesHashCache = MoveTemp(Saved.ExportedFilesHashCache);
+    SymbolIndex = MoveTemp(Saved.SymbolIndex);
+    bExportCacheDirty = Saved.bExportCacheDirty;
+    SavedOutputState.Reset();
+    UE_LOG(LogEmmyLuaIntelliSense, Log, TEXT("[EXPORT] Output restored to: %s"), *OutputDir);
+}
+
 bool ULuaExportManager::ShouldReexport(const FString& AssetPath, const FString& AssetFilePath) const
 {
-    FString AssetHash = CalculateFileHash(AssetFilePath);
-    if (AssetHash.IsEmpty())
+    const FSHAHash AssetHash = CalculateFileHash(AssetFilePath);
+    if (AssetHash == FSHAHash())
     {
         UE_LOG(LogEmmyLuaIntelliSense, VeryVerbose, TEXT("[REEXPORT] Failed to get hash for file %s (asset: %s), will export"), *AssetFilePath, *AssetPath);
         return true;
     }
-    return ShouldReexportByHash(AssetPath, AssetHash);
+    return ShouldReexportByHash(FName(*AssetPath), AssetHash);
 }
 bool ULuaExportManager::IsValidFieldForExport(const UField* Field, FString& OutFieldName) const
 {
@@ -787,33 +1561,24 @@ void ULuaExportManager::LoadExcludedPathsFromFile(TArray<FString>& OutExcludedPa
         }
     }
 }
-FString ULuaExportManager::CalculateFileHash(const FString& FilePath) const
+FSHAHash ULuaExportManager::CalculateFileHash(const FString& FilePath, const TCHAR* PhaseName) const
 {
-    if (!FPaths::FileExists(FilePath))
-    {
-        return FString();
-    }
+    EMMYLUA_SCOPE_CYCLE_COUNTER(HashFile);
+    FLuaExportReport::FScopedPhase Phase(ExportReport, PhaseName);
+    // 直接打开文件，不存在时打开失败，省去一次单独的存在性查询
     TArray<uint8> FileData;
-    if (!FFileHelper::LoadFileToArray(FileData, *FilePath))
-    {
-        UE_LOG(LogEmmyLuaIntelliSense, Log, TEXT("[HASH] Failed to load file for hashing: %s"), *FilePath);
-        return FString();
-    }
-    FSHA1 Sha1;
-    Sha1.Update(FileData.GetData(), FileData.Num());
-    Sha1.Final();
-    FString HashString;
-    for (int32 i = 0; i < 20; ++i)
+    if (!ExportFile->LoadFileToArray(FileData, *FilePath))
     {
-        HashString += FString::Printf(TEXT("%02x"), Sha1.m_digest[i]);
+        UE_LOG(LogEmmyLuaIntelliSense, Verbose, TEXT("[HASH] Failed to load file for hashing: %s"), *FilePath);
+        return FSHAHash();
     }
-    return HashString;
+    return FSHA1::HashBuffer(FileData.GetData(), FileData.Num());
 }
-FString ULuaExportManager::CalculateClassStructureHash(const UClass* Class) const
+FSHAHash ULuaExportManager::CalculateClassStructureHash(const UClass* Class) const
 {
     if (!Class || !IsValid(Class) || Class->HasAnyFlags(RF_BeginDestroyed | RF_FinishDestroyed))
     {
-        return FString();
+        return FSHAHash();
     }
     FString SignatureString;
     SignatureString += FString::Printf(TEXT("ClassName:%s;"), *Class->GetName());
@@ -869,20 +1634,13 @@ FString ULuaExportManager::CalculateClassStructureHash(const UClass* Class) cons
         SignatureString += TEXT(";");
     }
     SignatureString += TEXT("];");
-    FSHA1 Sha1;
     FTCHARToUTF8 UTF8String(*SignatureString);
-    Sha1.Update((const uint8*)UTF8String.Get(), UTF8String.Length());
-    Sha1.Final();
-    FString HashString;
-    for (int32 i = 0; i < 20; ++i)
-    {
-        HashString += FString::Printf(TEXT("%02x"), Sha1.m_digest[i]);
-    }
+    const FSHAHash Hash = FSHA1::HashBuffer(UTF8String.Get(), UTF8String.Length());
     UE_LOG(LogEmmyLuaIntelliSense, VeryVerbose, TEXT("[STRUCTURE_HASH] Class %s signature: %s"), *Class->GetName(), *SignatureString);
-    UE_LOG(LogEmmyLuaIntelliSense, VeryVerbose, TEXT("[STRUCTURE_HASH] Class %s hash: %s"), *Class->GetName(), *HashString);
-    return HashString;
+    UE_LOG(LogEmmyLuaIntelliSense, VeryVerbose, TEXT("[STRUCTURE_HASH] Class %s hash: %s"), *Class->GetName(), *Hash.ToString());
+    return Hash;
 }
-FString ULuaExportManager::GetAssetHash(const FString& AssetPath) const
+bool ULuaExportManager::ResolveAssetFilePath(const FString& AssetPath, FString& OutFilePath) const
 {
     FString NormalizedAssetPath = AssetPath;
     int32 LastDotIndex;
@@ -899,55 +1657,168 @@ FString ULuaExportManager::GetAssetHash(const FString& AssetPath) const
     if (NormalizedAssetPath.StartsWith(TEXT("/Game/")))
     {
         FString PackageName = NormalizedAssetPath.RightChop(6); 
-        FString AssetFilePath = FPaths::Combine(FPaths::ProjectContentDir(), PackageName + TEXT(".uasset"));
-        UE_LOG(LogEmmyLuaIntelliSense, VeryVerbose, TEXT("[HASH] Calculating hash for Game Blueprint file: %s -> %s"), *AssetPath, *AssetFilePath);
-        FString Hash = CalculateFileHash(AssetFilePath);
-        if (!Hash.IsEmpty())
+        OutFilePath = FPaths::Combine(FPaths::ProjectContentDir(), PackageName + TEXT(".uasset"));
+        return true;
+    }
+    else if (NormalizedAssetPath.StartsWith(TEXT("/")) && NormalizedAssetPath.Contains(TEXT("/")))
+    {
+        if (FPackageName::TryConvertLongPackageNameToFilename(NormalizedAssetPath, OutFilePath, TEXT(".uasset")))
+        {
+            return true;
+        }
+        UE_LOG(LogEmmyLuaIntelliSense, Log, TEXT("[HASH] Failed to convert package name to file path: %s"), *AssetPath);
+    }
+    return false;
+}
+FSHAHash ULuaExportManager::GetAssetHash(const FString& AssetPath) const
+{
+    EMMYLUA_SCOPE_CYCLE_COUNTER(FingerprintAsset);
+    FLuaExportReport::FScopedPhase Phase(ExportReport, TEXT("Fingerprint"));
+    FString AssetFilePath;
+    if (ResolveAssetFilePath(AssetPath, AssetFilePath))
+    {
+        UE_LOG(LogEmmyLuaIntelliSense, VeryVerbose, TEXT("[HASH] Calculating hash for Blueprint file: %s -> %s"), *AssetPath, *AssetFilePath);
+        const FSHAHash Hash = CalculateFileHash(AssetFilePath);
+        if (Hash != FSHAHash())
         {
-            UE_LOG(LogEmmyLuaIntelliSense, VeryVerbose, TEXT("[HASH] Game Blueprint hash: %s"), *Hash);
+            UE_LOG(LogEmmyLuaIntelliSense, VeryVerbose, TEXT("[HASH] Blueprint hash: %s"), *Hash.ToString());
         }
         else
         {
-            UE_LOG(LogEmmyLuaIntelliSense, Log, TEXT("[HASH] Failed to calculate hash for Game Blueprint: %s"), *AssetFilePath);
+            UE_LOG(LogEmmyLuaIntelliSense, Log, TEXT("[HASH] Failed to calculate hash for Blueprint: %s"), *AssetFilePath);
         }
         return Hash;
     }
-    else if (NormalizedAssetPath.StartsWith(TEXT("/")) && NormalizedAssetPath.Contains(TEXT("/")))
+    // 无法定位资源文件时只按路径计算，保证多次调用结果一致
+    FTCHARToUTF8 UTF8Path(*AssetPath);
+    return FSHA1::HashBuffer(UTF8Path.Get(), UTF8Path.Length());
+}
+FSHAHash ULuaExportManager::GetPrefetchedAssetHash(FName ObjectPath, const FString& AssetPath, bool& bOutPrefetched) const
+{
+    bOutPrefetched = false;
+    FLuaPrefetchedFingerprint Prefetched;
+    {
+        FScopeLock ScopeLock(&PrefetchLock);
+        const FLuaPrefetchedFingerprint* Found = PrefetchedFingerprints.Find(ObjectPath);
+        if (!Found)
+        {
+            return GetAssetHash(AssetPath);
+        }
+        Prefetched = *Found;
+    }
+    // 预计算之后文件被改过时时间戳会变，此时重新计算；只查时间戳比重新读取整个文件便宜得多
+    FString AssetFilePath;
+    if (ResolveAssetFilePath(AssetPath, AssetFilePath) && ExportFile->GetTimeStamp(*AssetFilePath) == Prefetched.TimeStamp)
+    {
+        bOutPrefetched = true;
+        return Prefetched.Hash;
+    }
+    return GetAssetHash(AssetPath);
+}
+
+bool ULuaExportManager::CanScanOnStartup()
+{
+    // 启动扫描的环境条件：FEmmyLuaIntelliSenseModule::InitializeLuaExportManager据此决定是否扫描，发现阶段的指纹预计算也以此为前提
+#if !PLATFORM_WINDOWS
+    return false;
+#else
+    return !IsRunningCommandlet() && GIsEditor;
+#endif
+}
+
+void ULuaExportManager::QueueFingerprintPrefetch(const FAssetData& AssetData)
+{
+    const UEmmyLuaIntelliSenseSettings* Settings = UEmmyLuaIntelliSenseSettings::Get();
+    if (!Settings || !Settings->bExportBlueprintFiles || bPrefetchStopRequested || !CanScanOnStartup())
+    {
+        return;
+    }
+    if (ShouldExcludeFromExport(AssetData.ObjectPath.ToString()))
+    {
+        return;
+    }
+    PrefetchQueue.Enqueue(AssetData.ObjectPath);
+    if (!bPrefetchRunning.AtomicSet(true))
+    {
+        // 上一个任务清除运行标志后可能还未返回，以它为前置，等待最新的任务即可保证全部结束
+        PrefetchTask = FFunctionGraphTask::CreateAndDispatchWhenReady([this]()
+        {
+            RunFingerprintPrefetch();
+        }, TStatId(), PrefetchTask, ENamedThreads::AnyBackgroundThreadNormalTask);
+    }
+}
+
+void ULuaExportManager::RunFingerprintPrefetch()
+{
+    EMMYLUA_LLM_SCOPE(ScanResults);
+    int32 PrefetchedCount = 0;
+    for (;;)
     {
-        FString PackageName = NormalizedAssetPath;
-        FString AssetFilePath;
-        if (FPackageName::TryConvertLongPackageNameToFilename(PackageName, AssetFilePath, TEXT(".uasset")))
+        FName ObjectPath;
+        while (!bPrefetchStopRequested && PrefetchQueue.Dequeue(ObjectPath))
         {
-            UE_LOG(LogEmmyLuaIntelliSense, VeryVerbose, TEXT("[HASH] Calculating hash for Plugin Blueprint file: %s -> %s"), *AssetPath, *AssetFilePath);
-            FString Hash = CalculateFileHash(AssetFilePath);
-            if (!Hash.IsEmpty())
+            const FString AssetPath = ObjectPath.ToString();
+            FString AssetFilePath;
+            if (!ResolveAssetFilePath(AssetPath, AssetFilePath))
             {
-                UE_LOG(LogEmmyLuaIntelliSense, VeryVerbose, TEXT("[HASH] Plugin Blueprint hash: %s"), *Hash);
+                continue;
             }
-            else
+            // 先取时间戳再计算指纹，计算期间文件被改写时使用前的校验会失败
+            FLuaPrefetchedFingerprint Prefetched;
+            Prefetched.TimeStamp = ExportFile->GetTimeStamp(*AssetFilePath);
+            if (Prefetched.TimeStamp == FDateTime::MinValue())
+            {
+                continue;
+            }
+            // 发现阶段可能与扫描重叠，单独计入PrefetchHash阶段，不与扫描自己的HashFile混在一起
+            Prefetched.Hash = CalculateFileHash(AssetFilePath, TEXT("PrefetchHash"));
+            if (Prefetched.Hash == FSHAHash())
+            {
+                continue;
+            }
+            FScopeLock ScopeLock(&PrefetchLock);
+            if (bPrefetchStopRequested)
             {
-                UE_LOG(LogEmmyLuaIntelliSense, Log, TEXT("[HASH] Failed to calculate hash for Plugin Blueprint: %s"), *AssetFilePath);
+                break;
             }
-            return Hash;
+            PrefetchedFingerprints.Add(ObjectPath, Prefetched);
+            ++PrefetchedCount;
         }
-        else
+        if (bPrefetchStopRequested)
+        {
+            // 队列只能由消费者清空，停止后剩余的项在这里丢弃
+            PrefetchQueue.Empty();
+        }
+        bPrefetchRunning = false;
+        // 清除标志后再检查一次，避免与入队竞争时漏掉最后几个
+        if (bPrefetchStopRequested || PrefetchQueue.IsEmpty() || bPrefetchRunning.AtomicSet(true))
         {
-            UE_LOG(LogEmmyLuaIntelliSense, Log, TEXT("[HASH] Failed to convert package name to file path: %s"), *AssetPath);
+            break;
         }
     }
-    FString TypeInfo = AssetPath + TEXT("_") + FDateTime::Now().ToString();
-    return FMD5::HashAnsiString(*TypeInfo);
+    UE_LOG(LogEmmyLuaIntelliSense, Verbose, TEXT("[PREFETCH] Fingerprinted %d blueprints during asset discovery"), PrefetchedCount);
 }
-FString ULuaExportManager::GetAssetHash(const UField* Field) const
+
+void ULuaExportManager::DiscardPrefetchedFingerprints()
+{
+    // 预计算任务在加锁检查停止标志后才写入，清空后不会再有新的结果
+    bPrefetchStopRequested = true;
+    FScopeLock ScopeLock(&PrefetchLock);
+    PrefetchedFingerprints.Empty();
+}
+
+FSHAHash ULuaExportManager::GetAssetHash(const UField* Field) const
 {
+    EMMYLUA_SCOPE_CYCLE_COUNTER(FingerprintNativeType);
+    FLuaExportReport::FScopedPhase Phase(ExportReport, TEXT("Fingerprint"));
     if (!Field || !IsValid(Field) || Field->HasAnyFlags(RF_BeginDestroyed | RF_FinishDestroyed))
     {
-        return FString();
+        return FSHAHash();
     }
     if (const UClass* Class = Cast<UClass>(Field))
     {
-        FString StructureHash = CalculateClassStructureHash(Class);
-        UE_LOG(LogEmmyLuaIntelliSense, VeryVerbose, TEXT("[HASH] Native Class structure hash for %s: %s"), *Class->GetName(), *StructureHash);
+        const FSHAHash StructureHash = CalculateClassStructureHash(Class);
+        UE_LOG(LogEmmyLuaIntelliSense, VeryVerbose, TEXT("[HASH] Native Class structure hash for %s: %s"), *Class->GetName(), *StructureHash.ToString());
         return StructureHash;
     }
     FString SignatureString = FString::Printf(TEXT("FieldType:%s;FieldName:%s;"), *Field->GetClass()->GetName(), *Field->GetName());
@@ -973,47 +1844,47 @@ FString ULuaExportManager::GetAssetHash(const UField* Field) const
         }
         SignatureString += TEXT("];");
     }
-    FSHA1 Sha1;
     FTCHARToUTF8 UTF8String(*SignatureString);
-    Sha1.Update((const uint8*)UTF8String.Get(), UTF8String.Length());
-    Sha1.Final();
-    FString HashString;
-    for (int32 i = 0; i < 20; ++i)
-    {
-        HashString += FString::Printf(TEXT("%02x"), Sha1.m_digest[i]);
-    }
-    UE_LOG(LogEmmyLuaIntelliSense, VeryVerbose, TEXT("[HASH] Native Field structure hash for %s (%s): %s"), *Field->GetName(), *Field->GetClass()->GetName(), *HashString);
-    return HashString;
+    const FSHAHash Hash = FSHA1::HashBuffer(UTF8String.Get(), UTF8String.Length());
+    UE_LOG(LogEmmyLuaIntelliSense, VeryVerbose, TEXT("[HASH] Native Field structure hash for %s (%s): %s"), *Field->GetName(), *Field->GetClass()->GetName(), *Hash.ToString());
+    return Hash;
 }
-bool ULuaExportManager::ShouldReexportByHash(const FString& AssetPath, const FString& AssetHash) const
+bool ULuaExportManager::ShouldReexportByHash(FName AssetPath, const FSHAHash& AssetHash) const
 {
-    const FString* CachedHash = ExportedFilesHashCache.Find(AssetPath);
+    const FSHAHash* CachedHash = ExportedFilesHashCache.Find(AssetPath);
     if (!CachedHash)
     {
-        UE_LOG(LogEmmyLuaIntelliSense, Log, TEXT("[REEXPORT_HASH] No hash cache found for %s, will export"), *AssetPath);
+        UE_LOG(LogEmmyLuaIntelliSense, Log, TEXT("[REEXPORT_HASH] No hash cache found for %s, will export"), *AssetPath.ToString());
         return true;
     }
     bool bShouldReexport = AssetHash != *CachedHash;
     if (bShouldReexport)
     {
         UE_LOG(LogEmmyLuaIntelliSense, Log, TEXT("[REEXPORT_HASH] %s: Asset hash=%s, Cache hash=%s, Should reexport=YES"), 
-            *AssetPath, 
-            *AssetHash, 
-            **CachedHash);
+            *AssetPath.ToString(), 
+            *AssetHash.ToString(), 
+            *CachedHash->ToString());
     }
     else
     {
         UE_LOG(LogEmmyLuaIntelliSense, VeryVerbose, TEXT("[REEXPORT_HASH] %s: Asset hash=%s, Cache hash=%s, Should reexport=NO"), 
-            *AssetPath, 
-            *AssetHash, 
-            **CachedHash);
+            *AssetPath.ToString(), 
+            *AssetHash.ToString(), 
+            *CachedHash->ToString());
     }
     return bShouldReexport;
 }
-void ULuaExportManager::UpdateExportCacheByHash(const FString& AssetPath, const FString& AssetHash)
+void ULuaExportManager::UpdateExportCacheByHash(FName AssetPath, const FSHAHash& AssetHash)
 {
+    EMMYLUA_LLM_SCOPE(HashCache);
+    const FSHAHash* CachedHash = ExportedFilesHashCache.Find(AssetPath);
+    if (CachedHash && *CachedHash == AssetHash)
+    {
+        return;
+    }
     ExportedFilesHashCache.Add(AssetPath, AssetHash);
-    UE_LOG(LogEmmyLuaIntelliSense, VeryVerbose, TEXT("[CACHE_HASH] Updated hash cache for %s: %s"), *AssetPath, *AssetHash);
+    bExportCacheDirty = true;
+    UE_LOG(LogEmmyLuaIntelliSense, VeryVerbose, TEXT("[CACHE_HASH] Updated hash cache for %s: %s"), *AssetPath.ToString(), *AssetHash.ToString());
 }
 bool ULuaExportManager::ShouldExcludeFromExport(const FString& AssetPath) const
 {
@@ -1053,8 +1924,9 @@ bool ULuaExportManager::ShouldExcludeFromExport(const FString& AssetPath) const
     UE_LOG(LogEmmyLuaIntelliSense, VeryVerbose, TEXT("[EXCLUDE] Path allowed: %s"), *AssetPath);
     return false;
 }
-void ULuaExportManager::CopyUELibFolder() const
+void ULuaExportManager::CopyUELibFolder(const FString& TargetRootDir) const
 {
+    EMMYLUA_SCOPE_CYCLE_COUNTER(CopyUELib);
     TSharedPtr<IPlugin> Plugin = IPluginManager::Get().FindPlugin(TEXT("EmmyLuaIntelliSense"));
     if (!Plugin.IsValid())
     {
@@ -1063,8 +1935,8 @@ void ULuaExportManager::CopyUELibFolder() const
     }
     FString PluginDir = Plugin->GetBaseDir();
     FString SourceUELibDir = FPaths::Combine(PluginDir, TEXT("Resources"), TEXT("UELib"));
-    FString TargetUELibDir = FPaths::Combine(OutputDir, TEXT("UELib"));
-    IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+    FString TargetUELibDir = FPaths::Combine(TargetRootDir, TEXT("UELib"));
+    FLuaExportPlatformFile& PlatformFile = *ExportFile;
     if (!PlatformFile.DirectoryExists(*SourceUELibDir))
     {
         UE_LOG(LogEmmyLuaIntelliSense, Warning, TEXT("[COPY_UELIB] Source UELib directory does not exist: %s"), *SourceUELibDir);
@@ -1083,12 +1955,24 @@ void ULuaExportManager::CopyUELibFolder() const
     public:
         FString SourceDir;
         FString TargetDir;
-        IPlatformFile* PlatformFile;
+        FLuaExportPlatformFile* PlatformFile;
         int32 CopiedFiles;
-        FUELibCopyVisitor(const FString& InSourceDir, const FString& InTargetDir, IPlatformFile* InPlatformFile)
+        FUELibCopyVisitor(const FString& InSourceDir, const FString& InTargetDir, FLuaExportPlatformFile* InPlatformFile)
             : SourceDir(InSourceDir), TargetDir(InTargetDir), PlatformFile(InPlatformFile), CopiedFiles(0)
         {
         }
+        bool IsSameFileContent(const TCHAR* SourcePath, const TCHAR* TargetPath) const
+        {
+            if (PlatformFile->FileSize(SourcePath) != PlatformFile->FileSize(TargetPath))
+            {
+                return false;
+            }
+            TArray<uint8> SourceData;
+            TArray<uint8> TargetData;
+            return PlatformFile->LoadFileToArray(SourceData, SourcePath) &&
+                   PlatformFile->LoadFileToArray(TargetData, TargetPath) &&
+                   SourceData == TargetData;
+        }
         virtual bool Visit(const TCHAR* FilenameOrDirectory, bool bIsDirectory) override
         {
             FString FullPath(FilenameOrDirectory);
@@ -1107,6 +1991,10 @@ void ULuaExportManager::CopyUELibFolder() const
             }
             else
             {
+                if (IsSameFileContent(*FullPath, *TargetPath))
+                {
+                    return true;
+                }
                 if (PlatformFile->CopyFile(*TargetPath, *FullPath))
                 {
                     CopiedFiles++;
@@ -1122,17 +2010,20 @@ void ULuaExportManager::CopyUELibFolder() const
     };
     FUELibCopyVisitor CopyVisitor(SourceUELibDir, TargetUELibDir, &PlatformFile);
     PlatformFile.IterateDirectoryRecursively(*SourceUELibDir, CopyVisitor);
-    UE_LOG(LogEmmyLuaIntelliSense, Log, TEXT("[COPY_UELIB] Successfully copied UELib folder from %s to %s (%d files)"), 
+    UE_LOG(LogEmmyLuaIntelliSense, Log, TEXT("[COPY_UELIB] Successfully synced UELib folder from %s to %s (%d files copied)"), 
         *SourceUELibDir, *TargetUELibDir, CopyVisitor.CopiedFiles);
 }
 void ULuaExportManager::ScanExistingAssetsAsync()
 {
+    EMMYLUA_LLM_SCOPE(Plugin);
     if (bIsAsyncScanningInProgress)
     {
         return;
     }
     bIsAsyncScanningInProgress = true;
     bScanCancelled = false;
+    BeginExportReport(TEXT("Scan"));
+    ValidateOutputSignature();
     ScanProgressNotification = FLuaExportNotificationManager::ShowScanProgress(TEXT("正在初始化扫描..."));
     
     // 记录扫描开始时间，确保最小显示时间
@@ -1141,8 +2032,8 @@ void ULuaExportManager::ScanExistingAssetsAsync()
     // 使用异步任务执行扫描
     AsyncTask(ENamedThreads::AnyBackgroundThreadNormalTask, [this, ScanStartTime]()
     {
-        TArray<FAssetData> BlueprintAssets;
-        TArray<const UField*> NativeTypes;
+        EMMYLUA_LLM_SCOPE(ScanResults);
+        FLuaScanResultsRef Results = MakeShared<FLuaScanResults, ESPMode::ThreadSafe>();
         
         // 检查设置，决定是否扫描蓝图
         const UEmmyLuaIntelliSenseSettings* Settings = UEmmyLuaIntelliSenseSettings::Get();
@@ -1151,18 +2042,34 @@ void ULuaExportManager::ScanExistingAssetsAsync()
         if (bShouldScanBlueprints)
         {
             
-            // 在后台线程执行蓝图扫描
+            // 在后台线程执行蓝图扫描，FAssetData只在这里短暂存在，之后只保留对象路径
+            FLuaExportReport::FScopedPhase Phase(ExportReport, TEXT("CollectAssets"));
             FAssetRegistryModule& AssetRegistryModule = FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry"));
             FARFilter Filter;
             Filter.ClassNames.Add(UBlueprint::StaticClass()->GetFName());
+            TArray<FAssetData> BlueprintAssets;
             AssetRegistryModule.Get().GetAssets(Filter, BlueprintAssets);
+            Results->Blueprints.SetNum(BlueprintAssets.Num());
+            for (int32 Index = 0; Index < BlueprintAssets.Num(); ++Index)
+            {
+                Results->Blueprints[Index].ObjectPath = BlueprintAssets[Index].ObjectPath;
+            }
         }
         // 扫描原生类型
-        CollectNativeTypes(NativeTypes);
-        
+        {
+            TArray<const UField*> NativeTypes;
+            CollectNativeTypes(NativeTypes);
+            Results->NativeTypes.SetNum(NativeTypes.Num());
+            for (int32 Index = 0; Index < NativeTypes.Num(); ++Index)
+            {
+                Results->NativeTypes[Index].NativeType = NativeTypes[Index];
+            }
+        }
         
         UE_LOG(LogEmmyLuaIntelliSense, Log, TEXT("Asset scanning completed. Found %d blueprints, %d native types"), 
-               BlueprintAssets.Num(), NativeTypes.Num());
+               Results->Blueprints.Num(), Results->NativeTypes.Num());
+        ExportReport.AddScanned(ELuaExportCategory::Blueprint, Results->Blueprints.Num());
+        ExportReport.AddScanned(ELuaExportCategory::NativeType, Results->NativeTypes.Num());
         
         // 确保最小显示时间（至少2秒）
         double ElapsedTime = FPlatformTime::Seconds() - ScanStartTime;
@@ -1173,28 +2080,28 @@ void ULuaExportManager::ScanExistingAssetsAsync()
         }
         
         // 回到主线程处理结果
-        AsyncTask(ENamedThreads::GameThread, [this, BlueprintAssets, NativeTypes]()
+        AsyncTask(ENamedThreads::GameThread, [this, Results]()
         {
-            OnAsyncScanCompleted(BlueprintAssets, NativeTypes);
+            // 收集原生类型时填充的生成器缓存在游戏线程清空，不与游戏线程上的导出并发修改
+            FEmmyLuaCodeGenerator::ResetExportCaches();
+            OnAsyncScanCompleted(Results);
         });
     });
 }
-void ULuaExportManager::OnAsyncScanCompleted(const TArray<FAssetData>& BlueprintAssets, const TArray<const UField*>& NativeTypes)
+void ULuaExportManager::OnAsyncScanCompleted(FLuaScanResultsRef Results)
 {
+    EMMYLUA_GAME_THREAD_SCOPE(ScanCompleted);
+    EMMYLUA_LLM_SCOPE(ScanResults);
     if (!IsValid(this))
     {
         return;
     }
     if (bScanCancelled)
     {
-        UE_LOG(LogEmmyLuaIntelliSense, Log, TEXT("Asset scanning was cancelled by user"));
-        FLuaExportNotificationManager::CompleteScanProgressNotification(ScanProgressNotification, TEXT("扫描已取消"), false);
-        bIsAsyncScanningInProgress = false;
-        bScanCancelled = false;
-        ScanProgressNotification.Reset();
+        FinishCancelledScan(TEXT("扫描已取消"));
         return;
     }
-    UE_LOG(LogEmmyLuaIntelliSense, Log, TEXT("Async scan completed. Found %d blueprints, %d native types"), BlueprintAssets.Num(), NativeTypes.Num());
+    UE_LOG(LogEmmyLuaIntelliSense, Log, TEXT("Async scan completed. Found %d blueprints, %d native types"), Results->Blueprints.Num(), Results->NativeTypes.Num());
     
     // 更新通知显示开始分析阶段
     if (ScanProgressNotification.IsValid())
@@ -1203,28 +2110,33 @@ void ULuaExportManager::OnAsyncScanCompleted(const TArray<FAssetData>& Blueprint
     }
     
     // 将分析过程移到后台线程，以便能够显示进度更新
-    AsyncTask(ENamedThreads::AnyBackgroundThreadNormalTask, [this, BlueprintAssets, NativeTypes]()
+    AsyncTask(ENamedThreads::AnyBackgroundThreadNormalTask, [this, Results]()
     {
+        EMMYLUA_LLM_SCOPE(ScanResults);
         // 检查设置，决定分析消息
         const UEmmyLuaIntelliSenseSettings* Settings = UEmmyLuaIntelliSenseSettings::Get();
         bool bShouldAnalyzeBlueprints = Settings && Settings->bExportBlueprintFiles;
 
-        TArray<FString> LocalPendingBlueprints;
-         TArray<TWeakObjectPtr<const UField>> LocalPendingNativeTypes;
+        FLuaExportReport::FScopedPhase Phase(ExportReport, TEXT("Analyze"));
         
         // 计算总项目数（只包括需要分析的项目）
-        int32 TotalItems = (bShouldAnalyzeBlueprints ? BlueprintAssets.Num() : 0) + NativeTypes.Num();
+        int32 TotalItems = (bShouldAnalyzeBlueprints ? Results->Blueprints.Num() : 0) + Results->NativeTypes.Num();
         int32 ProcessedItems = 0;
+        int32 PrefetchedCount = 0;
         
         // 分析蓝图（如果启用）
         if (bShouldAnalyzeBlueprints)
         {
             int32 BlueprintIndex = 0;
-            for (const FAssetData& AssetData : BlueprintAssets)
+            for (FLuaScanRecord& Record : Results->Blueprints)
             {
                 // 检查是否被取消
                 if (bScanCancelled)
                 {
+                    AsyncTask(ENamedThreads::GameThread, [this]()
+                    {
+                        FinishCancelledScan(TEXT("分析已取消"));
+                    });
                     return;
                 }
                 
@@ -1233,37 +2145,42 @@ void ULuaExportManager::OnAsyncScanCompleted(const TArray<FAssetData>& Blueprint
                 
                 // 检查是否需要添加到待处理列表
                 bool bShouldAddToPending = true;
-                FString AssetPath = AssetData.ObjectPath.ToString();
+                FString AssetPath = Record.ObjectPath.ToString();
                 
                 // 检查是否应该排除
                 if (ShouldExcludeFromExport(AssetPath))
                 {
                     bShouldAddToPending = false;
+                    ExportReport.AddSkipped(ELuaExportCategory::Blueprint);
                 }
                 else
                 {
-                    // 检查哈希是否已更新
-                    FString AssetHash = GetAssetHash(AssetPath);
-                    if (!AssetHash.IsEmpty() && !ShouldReexportByHash(AssetPath, AssetHash))
+                    // 检查哈希是否已更新，指纹随记录带回主线程更新缓存，不再重新计算
+                    bool bPrefetched = false;
+                    Record.Fingerprint = GetPrefetchedAssetHash(Record.ObjectPath, AssetPath, bPrefetched);
+                    PrefetchedCount += bPrefetched ? 1 : 0;
+                    if (Record.Fingerprint != FSHAHash() && !ShouldReexportByHash(Record.ObjectPath, Record.Fingerprint))
                     {
                         bShouldAddToPending = false;
-                        // 在后台线程中不能直接调用UpdateExportCacheByHash，需要在主线程中处理
+                        ExportReport.AddCacheHit();
+                        ExportReport.AddSkipped(ELuaExportCategory::Blueprint);
+                    }
+                    else
+                    {
+                        ExportReport.AddCacheMiss();
                     }
                 }
-                
-                if (bShouldAddToPending)
-                 {
-                     LocalPendingBlueprints.Add(AssetPath);
-                 }
+                Record.bPending = bShouldAddToPending;
                 
                 // 每处理完一个蓝图都更新进度显示
                 float Progress = 0.8f + (0.15f * ProcessedItems / TotalItems);
                 FString ProgressMessage = FString::Printf(TEXT("分析蓝图进度: %d/%d (总计: %d/%d)"), 
-                    BlueprintIndex, BlueprintAssets.Num(), ProcessedItems, TotalItems);
+                    BlueprintIndex, Results->Blueprints.Num(), ProcessedItems, TotalItems);
                 
                 // 使用异步调用更新UI，避免阻塞分析线程
                 AsyncTask(ENamedThreads::GameThread, [this, ProgressMessage, Progress]()
                 {
+                    EMMYLUA_GAME_THREAD_SCOPE(ScanProgress);
                     if (ScanProgressNotification.IsValid())
                     {
                         FLuaExportNotificationManager::UpdateScanProgressNotification(ScanProgressNotification, ProgressMessage, Progress);
@@ -1278,41 +2195,58 @@ void ULuaExportManager::OnAsyncScanCompleted(const TArray<FAssetData>& Blueprint
             }
         }
         
+        if (bShouldAnalyzeBlueprints)
+        {
+            UE_LOG(LogEmmyLuaIntelliSense, Log, TEXT("[PREFETCH] Reused %d of %d blueprint fingerprints computed during asset discovery"),
+                PrefetchedCount, Results->Blueprints.Num());
+        }
+        
         // 分析原生类型
         int32 NativeTypeIndex = 0;
-        for (const UField* Field : NativeTypes)
+        for (FLuaScanRecord& Record : Results->NativeTypes)
         {
             // 检查是否被取消
             if (bScanCancelled)
             {
+                AsyncTask(ENamedThreads::GameThread, [this]()
+                {
+                    FinishCancelledScan(TEXT("分析已取消"));
+                });
                 return;
             }
             
             ProcessedItems++;
             NativeTypeIndex++;
             
-            if (Field)
+            if (const UField* Field = Record.NativeType.Get())
             {
                 FString FieldName;
                 if (IsValidFieldForExport(Field, FieldName))
                 {
-                    FString FieldHash = GetCachedFieldHash(Field);
-                    FString NativeTypePath = Field->GetPathName();
-                    if (ShouldReexportByHash(NativeTypePath, FieldHash))
-                     {
-                         LocalPendingNativeTypes.Add(TWeakObjectPtr<const UField>(Field));
-                     }
+                    Record.Fingerprint = GetCachedFieldHash(Field);
+                    Record.ObjectPath = FName(*Field->GetPathName());
+                    if (ShouldReexportByHash(Record.ObjectPath, Record.Fingerprint))
+                    {
+                        Record.bPending = true;
+                        ExportReport.AddCacheMiss();
+                    }
+                    else
+                    {
+                        ExportReport.AddCacheHit();
+                        ExportReport.AddSkipped(ELuaExportCategory::NativeType);
+                    }
                     // 注意：UpdateExportCacheByHash 需要在主线程中调用
                 }
             }
             
             float Progress = 0.8f + (0.15f * ProcessedItems / TotalItems);
             FString ProgressMessage = FString::Printf(TEXT("分析原生类型进度: %d/%d (总计: %d/%d)"), 
-                NativeTypeIndex, NativeTypes.Num(), ProcessedItems, TotalItems);
+                NativeTypeIndex, Results->NativeTypes.Num(), ProcessedItems, TotalItems);
             
             // 使用异步调用更新UI，避免阻塞分析线程
             AsyncTask(ENamedThreads::GameThread, [this, ProgressMessage, Progress]()
             {
+                EMMYLUA_GAME_THREAD_SCOPE(ScanProgress);
                 if (ScanProgressNotification.IsValid())
                 {
                     FLuaExportNotificationManager::UpdateScanProgressNotification(ScanProgressNotification, ProgressMessage, Progress);
@@ -1327,67 +2261,66 @@ void ULuaExportManager::OnAsyncScanCompleted(const TArray<FAssetData>& Blueprint
         }
         
         // 回到主线程完成分析
-        AsyncTask(ENamedThreads::GameThread, [this, LocalPendingBlueprints, LocalPendingNativeTypes, BlueprintAssets, NativeTypes]()
+        AsyncTask(ENamedThreads::GameThread, [this, Results]()
         {
+            EMMYLUA_GAME_THREAD_SCOPE(ScanCommit);
             if (bScanCancelled)
             {
-                UE_LOG(LogEmmyLuaIntelliSense, Log, TEXT("Asset analysis was cancelled by user"));
-                FLuaExportNotificationManager::CompleteScanProgressNotification(ScanProgressNotification, TEXT("分析已取消"), false);
-                bIsAsyncScanningInProgress = false;
-                bScanCancelled = false;
-                ScanProgressNotification.Reset();
+                FinishCancelledScan(TEXT("分析已取消"));
                 return;
             }
             
-            // 更新待处理列表
+            // 更新待处理列表，未变化的项用分析阶段的指纹更新缓存（需要在主线程中执行）
+            EMMYLUA_LLM_SCOPE(PendingChanges);
             PendingBlueprints.Empty();
             PendingNativeTypes.Empty();
-            PendingBlueprints.Append(LocalPendingBlueprints);
-            PendingNativeTypes.Append(LocalPendingNativeTypes);
-            
-            // 更新缓存（需要在主线程中执行）
-             for (const FAssetData& AssetData : BlueprintAssets)
-             {
-                 FString AssetPath = AssetData.ObjectPath.ToString();
-                 if (!LocalPendingBlueprints.Contains(AssetPath))
-                 {
-                     FString AssetHash = GetAssetHash(AssetPath);
-                     if (!AssetHash.IsEmpty())
-                     {
-                         UpdateExportCacheByHash(AssetPath, AssetHash);
-                     }
-                 }
-             }
-            
-            for (const UField* Field : NativeTypes)
-             {
-                 if (Field && !LocalPendingNativeTypes.Contains(TWeakObjectPtr<const UField>(Field)))
-                 {
-                     FString FieldName;
-                     if (IsValidFieldForExport(Field, FieldName))
-                     {
-                         FString FieldHash = GetCachedFieldHash(Field);
-                         FString NativeTypePath = Field->GetPathName();
-                         if (!ShouldReexportByHash(NativeTypePath, FieldHash))
-                         {
-                             UpdateExportCacheByHash(NativeTypePath, FieldHash);
-                         }
-                     }
-                 }
-             }
+            for (const FLuaScanRecord& Record : Results->Blueprints)
+            {
+                if (Record.bPending)
+                {
+                    PendingBlueprints.Add(Record.ObjectPath.ToString());
+                }
+                else if (Record.Fingerprint != FSHAHash())
+                {
+                    UpdateExportCacheByHash(Record.ObjectPath, Record.Fingerprint);
+                }
+            }
+            {
+                // 预计算的指纹只服务于启动扫描
+                FScopeLock ScopeLock(&PrefetchLock);
+                PrefetchedFingerprints.Empty();
+            }
+            for (const FLuaScanRecord& Record : Results->NativeTypes)
+            {
+                if (Record.bPending)
+                {
+                    PendingNativeTypes.Add(Record.NativeType);
+                }
+                else if (Record.Fingerprint != FSHAHash())
+                {
+                    UpdateExportCacheByHash(Record.ObjectPath, Record.Fingerprint);
+                }
+            }
             
             bIsAsyncScanningInProgress = false;
-            FString CompletionMessage = FString::Printf(TEXT("扫描完成！发现 %d 个待导出项"), PendingBlueprints.Num() + PendingNativeTypes.Num());
+            FString CompletionMessage = FString::Printf(TEXT("扫描完成！发现 %d 个待导出项\n%s"), PendingBlueprints.Num() + PendingNativeTypes.Num(), *ExportReport.GetSummary());
             FLuaExportNotificationManager::CompleteScanProgressNotification(ScanProgressNotification, CompletionMessage, true);
             ScanProgressNotification.Reset();
 
             SaveExportCache();
 
+            // 直接进行增量导出时由导出结束本轮报告，否则扫描到此结束
+            const UEmmyLuaIntelliSenseSettings* ExportSettings = UEmmyLuaIntelliSenseSettings::Get();
+            const bool bAutoExport = HasPendingChanges() && !(ExportSettings && ExportSettings->bAutoStartScanOnStartup);
+            if (!bAutoExport)
+            {
+                FinishExportReport();
+            }
+
             // 检查是否有待导出的文件
             if (HasPendingChanges())
             {
                 // 获取设置以确定后续行为
-                const UEmmyLuaIntelliSenseSettings* ExportSettings = UEmmyLuaIntelliSenseSettings::Get();
                 if (ExportSettings && ExportSettings->bAutoStartScanOnStartup)
                 {
                     // 自动扫描模式：显示导出确认对话框让用户选择
@@ -1406,6 +2339,21 @@ void ULuaExportManager::OnAsyncScanCompleted(const TArray<FAssetData>& Blueprint
     });
 }
 
+void ULuaExportManager::FinishCancelledScan(const TCHAR* Message)
+{
+    EMMYLUA_GAME_THREAD_SCOPE(ScanCompleted);
+    if (!IsValid(this) || !bIsAsyncScanningInProgress)
+    {
+        return;
+    }
+    UE_LOG(LogEmmyLuaIntelliSense, Log, TEXT("Asset scanning was cancelled by user"));
+    FinishExportReport(true);
+    FLuaExportNotificationManager::CompleteScanProgressNotification(ScanProgressNotification, Message, false);
+    bIsAsyncScanningInProgress = false;
+    bScanCancelled = false;
+    ScanProgressNotification.Reset();
+}
+
 void ULuaExportManager::CancelAsyncScan()
 {
     if (!bIsAsyncScanningInProgress)
@@ -1418,12 +2366,18 @@ void ULuaExportManager::CancelAsyncScan()
 }
 void ULuaExportManager::StartFramedProcessing()
 {
+    EMMYLUA_GAME_THREAD_SCOPE(FramedStart);
+    EMMYLUA_LLM_SCOPE(Plugin);
     if (bIsFramedProcessingInProgress)
     {
         UE_LOG(LogEmmyLuaIntelliSense, Warning, TEXT("Framed processing is already in progress"));
         return;
     }
     bIsFramedProcessingInProgress = true;
+    BeginExportReport(TEXT("Framed"));
+    FEmmyLuaCodeGenerator::ResetExportCaches();
+    WrittenFileCount = 0;
+    UnchangedFileCount = 0;
     CurrentBlueprintIndex = 0;
     CurrentNativeTypeIndex = 0;
     if (ScanProgressNotification.IsValid())
@@ -1464,6 +2418,8 @@ void ULuaExportManager::StartFramedProcessing()
 }
 bool ULuaExportManager::ProcessFramedStep()
 {
+    EMMYLUA_GAME_THREAD_SCOPE(FramedStep);
+    EMMYLUA_LLM_SCOPE(Plugin);
     if (!bIsFramedProcessingInProgress)
     {
         return false;
@@ -1473,9 +2429,14 @@ bool ULuaExportManager::ProcessFramedStep()
     while (CurrentBlueprintIndex < ScannedBlueprintAssets.Num() && ProcessedThisFrame < ItemsPerFrame)
     {
         const FAssetData& AssetData = ScannedBlueprintAssets[CurrentBlueprintIndex];
-        if (UBlueprint* Blueprint = Cast<UBlueprint>(AssetData.GetAsset()))
+        if (UBlueprint* Blueprint = LoadBlueprint(AssetData.ObjectPath.ToString()))
         {
             ExportBlueprint(Blueprint);
+            ExportReport.AddExported(ELuaExportCategory::Blueprint);
+        }
+        else
+        {
+            ExportReport.AddSkipped(ELuaExportCategory::Blueprint);
         }
         CurrentBlueprintIndex++;
         ProcessedThisFrame++;
@@ -1500,6 +2461,7 @@ bool ULuaExportManager::ProcessFramedStep()
     {
         const UField* Field = ScannedNativeTypes[CurrentNativeTypeIndex];
         ExportNativeType(Field);
+        ExportReport.AddExported(ELuaExportCategory::NativeType);
         CurrentNativeTypeIndex++;
         ProcessedThisFrame++;
         if (ScanProgressNotification.IsValid())
@@ -1535,6 +2497,7 @@ void ULuaExportManager::ProcessFramedStepWrapper()
 }
 void ULuaExportManager::CompleteFramedProcessing()
 {
+    EMMYLUA_GAME_THREAD_SCOPE(FramedComplete);
     bIsFramedProcessingInProgress = false;
     if (UWorld* World = GEngine->GetCurrentPlayWorld())
     {
@@ -1548,21 +2511,31 @@ void ULuaExportManager::CompleteFramedProcessing()
     ScannedNativeTypes.Empty();
     CurrentBlueprintIndex = 0;
     CurrentNativeTypeIndex = 0;
+    if (DirtyBundleModules.Num() > 0)
+    {
+        TArray<const UField*> AllNativeTypes;
+        CollectNativeTypes(AllNativeTypes);
+        FlushModuleBundles(AllNativeTypes);
+    }
+    FEmmyLuaCodeGenerator::ResetExportCaches();
     SaveExportCache();
+    const FString Summary = ExportReport.GetSummary();
+    FinishExportReport();
     if (ScanProgressNotification.IsValid())
     {
-        ScanProgressNotification->SetText(FText::FromString(TEXT("导出完成！")));
+        ScanProgressNotification->SetText(FText::FromString(FString::Printf(TEXT("导出完成！\n%s"), *Summary)));
         ScanProgressNotification->SetCompletionState(SNotificationItem::CS_Success);
         ScanProgressNotification->ExpireAndFadeout();
         ScanProgressNotification.Reset();
     }
-    UE_LOG(LogEmmyLuaIntelliSense, Log, TEXT("Framed processing completed successfully"));
+    UE_LOG(LogEmmyLuaIntelliSense, Log, TEXT("Framed processing completed successfully, wrote %d files, %d unchanged"), WrittenFileCount, UnchangedFileCount);
 }
-FString ULuaExportManager::GetCachedFieldHash(const UField* Field) const
+FSHAHash ULuaExportManager::GetCachedFieldHash(const UField* Field) const
 {
+    EMMYLUA_LLM_SCOPE(HashCache);
     if (!Field)
     {
-        return FString();
+        return FSHAHash();
     }
     CleanupExpiredHashCache();
     if (FieldHashCache.Contains(Field))
@@ -1573,7 +2546,7 @@ FString ULuaExportManager::GetCachedFieldHash(const UField* Field) const
             return FieldHashCache[Field];
         }
     }
-    FString Hash = GetAssetHash(Field);
+    const FSHAHash Hash = GetAssetHash(Field);
     FieldHashCache.Add(Field, Hash);
     FieldHashCacheTimestamp.Add(Field, FPlatformTime::Seconds());
     return Hash;
@@ -1594,4 +2567,135 @@ void ULuaExportManager::CleanupExpiredHashCache() const
         FieldHashCache.Remove(Key);
         FieldHashCacheTimestamp.Remove(Key);
     }
-}
\ No newline at end of file
+}
+FString ULuaExportManager::GetOutputSignature() const
+{
+    const UEmmyLuaIntelliSenseSettings* Settings = UEmmyLuaIntelliSenseSettings::Get();
+    if (!Settings)
+    {
+        return FString();
+    }
+    FString Signature = FString::Printf(TEXT("Layout:%d;Dialects:%u;Profile:%d;"), 
+        (int32)Settings->OutputLayout, Settings->GetEnabledDialectMask(), (int32)Settings->OutputProfile);
+    if (Settings->OutputLayout == EEmmyLuaOutputLayout::PerModule)
+    {
+        Signature += FString::Printf(TEXT("MaxBundleSizeKB:%d;"), Settings->MaxBundleSizeKB);
+    }
+    return Signature;
+}
+void ULuaExportManager::ValidateOutputSignature()
+{
+    const FString Signature = GetOutputSignature();
+    if (CachedOutputSignature.Equals(Signature, ESearchCase::CaseSensitive))
+    {
+        return;
+    }
+    // 没有签名的缓存来自加入签名之前的版本或首次导出，直接采用当前配置，不删除已有输出
+    if (CachedOutputSignature.IsEmpty())
+    {
+        CachedOutputSignature = Signature;
+        bExportCacheDirty = true;
+        return;
+    }
+    UE_LOG(LogEmmyLuaIntelliSense, Log, TEXT("[CACHE] Output settings changed (%s -> %s), invalidating export cache"), *CachedOutputSignature, *Signature);
+    // 原生类型输出都位于/Script下，布局变化后旧文件会与新文件重复定义，全部删除后重新导出
+    for (uint32 DialectIndex = 0; DialectIndex < static_cast<uint32>(EEmmyLuaDialect::Count); ++DialectIndex)
+    {
+        const FString NativeOutputDir = FPaths::Combine(GetDialectOutputDir(static_cast<EEmmyLuaDialect>(DialectIndex)), TEXT("Script"));
+        if (ExportFile->DirectoryExists(*NativeOutputDir))
+        {
+            ExportFile->DeleteDirectoryRecursively(*NativeOutputDir);
+        }
+    }
+    ExportedFilesHashCache.Empty();
+    DirtyBundleModules.Empty();
+    PendingBundleHashes.Empty();
+    SymbolIndex.Reset();
+    CachedOutputSignature = Signature;
+    bExportCacheDirty = true;
+}
+void ULuaExportManager::BeginExportReport(const TCHAR* RunType)
+{
+    const bool bNewRun = !ExportReport.IsActive();
+    ExportReport.Begin(RunType);
+    if (!bNewRun)
+    {
+        return;
+    }
+    UpdateSimulatedStorageLayer();
+    // 模拟慢速存储时的耗时单独建立基线，不与正常运行比较
+    if (ThrottledFile.IsValid() && ExportFile->GetLowerLevel() == ThrottledFile.Get())
+    {
+        ExportReport.Begin(TEXT("SlowIO"));
+        UE_LOG(LogEmmyLuaIntelliSense, Warning, TEXT("[IO] Simulated slow storage is active (EmmyLua.IO.SimulatedLatencyMs / EmmyLua.IO.SimulatedBandwidthMBps)"));
+    }
+}
+
+void ULuaExportManager::UpdateSimulatedStorageLayer()
+{
+    IPlatformFile& PhysicalFile = FPlatformFileManager::Get().GetPlatformFile();
+    if (!FLuaThrottledPlatformFile::IsThrottling())
+    {
+        ExportFile->SetLowerLevel(&PhysicalFile);
+        return;
+    }
+    // 模拟层创建后保留到管理器销毁，后台预计算可能仍持有经过它的调用
+    if (!ThrottledFile.IsValid())
+    {
+        ThrottledFile = MakeUnique<FLuaThrottledPlatformFile>();
+        ThrottledFile->Initialize(&PhysicalFile, TEXT(""));
+    }
+    ExportFile->SetLowerLevel(ThrottledFile.Get());
+}
+
+void ULuaExportManager::ReportRetainedMemory() const
+{
+    auto GetStringSetSize = [](const TSet<FString>& Set)
+    {
+        SIZE_T Size = Set.GetAllocatedSize();
+        for (const FString& Element : Set)
+        {
+            Size += Element.GetAllocatedSize();
+        }
+        return Size;
+    };
+    // 键为FName，名称本身在全局名称表中，这里只计哈希表
+    const SIZE_T HashCacheSize = ExportedFilesHashCache.GetAllocatedSize();
+    const SIZE_T FieldHashCacheSize = FieldHashCache.GetAllocatedSize() + FieldHashCacheTimestamp.GetAllocatedSize();
+    SIZE_T PrefetchSize = 0;
+    {
+        FScopeLock ScopeLock(&PrefetchLock);
+        PrefetchSize = PrefetchedFingerprints.GetAllocatedSize();
+    }
+    // FAssetData的标签与资产注册表共享，这里只计数组本身
+    const SIZE_T ScanResultsSize = ScannedBlueprintAssets.GetAllocatedSize() + ScannedNativeTypes.GetAllocatedSize();
+    const SIZE_T PendingSize = GetStringSetSize(PendingBlueprints) + PendingNativeTypes.GetAllocatedSize() + GetStringSetSize(DirtyBundleModules) + PendingBundleHashes.GetAllocatedSize();
+    ExportReport.SetRetainedMemory(TEXT("ExportedFilesHashCache"), HashCacheSize);
+    ExportReport.SetRetainedMemory(TEXT("FieldHashCache"), FieldHashCacheSize);
+    ExportReport.SetRetainedMemory(TEXT("PrefetchedFingerprints"), PrefetchSize);
+    ExportReport.SetRetainedMemory(TEXT("PendingChanges"), PendingSize);
+    ExportReport.SetRetainedMemory(TEXT("ScanResults"), ScanResultsSize);
+    ExportReport.SetRetainedMemory(TEXT("SymbolIndex"), SymbolIndex.GetAllocatedSize());
+}
+void ULuaExportManager::FinishExportReport(bool bCancelled)
+{
+    // 后台线程上的取消路径不能遍历游戏线程持有的容器
+    if (IsInGameThread())
+    {
+        ReportRetainedMemory();
+    }
+    const TArray<FLuaPhaseRegression> Regressions = ExportReport.Finish(ExportReportFilePath, bCancelled);
+    // 取消的运行不做比较，也就不会在后台线程弹出通知
+    if (Regressions.Num() == 0 || !IsInGameThread())
+    {
+        return;
+    }
+    FString Message = TEXT("Lua导出性能下降：");
+    for (const FLuaPhaseRegression& Regression : Regressions)
+    {
+        Message += FString::Printf(TEXT("\n%s 比最近 %d 次的中位数慢 %.1f 倍（%.2fs / %.2fs）"),
+            *Regression.Phase, Regression.BaselineRuns, Regression.Seconds / FMath::Max(Regression.BaselineSeconds, SMALL_NUMBER),
+            Regression.Seconds, Regression.BaselineSeconds);
+    }
+    FLuaExportNotificationManager::ShowPerformanceWarning(Message);
+}
@@ -0,0 +1,208 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "LuaExportManager.h"
+#include "LuaExportTestAccess.h"
+#include "EmmyLuaIntelliSense.h"
+#include "EmmyLuaIntelliSenseSettings.h"
+#include "HAL/FileManager.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/AutomationTest.h"
+#include "Misc/Paths.h"
+#include "Misc/ScopeExit.h"
+#include "Templates/UnrealTemplate.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+/**
+ * 连续两次全量导出，第二次导出前清空哈希缓存强制重新生成所有类型，
+ * 输出内容逐字节一致时SaveFile不会写入任何文件
+ * 导出写到自动化测试的临时目录，不影响工程的正式输出
+ */
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FEmmyLuaExportDeterminismTest, "EmmyLua.Export.Deterministic",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FEmmyLuaExportDeterminismTest::RunTest(const FString& Parameters)
+{
+    ULuaExportManager* ExportManager = ULuaExportManager::Get();
+    if (!TestNotNull(TEXT("Export manager"), ExportManager))
+    {
+        return false;
+    }
+
+    const FString OutputRoot = FPaths::Combine(FPaths::AutomationTransientDir(), TEXT("EmmyLuaDeterministic"));
+    IFileManager::Get().DeleteDirectory(*OutputRoot, false, true);
+    ExportManager->BeginOutputRedirect(OutputRoot);
+    ON_SCOPE_EXIT
+    {
+        ExportManager->EndOutputRedirect();
+    };
+
+    ExportManager->ExportAll();
+    FLuaExportTestAccess::ClearHashCache(*ExportManager);
+    ExportManager->ExportAll();
+
+    TestEqual(TEXT("Files written by the second export"), FLuaExportTestAccess::GetWrittenFileCount(*ExportManager), 0);
+    TestTrue(TEXT("Second export regenerated files"), FLuaExportTestAccess::GetUnchangedFileCount(*ExportManager) > 0);
+    return true;
+}
+
+/**
+ * 模块加载事件只把原生类、结构体和枚举加入待导出列表（与全量扫描的过滤一致），
+ * 模块卸载事件只丢弃尚未导出的类型，不删除已导出的文件和缓存记录
+ */
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FEmmyLuaModuleChangeEventTest, "EmmyLua.Changes.ModuleEvents",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FEmmyLuaModuleChangeEventTest::RunTest(const FString& Parameters)
+{
+    ULuaExportManager* ExportManager = ULuaExportManager::Get();
+    if (!TestNotNull(TEXT("Export manager"), ExportManager))
+    {
+        return false;
+    }
+
+    const FString ModulePath = TEXT("/Script/Engine");
+    ExportManager->ClearPendingChanges();
+    const int32 CacheEntries = FLuaExportTestAccess::GetExportCacheEntryCount(*ExportManager);
+
+    ExportManager->HandleChangeEvent(FLuaChangeEvent(ELuaChangeEventType::ModuleLoaded, ModulePath));
+    ExportManager->FlushChangeEvents(false);
+    const TArray<const UField*> PendingTypes = FLuaExportTestAccess::GetPendingNativeTypes(*ExportManager);
+    TestTrue(TEXT("Module load queued native types"), PendingTypes.Num() > 0);
+    for (const UField* Type : PendingTypes)
+    {
+        TestFalse(FString::Printf(TEXT("%s is not a function"), *Type->GetPathName()), Type->IsA<UFunction>());
+        TestTrue(FString::Printf(TEXT("%s is native"), *Type->GetPathName()), Type->IsNative());
+        TestEqual(FString::Printf(TEXT("%s package"), *Type->GetPathName()), Type->GetOutermost()->GetName(), ModulePath);
+    }
+
+    ExportManager->HandleChangeEvent(FLuaChangeEvent(ELuaChangeEventType::ModuleUnloaded, ModulePath));
+    ExportManager->FlushChangeEvents(false);
+    TestEqual(TEXT("Pending types after module unload"), ExportManager->GetPendingNativeTypesCount(), 0);
+    TestEqual(TEXT("Export cache entries after module unload"), FLuaExportTestAccess::GetExportCacheEntryCount(*ExportManager), CacheEntries);
+    return true;
+}
+
+/**
+ * 等待合并窗口处理完排队的变更，再检查取消的扫描已清除标记、变更已进入待导出列表
+ * 结束时恢复测试开始前的bAutoExportOnChange
+ */
+DEFINE_LATENT_AUTOMATION_COMMAND_THREE_PARAMETER(FEmmyLuaWaitForChangeFlushCommand, FAutomationTestBase*, Test, double, StartTime, bool, bPreviousAutoExport);
+
+bool FEmmyLuaWaitForChangeFlushCommand::Update()
+{
+    ULuaExportManager* ExportManager = ULuaExportManager::Get();
+    if (!ExportManager)
+    {
+        Test->AddError(TEXT("Export manager went away"));
+        return true;
+    }
+    const bool bFlushed = FLuaExportTestAccess::GetCoalescedChangeCount(*ExportManager) == 0;
+    if (!bFlushed && FPlatformTime::Seconds() - StartTime < 60.0)
+    {
+        return false;
+    }
+    UEmmyLuaIntelliSenseSettings::GetMutable()->bAutoExportOnChange = bPreviousAutoExport;
+    Test->TestTrue(TEXT("Queued change flushed after the scan was cancelled"), bFlushed);
+    Test->TestFalse(TEXT("Cancelled scan cleared its in-progress flag"), FLuaExportTestAccess::IsAsyncScanningInProgress(*ExportManager));
+    Test->TestTrue(TEXT("Flushed change queued native types"), ExportManager->GetPendingNativeTypesCount() > 0);
+    ExportManager->ClearPendingChanges();
+    return true;
+}
+
+/**
+ * 取消扫描（无论停在资产注册表扫描还是后台分析阶段）后必须清除扫描标记，
+ * 否则合并窗口会一直等待扫描结束，排队的变更永远不会被处理
+ */
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FEmmyLuaCancelledScanFlushTest, "EmmyLua.Changes.FlushAfterCancelledScan",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FEmmyLuaCancelledScanFlushTest::RunTest(const FString& Parameters)
+{
+    ULuaExportManager* ExportManager = ULuaExportManager::Get();
+    if (!TestNotNull(TEXT("Export manager"), ExportManager))
+    {
+        return false;
+    }
+
+    ExportManager->ClearPendingChanges();
+    ExportManager->ScanExistingAssetsAsync();
+    if (!TestTrue(TEXT("Scan started"), FLuaExportTestAccess::IsAsyncScanningInProgress(*ExportManager)))
+    {
+        return false;
+    }
+    ExportManager->CancelAsyncScan();
+    // 变更只进入待导出列表，不导出到工程的正式输出
+    UEmmyLuaIntelliSenseSettings* Settings = UEmmyLuaIntelliSenseSettings::GetMutable();
+    const bool bPreviousAutoExport = Settings->bAutoExportOnChange;
+    Settings->bAutoExportOnChange = false;
+    ExportManager->HandleChangeEvent(FLuaChangeEvent(ELuaChangeEventType::ModuleLoaded, TEXT("/Script/UMG")));
+    ADD_LATENT_AUTOMATION_COMMAND(FEmmyLuaWaitForChangeFlushCommand(this, FPlatformTime::Seconds(), bPreviousAutoExport));
+    return true;
+}
+
+namespace
+{
+    /** 在RootDir下对模块的所有类型做一次增量导出，返回导出耗时（秒） */
+    double ExportModuleToDirectory(ULuaExportManager& ExportManager, const FString& ModulePath, const FString& RootDir)
+    {
+        IFileManager::Get().DeleteDirectory(*RootDir, false, true);
+        ExportManager.BeginOutputRedirect(RootDir);
+        ON_SCOPE_EXIT
+        {
+            ExportManager.EndOutputRedirect();
+        };
+        FLuaExportTestAccess::ClearHashCache(ExportManager);
+        ExportManager.ClearPendingChanges();
+        ExportManager.HandleChangeEvent(FLuaChangeEvent(ELuaChangeEventType::ModuleLoaded, ModulePath));
+        ExportManager.FlushChangeEvents(false);
+        const double StartTime = FPlatformTime::Seconds();
+        ExportManager.ExportIncremental(false);
+        return FPlatformTime::Seconds() - StartTime;
+    }
+}
+
+/**
+ * 模拟慢速存储下，模块打包布局（每个模块合并写入少量文件）应快于按类型布局（每个类型一个文件），
+ * 每个文件操作都要付出一次模拟延迟，合并写入省下的请求数直接体现在耗时上
+ */
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FEmmyLuaSlowStorageBatchingTest, "EmmyLua.IO.SlowStorageBatching",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FEmmyLuaSlowStorageBatchingTest::RunTest(const FString& Parameters)
+{
+    ULuaExportManager* ExportManager = ULuaExportManager::Get();
+    UEmmyLuaIntelliSenseSettings* Settings = UEmmyLuaIntelliSenseSettings::GetMutable();
+    IConsoleVariable* LatencyVariable = IConsoleManager::Get().FindConsoleVariable(TEXT("EmmyLua.IO.SimulatedLatencyMs"));
+    if (!TestNotNull(TEXT("Export manager"), ExportManager) || !TestNotNull(TEXT("Settings"), Settings)
+        || !TestNotNull(TEXT("EmmyLua.IO.SimulatedLatencyMs"), LatencyVariable))
+    {
+        return false;
+    }
+
+    const float PreviousLatencyMs = LatencyVariable->GetFloat();
+    LatencyVariable->Set(1.0f, ECVF_SetByCode);
+    ON_SCOPE_EXIT
+    {
+        LatencyVariable->Set(PreviousLatencyMs, ECVF_SetByCode);
+    };
+    TGuardValue<EEmmyLuaOutputLayout> LayoutGuard(Settings->OutputLayout, EEmmyLuaOutputLayout::PerType);
+
+    const FString ModulePath = TEXT("/Script/UMG");
+    const FString OutputRoot = FPaths::Combine(FPaths::AutomationTransientDir(), TEXT("EmmyLuaSlowStorage"));
+    const double PerTypeSeconds = ExportModuleToDirectory(*ExportManager, ModulePath, FPaths::Combine(OutputRoot, TEXT("PerType")));
+    const int32 PerTypeWritten = FLuaExportTestAccess::GetWrittenFileCount(*ExportManager);
+    Settings->OutputLayout = EEmmyLuaOutputLayout::PerModule;
+    const double PerModuleSeconds = ExportModuleToDirectory(*ExportManager, ModulePath, FPaths::Combine(OutputRoot, TEXT("PerModule")));
+    const int32 PerModuleWritten = FLuaExportTestAccess::GetWrittenFileCount(*ExportManager);
+
+    UE_LOG(LogEmmyLuaIntelliSense, Log, TEXT("[IO] %s with 1ms simulated latency: per type %.1fms (%d files), per module %.1fms (%d files)"),
+        *ModulePath, PerTypeSeconds * 1000.0, PerTypeWritten, PerModuleSeconds * 1000.0, PerModuleWritten);
+    TestTrue(TEXT("Per type export wrote files"), PerTypeWritten > 0);
+    TestTrue(TEXT("Module bundles write fewer files"), PerModuleWritten < PerTypeWritten);
+    TestTrue(TEXT("Batched module export beats per type export under simulated latency"), PerModuleSeconds < PerTypeSeconds);
+    return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
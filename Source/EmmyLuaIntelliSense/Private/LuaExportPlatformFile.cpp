@@ -0,0 +1,274 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "LuaExportPlatformFile.h"
+#include "LuaExportReport.h"
+#include "HAL/PlatformFilemanager.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/FileHelper.h"
+#include "Templates/UniquePtr.h"
+
+namespace
+{
+    /** 计时一次文件操作，结束时记到报告中 */
+    class FScopedFileOperation
+    {
+    public:
+        FScopedFileOperation(FLuaExportReport& InReport, ELuaFileOperation InOperation, const TCHAR* InPath, int64 InBytes = 0)
+            : Report(InReport)
+            , Operation(InOperation)
+            , Path(InPath)
+            , Bytes(InBytes)
+            , StartTime(FPlatformTime::Seconds())
+        {
+        }
+
+        ~FScopedFileOperation()
+        {
+            Report.AddFileOperation(Operation, Path, Bytes, FPlatformTime::Seconds() - StartTime);
+        }
+
+    private:
+        FLuaExportReport&   Report;
+        ELuaFileOperation   Operation;
+        const TCHAR*        Path;
+        int64               Bytes;
+        double              StartTime;
+    };
+
+    /** 统计读写的文件句柄，句柄随包装一起释放 */
+    class FLuaExportFileHandle : public IFileHandle
+    {
+    public:
+        FLuaExportFileHandle(IFileHandle* InHandle, FLuaExportReport& InReport, const TCHAR* InFilename)
+            : Handle(InHandle)
+            , Report(InReport)
+            , Filename(InFilename)
+        {
+        }
+
+        virtual int64 Tell() override { return Handle->Tell(); }
+        virtual bool Seek(int64 NewPosition) override { return Handle->Seek(NewPosition); }
+        virtual bool SeekFromEnd(int64 NewPositionRelativeToEnd = 0) override { return Handle->SeekFromEnd(NewPositionRelativeToEnd); }
+        virtual bool Flush(const bool bFullFlush = false) override { return Handle->Flush(bFullFlush); }
+        virtual bool Truncate(int64 NewSize) override { return Handle->Truncate(NewSize); }
+        virtual int64 Size() override { return Handle->Size(); }
+
+        virtual bool Read(uint8* Destination, int64 BytesToRead) override
+        {
+            FScopedFileOperation Operation(Report, ELuaFileOperation::Read, *Filename, BytesToRead);
+            return Handle->Read(Destination, BytesToRead);
+        }
+
+        virtual bool Write(const uint8* Source, int64 BytesToWrite) override
+        {
+            FScopedFileOperation Operation(Report, ELuaFileOperation::Write, *Filename, BytesToWrite);
+            return Handle->Write(Source, BytesToWrite);
+        }
+
+    private:
+        TUniquePtr<IFileHandle>     Handle;
+        FLuaExportReport&           Report;
+        FString                     Filename;
+    };
+}
+
+FLuaExportPlatformFile::FLuaExportPlatformFile(FLuaExportReport& InReport)
+    : LowerLevel(nullptr)
+    , Report(InReport)
+{
+}
+
+bool FLuaExportPlatformFile::Initialize(IPlatformFile* Inner, const TCHAR* CmdLine)
+{
+    LowerLevel = Inner;
+    return LowerLevel != nullptr;
+}
+
+bool FLuaExportPlatformFile::LoadFileToArray(TArray<uint8>& OutData, const TCHAR* Filename)
+{
+    TUniquePtr<IFileHandle> Handle(OpenRead(Filename));
+    if (!Handle)
+    {
+        return false;
+    }
+    const int64 Size = Handle->Size();
+    if (Size > MAX_int32)
+    {
+        return false;
+    }
+    OutData.Reset(Size);
+    OutData.AddUninitialized(Size);
+    return Handle->Read(OutData.GetData(), Size);
+}
+
+bool FLuaExportPlatformFile::LoadFileToString(FString& OutString, const TCHAR* Filename)
+{
+    TArray<uint8> Data;
+    if (!LoadFileToArray(Data, Filename))
+    {
+        return false;
+    }
+    FFileHelper::BufferToString(OutString, Data.GetData(), Data.Num());
+    return true;
+}
+
+bool FLuaExportPlatformFile::SaveStringToFile(const FString& Content, const TCHAR* Filename)
+{
+    TUniquePtr<IFileHandle> Handle(OpenWrite(Filename));
+    if (!Handle)
+    {
+        return false;
+    }
+    FTCHARToUTF8 Converter(*Content, Content.Len());
+    return Handle->Write(reinterpret_cast<const uint8*>(Converter.Get()), Converter.Length());
+}
+
+bool FLuaExportPlatformFile::FileExists(const TCHAR* Filename)
+{
+    FScopedFileOperation Operation(Report, ELuaFileOperation::Stat, Filename);
+    return LowerLevel->FileExists(Filename);
+}
+
+int64 FLuaExportPlatformFile::FileSize(const TCHAR* Filename)
+{
+    FScopedFileOperation Operation(Report, ELuaFileOperation::Stat, Filename);
+    return LowerLevel->FileSize(Filename);
+}
+
+bool FLuaExportPlatformFile::DeleteFile(const TCHAR* Filename)
+{
+    FScopedFileOperation Operation(Report, ELuaFileOperation::Modify, Filename);
+    return LowerLevel->DeleteFile(Filename);
+}
+
+bool FLuaExportPlatformFile::IsReadOnly(const TCHAR* Filename)
+{
+    FScopedFileOperation Operation(Report, ELuaFileOperation::Stat, Filename);
+    return LowerLevel->IsReadOnly(Filename);
+}
+
+bool FLuaExportPlatformFile::MoveFile(const TCHAR* To, const TCHAR* From)
+{
+    FScopedFileOperation Operation(Report, ELuaFileOperation::Modify, To);
+    return LowerLevel->MoveFile(To, From);
+}
+
+bool FLuaExportPlatformFile::SetReadOnly(const TCHAR* Filename, bool bNewReadOnlyValue)
+{
+    FScopedFileOperation Operation(Report, ELuaFileOperation::Modify, Filename);
+    return LowerLevel->SetReadOnly(Filename, bNewReadOnlyValue);
+}
+
+FDateTime FLuaExportPlatformFile::GetTimeStamp(const TCHAR* Filename)
+{
+    FScopedFileOperation Operation(Report, ELuaFileOperation::Stat, Filename);
+    return LowerLevel->GetTimeStamp(Filename);
+}
+
+void FLuaExportPlatformFile::SetTimeStamp(const TCHAR* Filename, FDateTime DateTime)
+{
+    FScopedFileOperation Operation(Report, ELuaFileOperation::Modify, Filename);
+    LowerLevel->SetTimeStamp(Filename, DateTime);
+}
+
+FDateTime FLuaExportPlatformFile::GetAccessTimeStamp(const TCHAR* Filename)
+{
+    FScopedFileOperation Operation(Report, ELuaFileOperation::Stat, Filename);
+    return LowerLevel->GetAccessTimeStamp(Filename);
+}
+
+FString FLuaExportPlatformFile::GetFilenameOnDisk(const TCHAR* Filename)
+{
+    FScopedFileOperation Operation(Report, ELuaFileOperation::Stat, Filename);
+    return LowerLevel->GetFilenameOnDisk(Filename);
+}
+
+IFileHandle* FLuaExportPlatformFile::OpenRead(const TCHAR* Filename, bool bAllowWrite)
+{
+    FScopedFileOperation Operation(Report, ELuaFileOperation::Open, Filename);
+    IFileHandle* Handle = LowerLevel->OpenRead(Filename, bAllowWrite);
+    return Handle ? new FLuaExportFileHandle(Handle, Report, Filename) : nullptr;
+}
+
+IFileHandle* FLuaExportPlatformFile::OpenWrite(const TCHAR* Filename, bool bAppend, bool bAllowRead)
+{
+    FScopedFileOperation Operation(Report, ELuaFileOperation::Open, Filename);
+    IFileHandle* Handle = LowerLevel->OpenWrite(Filename, bAppend, bAllowRead);
+    return Handle ? new FLuaExportFileHandle(Handle, Report, Filename) : nullptr;
+}
+
+bool FLuaExportPlatformFile::DirectoryExists(const TCHAR* Directory)
+{
+    FScopedFileOperation Operation(Report, ELuaFileOperation::Stat, Directory);
+    return LowerLevel->DirectoryExists(Directory);
+}
+
+bool FLuaExportPlatformFile::CreateDirectory(const TCHAR* Directory)
+{
+    FScopedFileOperation Operation(Report, ELuaFileOperation::Directory, Directory);
+    return LowerLevel->CreateDirectory(Directory);
+}
+
+bool FLuaExportPlatformFile::DeleteDirectory(const TCHAR* Directory)
+{
+    FScopedFileOperation Operation(Report, ELuaFileOperation::Directory, Directory);
+    return LowerLevel->DeleteDirectory(Directory);
+}
+
+FFileStatData FLuaExportPlatformFile::GetStatData(const TCHAR* FilenameOrDirectory)
+{
+    FScopedFileOperation Operation(Report, ELuaFileOperation::Stat, FilenameOrDirectory);
+    return LowerLevel->GetStatData(FilenameOrDirectory);
+}
+
+bool FLuaExportPlatformFile::IterateDirectory(const TCHAR* Directory, FDirectoryVisitor& Visitor)
+{
+    // 访问者里的文件操作各自统计，目录枚举只计除去访问者之外的时间
+    class FTimedVisitor : public FDirectoryVisitor
+    {
+    public:
+        FTimedVisitor(FDirectoryVisitor& InVisitor) : Visitor(InVisitor), VisitSeconds(0.0) {}
+
+        virtual bool Visit(const TCHAR* FilenameOrDirectory, bool bIsDirectory) override
+        {
+            const double StartTime = FPlatformTime::Seconds();
+            const bool bContinue = Visitor.Visit(FilenameOrDirectory, bIsDirectory);
+            VisitSeconds += FPlatformTime::Seconds() - StartTime;
+            return bContinue;
+        }
+
+        FDirectoryVisitor&  Visitor;
+        double              VisitSeconds;
+    };
+    FTimedVisitor TimedVisitor(Visitor);
+    const double StartTime = FPlatformTime::Seconds();
+    const bool bResult = LowerLevel->IterateDirectory(Directory, TimedVisitor);
+    Report.AddFileOperation(ELuaFileOperation::Directory, Directory, 0, FPlatformTime::Seconds() - StartTime - TimedVisitor.VisitSeconds);
+    return bResult;
+}
+
+bool FLuaExportPlatformFile::IterateDirectoryStat(const TCHAR* Directory, FDirectoryStatVisitor& Visitor)
+{
+    // 与IterateDirectory相同，只计除去访问者之外的时间
+    class FTimedStatVisitor : public FDirectoryStatVisitor
+    {
+    public:
+        FTimedStatVisitor(FDirectoryStatVisitor& InVisitor) : Visitor(InVisitor), VisitSeconds(0.0) {}
+
+        virtual bool Visit(const TCHAR* FilenameOrDirectory, const FFileStatData& StatData) override
+        {
+            const double StartTime = FPlatformTime::Seconds();
+            const bool bContinue = Visitor.Visit(FilenameOrDirectory, StatData);
+            VisitSeconds += FPlatformTime::Seconds() - StartTime;
+            return bContinue;
+        }
+
+        FDirectoryStatVisitor&  Visitor;
+        double                  VisitSeconds;
+    };
+    FTimedStatVisitor TimedVisitor(Visitor);
+    const double StartTime = FPlatformTime::Seconds();
+    const bool bResult = LowerLevel->IterateDirectoryStat(Directory, TimedVisitor);
+    Report.AddFileOperation(ELuaFileOperation::Directory, Directory, 0, FPlatformTime::Seconds() - StartTime - TimedVisitor.VisitSeconds);
+    return bResult;
+}
@@ -0,0 +1,470 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "LuaExportReport.h"
+#include "EmmyLuaIntelliSense.h"
+#include "EmmyLuaIntelliSenseSettings.h"
+#include "HAL/PlatformTime.h"
+#include "HAL/PlatformMemory.h"
+#include "HAL/FileManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Misc/ScopeLock.h"
+#include "Dom/JsonObject.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/JsonWriter.h"
+
+#if PLATFORM_WINDOWS
+#include "Windows/WindowsHWrapper.h"
+#elif PLATFORM_UNIX || PLATFORM_MAC
+#include <time.h>
+#endif
+
+namespace
+{
+    /** 报告中列出的最耗时类型数量 */
+    constexpr int32 TopTypeCount = 20;
+
+    /** 阶段结束时采样内存的最小间隔（秒），采样本身有开销 */
+    constexpr double MemorySampleInterval = 0.05;
+
+    /** 报告中列出的文件操作最多的目录数量 */
+    constexpr int32 TopDirectoryCount = 20;
+
+    const TCHAR* CategoryNames[] = { TEXT("Blueprint"), TEXT("NativeType") };
+    static_assert(UE_ARRAY_COUNT(CategoryNames) == static_cast<int32>(ELuaExportCategory::Count), "Category name table out of date");
+
+    const TCHAR* FileOperationNames[] = { TEXT("Opens"), TEXT("Stats"), TEXT("Reads"), TEXT("Writes"), TEXT("DirectoryOps"), TEXT("Modifies") };
+    static_assert(UE_ARRAY_COUNT(FileOperationNames) == static_cast<int32>(ELuaFileOperation::Count), "File operation name table out of date");
+
+    /** 当前线程上最内层的阶段，文件操作按它归类 */
+    thread_local const TCHAR* CurrentPhaseName = nullptr;
+
+    /** 当前线程已使用的CPU时间（秒），平台不支持时返回0 */
+    double GetThreadCPUSeconds()
+    {
+#if PLATFORM_WINDOWS
+        FILETIME CreationTime, ExitTime, KernelTime, UserTime;
+        if (::GetThreadTimes(::GetCurrentThread(), &CreationTime, &ExitTime, &KernelTime, &UserTime))
+        {
+            const uint64 Kernel = (uint64(KernelTime.dwHighDateTime) << 32) | KernelTime.dwLowDateTime;
+            const uint64 User = (uint64(UserTime.dwHighDateTime) << 32) | UserTime.dwLowDateTime;
+            return double(Kernel + User) * 1.0e-7;
+        }
+#elif PLATFORM_UNIX || PLATFORM_MAC
+        timespec Time;
+        if (clock_gettime(CLOCK_THREAD_CPUTIME_ID, &Time) == 0)
+        {
+            return double(Time.tv_sec) + double(Time.tv_nsec) * 1.0e-9;
+        }
+#endif
+        return 0.0;
+    }
+}
+
+FLuaExportReport::FScopedPhase::FScopedPhase(FLuaExportReport& InReport, const TCHAR* InPhaseName)
+    : Report(InReport.IsActive() ? &InReport : nullptr)
+    , PhaseName(InPhaseName)
+    , OuterPhaseName(CurrentPhaseName)
+    , StartWallTime(0.0)
+    , StartCPUTime(0.0)
+{
+    if (Report)
+    {
+        CurrentPhaseName = PhaseName;
+        StartWallTime = FPlatformTime::Seconds();
+        StartCPUTime = GetThreadCPUSeconds();
+    }
+}
+
+FLuaExportReport::FScopedPhase::~FScopedPhase()
+{
+    if (Report)
+    {
+        CurrentPhaseName = OuterPhaseName;
+        Report->AddPhaseTime(PhaseName, FPlatformTime::Seconds() - StartWallTime, GetThreadCPUSeconds() - StartCPUTime);
+    }
+}
+
+void FLuaExportReport::Begin(const TCHAR* InRunType)
+{
+    FScopeLock ScopeLock(&Lock);
+    if (bActive)
+    {
+        RunType += TEXT("+");
+        RunType += InRunType;
+        return;
+    }
+    bActive = true;
+    RunType = InRunType;
+    StartTime = FDateTime::UtcNow();
+    StartWallTime = FPlatformTime::Seconds();
+    StartUsedPhysical = FPlatformMemory::GetStats().UsedPhysical;
+    RunPeakUsedPhysical = StartUsedPhysical;
+    LastMemorySampleTime = StartWallTime;
+    RetainedMemory.Reset();
+    for (FCategoryCounts& Counts : Categories)
+    {
+        Counts = FCategoryCounts();
+    }
+    CacheHits = 0;
+    CacheMisses = 0;
+    FileIO = FFileIOCounts();
+    FileIOByPhase.Reset();
+    FileIOByDirectory.Reset();
+    FilesWritten = 0;
+    FilesUnchanged = 0;
+    Phases.Reset();
+    TypeCosts.Reset();
+}
+
+bool FLuaExportReport::IsActive() const
+{
+    FScopeLock ScopeLock(&Lock);
+    return bActive;
+}
+
+void FLuaExportReport::AddScanned(ELuaExportCategory Category, int32 Count)
+{
+    FScopeLock ScopeLock(&Lock);
+    Categories[static_cast<int32>(Category)].Scanned += Count;
+}
+
+void FLuaExportReport::AddSkipped(ELuaExportCategory Category, int32 Count)
+{
+    FScopeLock ScopeLock(&Lock);
+    Categories[static_cast<int32>(Category)].Skipped += Count;
+}
+
+void FLuaExportReport::AddExported(ELuaExportCategory Category, int32 Count)
+{
+    FScopeLock ScopeLock(&Lock);
+    Categories[static_cast<int32>(Category)].Exported += Count;
+}
+
+void FLuaExportReport::AddCacheHit()
+{
+    FScopeLock ScopeLock(&Lock);
+    ++CacheHits;
+}
+
+void FLuaExportReport::AddCacheMiss()
+{
+    FScopeLock ScopeLock(&Lock);
+    ++CacheMisses;
+}
+
+void FLuaExportReport::AddFileWritten()
+{
+    FScopeLock ScopeLock(&Lock);
+    ++FilesWritten;
+}
+
+void FLuaExportReport::AddFileUnchanged()
+{
+    FScopeLock ScopeLock(&Lock);
+    ++FilesUnchanged;
+}
+
+void FLuaExportReport::AddFileOperation(ELuaFileOperation Operation, const TCHAR* Path, int64 Bytes, double Seconds)
+{
+    const TCHAR* PhaseName = CurrentPhaseName ? CurrentPhaseName : TEXT("Other");
+    // 目录操作按目录本身归类，文件操作按所在目录归类
+    const FString Directory = Operation == ELuaFileOperation::Directory ? FString(Path) : FPaths::GetPath(Path);
+    FScopeLock ScopeLock(&Lock);
+    if (!bActive)
+    {
+        return;
+    }
+    for (FFileIOCounts* Counts : { &FileIO, &FileIOByPhase.FindOrAdd(PhaseName), &FileIOByDirectory.FindOrAdd(Directory) })
+    {
+        ++Counts->Operations[static_cast<int32>(Operation)];
+        Counts->BytesRead += Operation == ELuaFileOperation::Read ? Bytes : 0;
+        Counts->BytesWritten += Operation == ELuaFileOperation::Write ? Bytes : 0;
+        Counts->Seconds += Seconds;
+    }
+}
+
+void FLuaExportReport::RecordTypeCost(const FString& TypePath, double Seconds)
+{
+    FScopeLock ScopeLock(&Lock);
+    if (bActive)
+    {
+        TypeCosts.Emplace(TypePath, Seconds);
+    }
+}
+
+void FLuaExportReport::AddPhaseTime(const TCHAR* PhaseName, double WallSeconds, double CPUSeconds)
+{
+    FScopeLock ScopeLock(&Lock);
+    FPhaseTime& Phase = Phases.FindOrAdd(PhaseName);
+    Phase.WallSeconds += WallSeconds;
+    Phase.CPUSeconds += CPUSeconds;
+    ++Phase.Calls;
+    const double Now = FPlatformTime::Seconds();
+    if (Now - LastMemorySampleTime >= MemorySampleInterval)
+    {
+        LastMemorySampleTime = Now;
+        SampleMemory();
+    }
+}
+
+void FLuaExportReport::SampleMemory()
+{
+    RunPeakUsedPhysical = FMath::Max<uint64>(RunPeakUsedPhysical, FPlatformMemory::GetStats().UsedPhysical);
+}
+
+void FLuaExportReport::SetRetainedMemory(const TCHAR* Name, int64 Bytes)
+{
+    FScopeLock ScopeLock(&Lock);
+    if (bActive)
+    {
+        RetainedMemory.Add(Name, Bytes);
+    }
+}
+
+FString FLuaExportReport::GetSummary() const
+{
+    FScopeLock ScopeLock(&Lock);
+    const int32 Lookups = CacheHits + CacheMisses;
+    const double HitRate = Lookups > 0 ? 100.0 * CacheHits / Lookups : 0.0;
+    return FString::Printf(TEXT("写入 %d 个文件，%d 个未变化；缓存命中率 %.0f%%；耗时 %.1f 秒"),
+        FilesWritten, FilesUnchanged, HitRate, FPlatformTime::Seconds() - StartWallTime);
+}
+
+TArray<FLuaPhaseRegression> FLuaExportReport::Finish(const FString& ReportFilePath, bool bCancelled)
+{
+    TArray<FLuaPhaseRegression> Regressions;
+    FString JsonString;
+    // 取消的运行耗时不完整，不计入历史
+    TOptional<FLuaExportRunRecord> Record;
+    {
+        FScopeLock ScopeLock(&Lock);
+        if (!bActive)
+        {
+            return Regressions;
+        }
+        SampleMemory();
+        if (!bCancelled)
+        {
+            Record = BuildRunRecord();
+        }
+    }
+    // 历史文件的读写不持有Lock，其他线程记录阶段耗时不会被文件IO阻塞
+    if (Record.IsSet())
+    {
+        FScopeLock HistoryScopeLock(&HistoryLock);
+        const FString HistoryFilePath = FPaths::Combine(FPaths::GetPath(ReportFilePath), TEXT("ExportHistory.json"));
+        if (History.GetFilePath() != HistoryFilePath)
+        {
+            History.Load(HistoryFilePath);
+        }
+        const UEmmyLuaIntelliSenseSettings* Settings = UEmmyLuaIntelliSenseSettings::Get();
+        if (Settings)
+        {
+            History.FindRegressions(Record.GetValue(), Settings->PerfBaselineDays, Settings->PerfRegressionThreshold, Regressions);
+        }
+        History.Append(MoveTemp(Record.GetValue()));
+    }
+    {
+        FScopeLock ScopeLock(&Lock);
+        JsonString = BuildJson(bCancelled, Regressions);
+        bActive = false;
+        TypeCosts.Empty();
+    }
+    for (const FLuaPhaseRegression& Regression : Regressions)
+    {
+        UE_LOG(LogEmmyLuaIntelliSense, Warning, TEXT("[REPORT] %s phase regressed: %.2fs vs expected %.2fs from the median per-item time of the last %d runs (%.1fx)"),
+            *Regression.Phase, Regression.Seconds, Regression.BaselineSeconds, Regression.BaselineRuns,
+            Regression.Seconds / FMath::Max(Regression.BaselineSeconds, SMALL_NUMBER));
+    }
+    IFileManager::Get().MakeDirectory(*FPaths::GetPath(ReportFilePath), true);
+    if (FFileHelper::SaveStringToFile(JsonString, *ReportFilePath, FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM))
+    {
+        UE_LOG(LogEmmyLuaIntelliSense, Log, TEXT("[REPORT] Export report written to: %s"), *ReportFilePath);
+    }
+    else
+    {
+        UE_LOG(LogEmmyLuaIntelliSense, Warning, TEXT("[REPORT] Failed to write export report to: %s"), *ReportFilePath);
+    }
+    return Regressions;
+}
+
+FLuaExportRunRecord FLuaExportReport::BuildRunRecord() const
+{
+    FLuaExportRunRecord Record;
+    Record.RunType = RunType;
+    Record.Time = StartTime;
+    for (const auto& Pair : Phases)
+    {
+        Record.PhaseSeconds.Add(Pair.Key, Pair.Value.WallSeconds);
+    }
+    Record.PhaseSeconds.Add(TEXT("Total"), FPlatformTime::Seconds() - StartWallTime);
+    for (int32 Index = 0; Index < static_cast<int32>(ELuaExportCategory::Count); ++Index)
+    {
+        Record.Counts.Add(FString(CategoryNames[Index]) + TEXT("Scanned"), Categories[Index].Scanned);
+        Record.Counts.Add(FString(CategoryNames[Index]) + TEXT("Exported"), Categories[Index].Exported);
+    }
+    Record.Counts.Add(TEXT("CacheHits"), CacheHits);
+    Record.Counts.Add(TEXT("CacheMisses"), CacheMisses);
+    for (int32 Index = 0; Index < static_cast<int32>(ELuaFileOperation::Count); ++Index)
+    {
+        Record.Counts.Add(FString(TEXT("File")) + FileOperationNames[Index], FileIO.Operations[Index]);
+    }
+    Record.Counts.Add(TEXT("BytesRead"), FileIO.BytesRead);
+    Record.Counts.Add(TEXT("BytesWritten"), FileIO.BytesWritten);
+    Record.Counts.Add(TEXT("FilesWritten"), FilesWritten);
+    int64 RetainedTotal = 0;
+    for (const auto& Pair : RetainedMemory)
+    {
+        RetainedTotal += Pair.Value;
+    }
+    Record.Counts.Add(TEXT("RetainedBytes"), RetainedTotal);
+    Record.Counts.Add(TEXT("RunPeakGrowthBytes"), int64(RunPeakUsedPhysical) - int64(StartUsedPhysical));
+    return Record;
+}
+
+FString FLuaExportReport::BuildJson(bool bCancelled, const TArray<FLuaPhaseRegression>& Regressions) const
+{
+    const FPlatformMemoryStats MemoryStats = FPlatformMemory::GetStats();
+
+    TSharedPtr<FJsonObject> JsonObject = MakeShareable(new FJsonObject);
+    JsonObject->SetStringField(TEXT("RunType"), RunType);
+    JsonObject->SetStringField(TEXT("StartTime"), StartTime.ToIso8601());
+    JsonObject->SetBoolField(TEXT("Cancelled"), bCancelled);
+    JsonObject->SetNumberField(TEXT("WallSeconds"), FPlatformTime::Seconds() - StartWallTime);
+
+    TSharedPtr<FJsonObject> CategoriesObject = MakeShareable(new FJsonObject);
+    for (int32 Index = 0; Index < static_cast<int32>(ELuaExportCategory::Count); ++Index)
+    {
+        TSharedPtr<FJsonObject> CountsObject = MakeShareable(new FJsonObject);
+        CountsObject->SetNumberField(TEXT("Scanned"), Categories[Index].Scanned);
+        CountsObject->SetNumberField(TEXT("Skipped"), Categories[Index].Skipped);
+        CountsObject->SetNumberField(TEXT("Exported"), Categories[Index].Exported);
+        CategoriesObject->SetObjectField(CategoryNames[Index], CountsObject);
+    }
+    JsonObject->SetObjectField(TEXT("Categories"), CategoriesObject);
+
+    TSharedPtr<FJsonObject> CacheObject = MakeShareable(new FJsonObject);
+    CacheObject->SetNumberField(TEXT("Hits"), CacheHits);
+    CacheObject->SetNumberField(TEXT("Misses"), CacheMisses);
+    JsonObject->SetObjectField(TEXT("Cache"), CacheObject);
+
+    TSharedPtr<FJsonObject> IOObject = FileIOToJson(FileIO);
+    IOObject->SetNumberField(TEXT("FilesWritten"), FilesWritten);
+    IOObject->SetNumberField(TEXT("FilesUnchanged"), FilesUnchanged);
+    TSharedPtr<FJsonObject> IOPhasesObject = MakeShareable(new FJsonObject);
+    for (const auto& Pair : FileIOByPhase)
+    {
+        IOPhasesObject->SetObjectField(Pair.Key, FileIOToJson(Pair.Value));
+    }
+    IOObject->SetObjectField(TEXT("Phases"), IOPhasesObject);
+    // 只列出操作次数最多的目录
+    TArray<FString> Directories;
+    FileIOByDirectory.GetKeys(Directories);
+    Directories.Sort([this](const FString& A, const FString& B)
+    {
+        return FileIOByDirectory[A].GetTotalOperations() > FileIOByDirectory[B].GetTotalOperations();
+    });
+    TArray<TSharedPtr<FJsonValue>> DirectoryArray;
+    for (int32 Index = 0; Index < FMath::Min(TopDirectoryCount, Directories.Num()); ++Index)
+    {
+        TSharedPtr<FJsonObject> DirectoryObject = FileIOToJson(FileIOByDirectory[Directories[Index]]);
+        DirectoryObject->SetStringField(TEXT("Directory"), Directories[Index]);
+        DirectoryArray.Add(MakeShareable(new FJsonValueObject(DirectoryObject)));
+    }
+    IOObject->SetArrayField(TEXT("TopDirectories"), DirectoryArray);
+    IOObject->SetNumberField(TEXT("Directories"), Directories.Num());
+    JsonObject->SetObjectField(TEXT("IO"), IOObject);
+
+    // 阶段按墙钟时间降序，嵌套阶段的时间包含在外层阶段中
+    TArray<FString> PhaseNames;
+    Phases.GetKeys(PhaseNames);
+    PhaseNames.Sort([this](const FString& A, const FString& B)
+    {
+        return Phases[A].WallSeconds > Phases[B].WallSeconds;
+    });
+    TArray<TSharedPtr<FJsonValue>> PhaseArray;
+    for (const FString& PhaseName : PhaseNames)
+    {
+        const FPhaseTime& Phase = Phases[PhaseName];
+        TSharedPtr<FJsonObject> PhaseObject = MakeShareable(new FJsonObject);
+        PhaseObject->SetStringField(TEXT("Name"), PhaseName);
+        PhaseObject->SetNumberField(TEXT("WallSeconds"), Phase.WallSeconds);
+        PhaseObject->SetNumberField(TEXT("CPUSeconds"), Phase.CPUSeconds);
+        PhaseObject->SetNumberField(TEXT("Calls"), Phase.Calls);
+        PhaseArray.Add(MakeShareable(new FJsonValueObject(PhaseObject)));
+    }
+    JsonObject->SetArrayField(TEXT("Phases"), PhaseArray);
+
+    TSharedPtr<FJsonObject> MemoryObject = MakeShareable(new FJsonObject);
+    MemoryObject->SetNumberField(TEXT("PeakUsedPhysical"), MemoryStats.PeakUsedPhysical);
+    MemoryObject->SetNumberField(TEXT("StartUsedPhysical"), StartUsedPhysical);
+    MemoryObject->SetNumberField(TEXT("EndUsedPhysical"), MemoryStats.UsedPhysical);
+    MemoryObject->SetNumberField(TEXT("RunPeakUsedPhysical"), RunPeakUsedPhysical);
+    TSharedPtr<FJsonObject> RetainedObject = MakeShareable(new FJsonObject);
+    int64 RetainedTotal = 0;
+    for (const auto& Pair : RetainedMemory)
+    {
+        RetainedObject->SetNumberField(Pair.Key, Pair.Value);
+        RetainedTotal += Pair.Value;
+    }
+    MemoryObject->SetObjectField(TEXT("Retained"), RetainedObject);
+    MemoryObject->SetNumberField(TEXT("RetainedTotal"), RetainedTotal);
+    JsonObject->SetObjectField(TEXT("Memory"), MemoryObject);
+
+    TArray<TPair<FString, double>> SortedCosts = TypeCosts;
+    const int32 TopCount = FMath::Min(TopTypeCount, SortedCosts.Num());
+    SortedCosts.Sort([](const TPair<FString, double>& A, const TPair<FString, double>& B)
+    {
+        return A.Value > B.Value;
+    });
+    TArray<TSharedPtr<FJsonValue>> TopTypesArray;
+    for (int32 Index = 0; Index < TopCount; ++Index)
+    {
+        TSharedPtr<FJsonObject> TypeObject = MakeShareable(new FJsonObject);
+        TypeObject->SetStringField(TEXT("Type"), SortedCosts[Index].Key);
+        TypeObject->SetNumberField(TEXT("Seconds"), SortedCosts[Index].Value);
+        TopTypesArray.Add(MakeShareable(new FJsonValueObject(TypeObject)));
+    }
+    JsonObject->SetArrayField(TEXT("TopTypes"), TopTypesArray);
+
+    TArray<TSharedPtr<FJsonValue>> RegressionArray;
+    for (const FLuaPhaseRegression& Regression : Regressions)
+    {
+        TSharedPtr<FJsonObject> RegressionObject = MakeShareable(new FJsonObject);
+        RegressionObject->SetStringField(TEXT("Phase"), Regression.Phase);
+        RegressionObject->SetNumberField(TEXT("Seconds"), Regression.Seconds);
+        RegressionObject->SetNumberField(TEXT("BaselineSeconds"), Regression.BaselineSeconds);
+        RegressionObject->SetNumberField(TEXT("BaselineRuns"), Regression.BaselineRuns);
+        RegressionArray.Add(MakeShareable(new FJsonValueObject(RegressionObject)));
+    }
+    JsonObject->SetArrayField(TEXT("Regressions"), RegressionArray);
+
+    FString JsonString;
+    TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&JsonString);
+    FJsonSerializer::Serialize(JsonObject.ToSharedRef(), Writer);
+    return JsonString;
+}
+
+int32 FLuaExportReport::FFileIOCounts::GetTotalOperations() const
+{
+    int32 Total = 0;
+    for (int32 Count : Operations)
+    {
+        Total += Count;
+    }
+    return Total;
+}
+
+TSharedPtr<FJsonObject> FLuaExportReport::FileIOToJson(const FFileIOCounts& Counts)
+{
+    TSharedPtr<FJsonObject> CountsObject = MakeShareable(new FJsonObject);
+    for (int32 Index = 0; Index < static_cast<int32>(ELuaFileOperation::Count); ++Index)
+    {
+        CountsObject->SetNumberField(FileOperationNames[Index], Counts.Operations[Index]);
+    }
+    CountsObject->SetNumberField(TEXT("BytesRead"), Counts.BytesRead);
+    CountsObject->SetNumberField(TEXT("BytesWritten"), Counts.BytesWritten);
+    CountsObject->SetNumberField(TEXT("Seconds"), Counts.Seconds);
+    return CountsObject;
+}
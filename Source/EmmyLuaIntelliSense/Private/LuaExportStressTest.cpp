@@ -0,0 +1,429 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "LuaExportManager.h"
+#include "LuaExportTestAccess.h"
+#include "LuaTestTypeFactory.h"
+#include "EmmyLuaIntelliSense.h"
+#include "HAL/IConsoleManager.h"
+#include "UObject/UnrealType.h"
+#include "UObject/Package.h"
+#include "UObject/UObjectGlobals.h"
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "Engine/Blueprint.h"
+#include "Engine/BlueprintGeneratedClass.h"
+#include "Kismet2/KismetEditorUtilities.h"
+#include "Kismet2/BlueprintEditorUtils.h"
+#include "EdGraphSchema_K2.h"
+#include "ObjectTools.h"
+#include "Misc/PackageName.h"
+#include "Misc/Paths.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformProcess.h"
+#include "Async/TaskGraphInterfaces.h"
+
+namespace
+{
+    // 合成类型所在的临时包：不带原生标记，通过测试入口按原生类型收集
+    const TCHAR* StressNativePackage = TEXT("/Temp/EmmyLuaStress");
+    // 合成蓝图所在的挂载点，映射到Intermediate下的临时目录，不写入项目的Content
+    const TCHAR* StressMountRoot = TEXT("/EmmyLuaStress/");
+    const TCHAR* StressContentPath = TEXT("/EmmyLuaStress");
+
+    FString GetStressContentDir()
+    {
+        return FPaths::Combine(FPaths::ProjectIntermediateDir(), TEXT("EmmyLuaStress"), TEXT("Content/"));
+    }
+
+    /** 挂载点只在生成蓝图时注册，清理时注销 */
+    bool bStressMountRegistered = false;
+
+    /** 合成项目的规模参数 */
+    struct FStressOptions
+    {
+        int32   NativeCount = 1000;     // 原生类型总数（类:结构体:枚举 约为 6:3:1）
+        int32   BlueprintCount = 0;     // 蓝图数量
+        int32   MemberCount = 8;        // 每个类型的属性数（类另有同样数量的函数）
+        int32   InheritanceDepth = 4;   // 继承链长度
+        int32   CommentSize = 64;       // 每条注释的字符数
+    };
+
+    /** 当前合成的类型，需要保持Root以免被GC */
+    TArray<UObject*> StressNativeObjects;
+
+    /** 解析 Key=Value 形式的参数 */
+    void ParseStressOptions(const TArray<FString>& Args, FStressOptions& Options)
+    {
+        for (const FString& Arg : Args)
+        {
+            FString Key, Value;
+            if (!Arg.Split(TEXT("="), &Key, &Value))
+            {
+                continue;
+            }
+            const int32 Number = FMath::Max(0, FCString::Atoi(*Value));
+            if (Key.Equals(TEXT("Native"), ESearchCase::IgnoreCase))
+            {
+                Options.NativeCount = Number;
+            }
+            else if (Key.Equals(TEXT("Blueprints"), ESearchCase::IgnoreCase))
+            {
+                Options.BlueprintCount = Number;
+            }
+            else if (Key.Equals(TEXT("Members"), ESearchCase::IgnoreCase))
+            {
+                Options.MemberCount = Number;
+            }
+            else if (Key.Equals(TEXT("Depth"), ESearchCase::IgnoreCase))
+            {
+                Options.InheritanceDepth = FMath::Max(1, Number);
+            }
+            else if (Key.Equals(TEXT("Comment"), ESearchCase::IgnoreCase))
+            {
+                Options.CommentSize = Number;
+            }
+        }
+    }
+
+    /** 生成指定长度的注释文本，包含需要转义的换行 */
+    FString MakeComment(int32 Size, int32 Seed)
+    {
+        static const TCHAR Words[] = TEXT("Synthetic stress comment used to measure export scaling.\n");
+        constexpr int32 WordsLen = UE_ARRAY_COUNT(Words) - 1;
+        FString Comment;
+        Comment.Reserve(Size);
+        for (int32 Index = 0; Index < Size; ++Index)
+        {
+            Comment.AppendChar(Words[(Index + Seed) % WordsLen]);
+        }
+        return Comment;
+    }
+
+    template <typename TField>
+    void SetStressComment(TField* Field, const FStressOptions& Options, int32 Seed)
+    {
+        if (Options.CommentSize > 0)
+        {
+            FLuaTestTypeFactory::SetComment(Field, TEXT("ToolTip"), MakeComment(Options.CommentSize, Seed));
+        }
+    }
+
+    /** 按序号轮流创建int/float/string属性 */
+    FProperty* NewStressProperty(FFieldVariant Owner, const FName& Name, int32 Index)
+    {
+        switch (Index % 3)
+        {
+        case 0:     return new FIntProperty(Owner, Name, RF_Public);
+        case 1:     return new FFloatProperty(Owner, Name, RF_Public);
+        default:    return new FStrProperty(Owner, Name, RF_Public);
+        }
+    }
+
+    /** 给结构体添加属性，倒序添加以保持声明顺序 */
+    void AddStressProperties(UStruct* Struct, const FStressOptions& Options, int32 Seed)
+    {
+        for (int32 Index = Options.MemberCount - 1; Index >= 0; --Index)
+        {
+            FProperty* Property = NewStressProperty(Struct, *FString::Printf(TEXT("Member%d"), Index), Index);
+            SetStressComment(Property, Options, Seed + Index);
+            FLuaTestTypeFactory::AddProperty(Struct, Property, CPF_Edit | CPF_BlueprintVisible);
+        }
+    }
+
+    /** 给类添加可蓝图调用的函数，每个函数一个参数和一个返回值 */
+    void AddStressFunctions(UClass* Class, const FStressOptions& Options, int32 Seed)
+    {
+        for (int32 Index = 0; Index < Options.MemberCount; ++Index)
+        {
+            UFunction* Function = FLuaTestTypeFactory::AddFunction(Class, *FString::Printf(TEXT("Function%d"), Index), FUNC_Public | FUNC_BlueprintCallable);
+            FLuaTestTypeFactory::AddProperty(Function, NewStressProperty(Function, TEXT("ReturnValue"), Index + 1), CPF_Parm | CPF_OutParm | CPF_ReturnParm);
+            FLuaTestTypeFactory::AddProperty(Function, NewStressProperty(Function, TEXT("Value"), Index), CPF_Parm);
+            SetStressComment(Function, Options, Seed + Index);
+            Function->StaticLink(true);
+        }
+    }
+
+    void GenerateNativeTypes(const FStressOptions& Options)
+    {
+        // 合成类型不带CLASS_Native/RF_MarkAsNative，清理时可以安全地GC
+        UPackage* Package = CreatePackage(StressNativePackage);
+        Package->SetFlags(RF_Transient);
+        Package->AddToRoot();
+        StressNativeObjects.Add(Package);
+        if (ULuaExportManager* ExportManager = ULuaExportManager::Get())
+        {
+            FLuaExportTestAccess::AddSyntheticTypePackage(*ExportManager, Package->GetFName());
+        }
+
+        const int32 EnumCount = Options.NativeCount / 10;
+        const int32 StructCount = Options.NativeCount * 3 / 10;
+        const int32 ClassCount = Options.NativeCount - EnumCount - StructCount;
+        const EObjectFlags TypeFlags = RF_Public | RF_Transient;
+
+        UClass* SuperClass = UObject::StaticClass();
+        for (int32 Index = 0; Index < ClassCount; ++Index)
+        {
+            // 每InheritanceDepth个类组成一条继承链
+            if (Index % Options.InheritanceDepth == 0)
+            {
+                SuperClass = UObject::StaticClass();
+            }
+            UClass* Class = FLuaTestTypeFactory::NewClass(Package, *FString::Printf(TEXT("EmmyLuaStressClass%d"), Index), SuperClass);
+            AddStressProperties(Class, Options, Index);
+            AddStressFunctions(Class, Options, Index);
+            SetStressComment(Class, Options, Index);
+            Class->Bind();
+            Class->StaticLink(true);
+            Class->AddToRoot();
+            StressNativeObjects.Add(Class);
+            SuperClass = Class;
+        }
+        for (int32 Index = 0; Index < StructCount; ++Index)
+        {
+            UScriptStruct* Struct = NewObject<UScriptStruct>(Package, *FString::Printf(TEXT("EmmyLuaStressStruct%d"), Index), TypeFlags);
+            AddStressProperties(Struct, Options, Index);
+            SetStressComment(Struct, Options, Index);
+            Struct->Bind();
+            Struct->StaticLink(true);
+            Struct->AddToRoot();
+            StressNativeObjects.Add(Struct);
+        }
+        for (int32 Index = 0; Index < EnumCount; ++Index)
+        {
+            const FString EnumName = FString::Printf(TEXT("EEmmyLuaStressEnum%d"), Index);
+            UEnum* Enum = NewObject<UEnum>(Package, *EnumName, TypeFlags);
+            TArray<TPair<FName, int64>> Names;
+            for (int32 ValueIndex = 0; ValueIndex < FMath::Max(1, Options.MemberCount); ++ValueIndex)
+            {
+                Names.Emplace(*FString::Printf(TEXT("%s::Value%d"), *EnumName, ValueIndex), ValueIndex);
+            }
+            Enum->SetEnums(Names, UEnum::ECppForm::EnumClass);
+            SetStressComment(Enum, Options, Index);
+            Enum->AddToRoot();
+            StressNativeObjects.Add(Enum);
+        }
+        UE_LOG(LogEmmyLuaIntelliSense, Log, TEXT("[STRESS] Generated %d classes, %d structs, %d enums in %s"), ClassCount, StructCount, EnumCount, StressNativePackage);
+    }
+
+    void GenerateBlueprints(const FStressOptions& Options)
+    {
+        if (Options.BlueprintCount > 0 && !bStressMountRegistered)
+        {
+            FPackageName::RegisterMountPoint(StressMountRoot, GetStressContentDir());
+            bStressMountRegistered = true;
+        }
+        FEdGraphPinType PinType;
+        PinType.PinCategory = UEdGraphSchema_K2::PC_Int;
+        UClass* ParentClass = UObject::StaticClass();
+        for (int32 Index = 0; Index < Options.BlueprintCount; ++Index)
+        {
+            if (Index % Options.InheritanceDepth == 0)
+            {
+                ParentClass = UObject::StaticClass();
+            }
+            const FString AssetName = FString::Printf(TEXT("BP_EmmyLuaStress%d"), Index);
+            const FString PackageName = FString::Printf(TEXT("%s/%s"), StressContentPath, *AssetName);
+            UPackage* Package = CreatePackage(*PackageName);
+            UBlueprint* Blueprint = FKismetEditorUtilities::CreateBlueprint(ParentClass, Package, *AssetName, BPTYPE_Normal,
+                UBlueprint::StaticClass(), UBlueprintGeneratedClass::StaticClass());
+            if (!Blueprint)
+            {
+                UE_LOG(LogEmmyLuaIntelliSense, Warning, TEXT("[STRESS] Failed to create blueprint: %s"), *PackageName);
+                continue;
+            }
+            for (int32 MemberIndex = 0; MemberIndex < Options.MemberCount; ++MemberIndex)
+            {
+                const FName VarName = *FString::Printf(TEXT("Var%d_%d"), Index, MemberIndex);
+                FBlueprintEditorUtils::AddMemberVariable(Blueprint, VarName, PinType);
+                if (Options.CommentSize > 0)
+                {
+                    FBlueprintEditorUtils::SetBlueprintVariableMetaData(Blueprint, VarName, nullptr, FBlueprintMetadata::MD_Tooltip, MakeComment(Options.CommentSize, MemberIndex));
+                }
+            }
+            FKismetEditorUtilities::CompileBlueprint(Blueprint);
+            FAssetRegistryModule::AssetCreated(Blueprint);
+            const FString FileName = FPackageName::LongPackageNameToFilename(PackageName, FPackageName::GetAssetPackageExtension());
+            UPackage::SavePackage(Package, Blueprint, RF_Public | RF_Standalone, *FileName);
+            ParentClass = Blueprint->GeneratedClass ? Blueprint->GeneratedClass : UObject::StaticClass();
+        }
+        UE_LOG(LogEmmyLuaIntelliSense, Log, TEXT("[STRESS] Generated %d blueprints in %s"), Options.BlueprintCount, StressContentPath);
+    }
+
+    /** 删除合成的原生类型和蓝图，以及它们已导出的文件 */
+    void ClearStressProject()
+    {
+        if (ULuaExportManager* ExportManager = ULuaExportManager::Get())
+        {
+            ExportManager->ClearPendingChanges();
+            FLuaExportTestAccess::RemoveExportedModule(*ExportManager, StressNativePackage);
+            FLuaExportTestAccess::RemoveSyntheticTypePackage(*ExportManager, StressNativePackage);
+        }
+        const int32 NativeCount = StressNativeObjects.Num();
+        int32 DeletedAssets = 0;
+        if (bStressMountRegistered)
+        {
+            FAssetRegistryModule& AssetRegistryModule = FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry"));
+            TArray<FAssetData> Assets;
+            AssetRegistryModule.Get().GetAssetsByPath(StressContentPath, Assets, true);
+            DeletedAssets = Assets.Num() > 0 ? ObjectTools::DeleteAssets(Assets, false) : 0;
+        }
+
+        FLuaTestTypeFactory::DestroyObjects(StressNativeObjects);
+        if (bStressMountRegistered)
+        {
+            FPackageName::UnRegisterMountPoint(StressMountRoot, GetStressContentDir());
+            bStressMountRegistered = false;
+        }
+        IFileManager::Get().DeleteDirectory(*GetStressContentDir(), false, true);
+        UE_LOG(LogEmmyLuaIntelliSense, Log, TEXT("[STRESS] Cleared %d native objects and %d blueprint assets"), NativeCount, DeletedAssets);
+    }
+
+    /**
+     * 生成合成项目
+     * 用法: EmmyLua.Stress.Generate [Native=N] [Blueprints=M] [Members=K] [Depth=D] [Comment=C]
+     */
+    void RunStressGenerate(const TArray<FString>& Args)
+    {
+        FStressOptions Options;
+        ParseStressOptions(Args, Options);
+        ClearStressProject();
+        GenerateNativeTypes(Options);
+        GenerateBlueprints(Options);
+    }
+
+    /**
+     * 启动异步扫描并在游戏线程上等待它结束（资产注册表扫描、后台分析和主线程提交），返回耗时
+     * 扫描回到游戏线程的任务只能在这里处理，控制台命令返回前不会经过引擎的帧循环
+     */
+    double RunScanToCompletion(ULuaExportManager& ExportManager)
+    {
+        const double StartTime = FPlatformTime::Seconds();
+        ExportManager.ScanExistingAssetsAsync();
+        while (FLuaExportTestAccess::IsAsyncScanningInProgress(ExportManager))
+        {
+            FTaskGraphInterface::Get().ProcessThreadUntilIdle(ENamedThreads::GameThread);
+            FPlatformProcess::Sleep(0.001f);
+        }
+        return FPlatformTime::Seconds() - StartTime;
+    }
+
+    /** 每项耗时比上一个规模增长超过这个倍数时视为非线性增长 */
+    constexpr double MaxPerItemGrowth = 1.5;
+
+    /** 检查每项耗时是否线性增长，非线性时记录错误并返回false */
+    bool CheckLinearScaling(const TCHAR* Phase, double MicrosPerItem, double PreviousMicrosPerItem, int32 ItemCount)
+    {
+        if (PreviousMicrosPerItem > 0.0 && MicrosPerItem > PreviousMicrosPerItem * MaxPerItemGrowth)
+        {
+            UE_LOG(LogEmmyLuaIntelliSense, Error, TEXT("[STRESS] %s per-item cost grew %.1fx at %d items, it is not scaling linearly"),
+                Phase, MicrosPerItem / PreviousMicrosPerItem, ItemCount);
+            return false;
+        }
+        return true;
+    }
+
+    /**
+     * 在多个规模下测量全量和增量导出
+     * 用法: EmmyLua.Stress.Bench [Sizes=1000,10000,100000] [Blueprints=M] [Members=K] [Depth=D] [Comment=C]
+     * 每个规模：生成合成类型 -> 全量导出 -> 扫描（含分析和提交） -> 标记1%的合成类型 -> 增量导出，最后清理
+     * 引擎自身的类型也参与全量导出和扫描，因此比较的是增加的耗时与增加的类型数
+     * 全量导出或扫描的每项耗时非线性增长时记录错误，命令以失败结束
+     * 配合EmmyLua.IO.SimulatedLatencyMs / EmmyLua.IO.SimulatedBandwidthMBps可在慢速存储条件下测量
+     */
+    void RunStressBench(const TArray<FString>& Args)
+    {
+        ULuaExportManager* ExportManager = ULuaExportManager::Get();
+        if (!ExportManager)
+        {
+            return;
+        }
+        FStressOptions Options;
+        ParseStressOptions(Args, Options);
+        TArray<int32> Sizes = { 1000, 10000, 100000 };
+        for (const FString& Arg : Args)
+        {
+            FString Key, SizesValue;
+            if (Arg.Split(TEXT("="), &Key, &SizesValue) && Key.Equals(TEXT("Sizes"), ESearchCase::IgnoreCase))
+            {
+                TArray<FString> SizeStrings;
+                SizesValue.ParseIntoArray(SizeStrings, TEXT(","));
+                Sizes.Reset();
+                for (const FString& SizeString : SizeStrings)
+                {
+                    Sizes.Add(FMath::Max(1, FCString::Atoi(*SizeString)));
+                }
+            }
+        }
+
+        // 先测量不含合成类型时的全量导出和扫描，作为引擎类型的基准
+        ClearStressProject();
+        double StartTime = FPlatformTime::Seconds();
+        ExportManager->ExportAll();
+        const double BaseFullSeconds = FPlatformTime::Seconds() - StartTime;
+        const double BaseScanSeconds = RunScanToCompletion(*ExportManager);
+        UE_LOG(LogEmmyLuaIntelliSense, Log, TEXT("[STRESS] Baseline without synthetic types: full export %.2fs, scan %.2fs"), BaseFullSeconds, BaseScanSeconds);
+
+        double PreviousMicrosPerItem = 0.0;
+        double PreviousScanMicrosPerItem = 0.0;
+        bool bLinear = true;
+        for (const int32 Size : Sizes)
+        {
+            Options.NativeCount = Size;
+            StartTime = FPlatformTime::Seconds();
+            GenerateNativeTypes(Options);
+            GenerateBlueprints(Options);
+            const double GenerateSeconds = FPlatformTime::Seconds() - StartTime;
+            const int32 ItemCount = Size + Options.BlueprintCount;
+
+            StartTime = FPlatformTime::Seconds();
+            ExportManager->ExportAll();
+            const double FullSeconds = FPlatformTime::Seconds() - StartTime;
+            const double ScanSeconds = RunScanToCompletion(*ExportManager);
+
+            // 增量导出：1%的合成原生类型
+            int32 QueuedCount = 0;
+            for (int32 Index = 0; Index < StressNativeObjects.Num(); Index += 100)
+            {
+                if (const UField* Field = Cast<UField>(StressNativeObjects[Index]))
+                {
+                    FLuaExportTestAccess::AddToPendingNativeTypes(*ExportManager, Field);
+                    ++QueuedCount;
+                }
+            }
+            StartTime = FPlatformTime::Seconds();
+            ExportManager->ExportIncremental();
+            const double IncrementalSeconds = FPlatformTime::Seconds() - StartTime;
+
+            const double MicrosPerItem = FMath::Max(FullSeconds - BaseFullSeconds, 0.0) * 1e6 / ItemCount;
+            const double ScanMicrosPerItem = FMath::Max(ScanSeconds - BaseScanSeconds, 0.0) * 1e6 / ItemCount;
+            UE_LOG(LogEmmyLuaIntelliSense, Log, TEXT("[STRESS] %7d items: generate %.2fs, full %.2fs (+%.1f us/item), scan %.2fs (+%.1f us/item), incremental %d types %.2fs"),
+                ItemCount, GenerateSeconds, FullSeconds, MicrosPerItem, ScanSeconds, ScanMicrosPerItem, QueuedCount, IncrementalSeconds);
+            // 线性增长时每项耗时应基本不变
+            bLinear &= CheckLinearScaling(TEXT("Full export"), MicrosPerItem, PreviousMicrosPerItem, ItemCount);
+            bLinear &= CheckLinearScaling(TEXT("Scan"), ScanMicrosPerItem, PreviousScanMicrosPerItem, ItemCount);
+            PreviousMicrosPerItem = MicrosPerItem;
+            PreviousScanMicrosPerItem = ScanMicrosPerItem;
+            ClearStressProject();
+        }
+        if (!bLinear)
+        {
+            UE_LOG(LogEmmyLuaIntelliSense, Error, TEXT("[STRESS] FAILED: export cost grows faster than the project size"));
+            return;
+        }
+        UE_LOG(LogEmmyLuaIntelliSense, Log, TEXT("[STRESS] Done. Per-phase timings of each run are in ExportReport.json / ExportHistory.json"));
+    }
+
+    FAutoConsoleCommand StressGenerateCommand(
+        TEXT("EmmyLua.Stress.Generate"),
+        TEXT("Create transient types and scratch blueprint assets (saved under Intermediate/EmmyLuaStress) for scaling tests. Usage: EmmyLua.Stress.Generate [Native=N] [Blueprints=M] [Members=K] [Depth=D] [Comment=C]"),
+        FConsoleCommandWithArgsDelegate::CreateStatic(&RunStressGenerate));
+
+    FAutoConsoleCommand StressClearCommand(
+        TEXT("EmmyLua.Stress.Clear"),
+        TEXT("Remove the synthetic types and blueprints created by EmmyLua.Stress.Generate, and their exported files"),
+        FConsoleCommandDelegate::CreateStatic(&ClearStressProject));
+
+    FAutoConsoleCommand StressBenchCommand(
+        TEXT("EmmyLua.Stress.Bench"),
+        TEXT("Measure full export, scan and incremental export at several synthetic project sizes; logs an error when per-item cost grows super-linearly. Usage: EmmyLua.Stress.Bench [Sizes=1000,10000,100000] [Blueprints=M] [Members=K] [Depth=D] [Comment=C]"),
+        FConsoleCommandWithArgsDelegate::CreateStatic(&RunStressBench));
+}
@@ -0,0 +1,89 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "LuaExportManager.h"
+
+/**
+ * 自动化测试和压力测试访问ULuaExportManager内部状态的入口
+ * 这些操作只用于测试，不属于导出管理器的公开接口
+ */
+struct FLuaExportTestAccess
+{
+    /** 清空导出哈希缓存，下一次导出会重新生成所有类型 */
+    static void ClearHashCache(ULuaExportManager& Manager)
+    {
+        Manager.ExportedFilesHashCache.Empty();
+        Manager.FieldHashCache.Empty();
+        Manager.FieldHashCacheTimestamp.Empty();
+        Manager.bExportCacheDirty = true;
+    }
+
+    /** 把包中的非原生类型当作原生类型收集（压力测试的合成类型） */
+    static void AddSyntheticTypePackage(ULuaExportManager& Manager, FName PackageName)
+    {
+        Manager.SyntheticTypePackages.Add(PackageName);
+    }
+
+    static void RemoveSyntheticTypePackage(ULuaExportManager& Manager, FName PackageName)
+    {
+        Manager.SyntheticTypePackages.Remove(PackageName);
+    }
+
+    /** 不经过扫描直接把类型加入待导出列表 */
+    static void AddToPendingNativeTypes(ULuaExportManager& Manager, const UField* Field)
+    {
+        Manager.AddToPendingNativeTypes(Field);
+    }
+
+    /** 删除模块已导出的文件和缓存记录 */
+    static void RemoveExportedModule(ULuaExportManager& Manager, const FString& ModuleName)
+    {
+        Manager.RemoveExportedModule(ModuleName);
+    }
+
+    /** 当前待导出的原生类型 */
+    static TArray<const UField*> GetPendingNativeTypes(const ULuaExportManager& Manager)
+    {
+        TArray<const UField*> Types;
+        for (const TWeakObjectPtr<const UField>& Type : Manager.PendingNativeTypes)
+        {
+            if (Type.IsValid())
+            {
+                Types.Add(Type.Get());
+            }
+        }
+        return Types;
+    }
+
+    /** 导出缓存中的记录数 */
+    static int32 GetExportCacheEntryCount(const ULuaExportManager& Manager)
+    {
+        return Manager.ExportedFilesHashCache.Num();
+    }
+
+    /** 上一次导出实际写入的文件数 */
+    static int32 GetWrittenFileCount(const ULuaExportManager& Manager)
+    {
+        return Manager.WrittenFileCount;
+    }
+
+    /** 是否有异步扫描（含后台分析）在进行 */
+    static bool IsAsyncScanningInProgress(const ULuaExportManager& Manager)
+    {
+        return Manager.bIsAsyncScanningInProgress;
+    }
+
+    /** 合并窗口内尚未处理的变更数 */
+    static int32 GetCoalescedChangeCount(const ULuaExportManager& Manager)
+    {
+        return Manager.CoalescedChanges.Num();
+    }
+
+    /** 上一次导出内容未变化而跳过写入的文件数 */
+    static int32 GetUnchangedFileCount(const ULuaExportManager& Manager)
+    {
+        return Manager.UnchangedFileCount;
+    }
+};
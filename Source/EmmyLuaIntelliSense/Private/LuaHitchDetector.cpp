@@ -0,0 +1,107 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "LuaHitchDetector.h"
+#include "EmmyLuaIntelliSense.h"
+#include "EmmyLuaIntelliSenseSettings.h"
+#include "EmmyLuaIntelliSenseStats.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/CoreDelegates.h"
+
+namespace
+{
+    /** 当前帧的累计数据，只在游戏线程上访问 */
+    struct FFrameTimes
+    {
+        TArray<TPair<const TCHAR*, double>, TInlineAllocator<8>>    Phases;             // 阶段名 -> 本帧累计秒数（含嵌套）
+        double                                                      TotalSeconds = 0.0; // 最外层作用域的累计秒数
+        int32                                                       Depth = 0;          // 当前嵌套深度
+    };
+
+    FFrameTimes FrameTimes;
+    FDelegateHandle EndFrameHandle;
+
+    void AddPhaseSeconds(const TCHAR* PhaseName, double Seconds)
+    {
+        for (TPair<const TCHAR*, double>& Phase : FrameTimes.Phases)
+        {
+            if (FCString::Strcmp(Phase.Key, PhaseName) == 0)
+            {
+                Phase.Value += Seconds;
+                return;
+            }
+        }
+        FrameTimes.Phases.Emplace(PhaseName, Seconds);
+    }
+}
+
+FLuaHitchDetector::FScope::FScope(const TCHAR* InPhaseName)
+    : PhaseName(IsInGameThread() ? InPhaseName : nullptr)
+    , StartTime(0.0)
+{
+    if (PhaseName)
+    {
+        ++FrameTimes.Depth;
+        StartTime = FPlatformTime::Seconds();
+    }
+}
+
+FLuaHitchDetector::FScope::~FScope()
+{
+    if (PhaseName)
+    {
+        const double Seconds = FPlatformTime::Seconds() - StartTime;
+        AddPhaseSeconds(PhaseName, Seconds);
+        if (--FrameTimes.Depth == 0)
+        {
+            FrameTimes.TotalSeconds += Seconds;
+        }
+    }
+}
+
+void FLuaHitchDetector::Start()
+{
+    if (!EndFrameHandle.IsValid())
+    {
+        EndFrameHandle = FCoreDelegates::OnEndFrame.AddStatic(&FLuaHitchDetector::OnEndFrame);
+    }
+}
+
+void FLuaHitchDetector::Stop()
+{
+    if (EndFrameHandle.IsValid())
+    {
+        FCoreDelegates::OnEndFrame.Remove(EndFrameHandle);
+        EndFrameHandle.Reset();
+    }
+    FrameTimes.Phases.Reset();
+    FrameTimes.TotalSeconds = 0.0;
+}
+
+void FLuaHitchDetector::OnEndFrame()
+{
+    if (FrameTimes.Phases.Num() == 0)
+    {
+        return;
+    }
+    const UEmmyLuaIntelliSenseSettings* Settings = UEmmyLuaIntelliSenseSettings::Get();
+    const float BudgetMs = Settings ? Settings->GameThreadBudgetMs : 0.0f;
+    const double TotalMs = FrameTimes.TotalSeconds * 1000.0;
+    if (BudgetMs > 0.0f && TotalMs > BudgetMs)
+    {
+        INC_DWORD_STAT(STAT_EmmyLua_HitchFrames);
+        FrameTimes.Phases.Sort([](const TPair<const TCHAR*, double>& A, const TPair<const TCHAR*, double>& B)
+        {
+            return A.Value > B.Value;
+        });
+        FString Breakdown;
+        for (const TPair<const TCHAR*, double>& Phase : FrameTimes.Phases)
+        {
+            Breakdown += FString::Printf(TEXT("%s%s %.2fms"), Breakdown.IsEmpty() ? TEXT("") : TEXT(", "), Phase.Key, Phase.Value * 1000.0);
+        }
+        UE_LOG(LogEmmyLuaIntelliSense, Warning, TEXT("[HITCH] Frame %llu: plugin work took %.2fms on the game thread (budget %.1fms): %s"),
+            (uint64)GFrameCounter, TotalMs, BudgetMs, *Breakdown);
+    }
+    // 作用域跨帧时（如模态进度框内泵消息）保留深度，只清空本帧的累计
+    FrameTimes.Phases.Reset();
+    FrameTimes.TotalSeconds = 0.0;
+}
@@ -0,0 +1,39 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * 插件在游戏线程上的卡顿检测
+ * 累计每帧插件回调占用的游戏线程时间，帧结束时超过设置中的预算就输出警告并列出各阶段耗时，
+ * 用来定位启动后编辑器卡住的原因。只统计游戏线程，其他线程上的作用域不计时
+ */
+class FLuaHitchDetector
+{
+public:
+    /** 游戏线程计时作用域，嵌套的作用域各自列出，但帧总耗时只计最外层 */
+    class FScope
+    {
+    public:
+        explicit FScope(const TCHAR* InPhaseName);
+        ~FScope();
+
+    private:
+        const TCHAR*    PhaseName;      // 阶段名称（静态字符串），不在游戏线程时为空
+        double          StartTime;
+    };
+
+    /** 开始在每帧结束时检查预算 */
+    static void Start();
+
+    /** 停止检查并清空本帧数据 */
+    static void Stop();
+
+private:
+    static void OnEndFrame();
+};
+
+/** 统计作用域内的游戏线程耗时，Name为阶段名 */
+#define EMMYLUA_GAME_THREAD_SCOPE(Name) \
+    FLuaHitchDetector::FScope ANONYMOUS_VARIABLE(HitchScope)(TEXT(#Name))
@@ -0,0 +1,327 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "LuaSymbolIndex.h"
+#include "EmmyLuaIntelliSense.h"
+#include "EmmyLuaIntelliSenseStats.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "HAL/FileManager.h"
+#include "Dom/JsonObject.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/JsonWriter.h"
+#include "Serialization/JsonReader.h"
+#include "Policies/CondensedJsonPrintPolicy.h"
+
+namespace
+{
+    // 索引格式变化时递增，旧索引会被丢弃并重建
+    constexpr int32 SymbolIndexVersion = 1;
+
+    const TCHAR* SymbolKindToString(ELuaSymbolKind Kind)
+    {
+        switch (Kind)
+        {
+        case ELuaSymbolKind::Type:      return TEXT("type");
+        case ELuaSymbolKind::Field:     return TEXT("field");
+        case ELuaSymbolKind::Function:  return TEXT("function");
+        }
+        return TEXT("type");
+    }
+
+    bool SymbolKindFromString(const FString& String, ELuaSymbolKind& OutKind)
+    {
+        if (String == TEXT("type"))
+        {
+            OutKind = ELuaSymbolKind::Type;
+        }
+        else if (String == TEXT("field"))
+        {
+            OutKind = ELuaSymbolKind::Field;
+        }
+        else if (String == TEXT("function"))
+        {
+            OutKind = ELuaSymbolKind::Function;
+        }
+        else
+        {
+            return false;
+        }
+        return true;
+    }
+
+    bool IsIdentifierChar(TCHAR Char)
+    {
+        return FChar::IsAlnum(Char) || Char == TEXT('_');
+    }
+
+    /** 读取从Start开始的标识符 */
+    FString ReadIdentifier(const TCHAR* Start, const TCHAR* End)
+    {
+        const TCHAR* Cursor = Start;
+        while (Cursor < End && IsIdentifierChar(*Cursor))
+        {
+            ++Cursor;
+        }
+        return FString(UE_PTRDIFF_TO_INT32(Cursor - Start), Start);
+    }
+
+    bool StartsWith(const TCHAR* Start, const TCHAR* End, const TCHAR* Prefix, int32 PrefixLen)
+    {
+        return End - Start >= PrefixLen && FCString::Strncmp(Start, Prefix, PrefixLen) == 0;
+    }
+}
+
+void FLuaSymbolIndex::ParseSymbols(const FString& Content, TArray<FLuaSymbolEntry>& OutSymbols)
+{
+    static const TCHAR ClassPrefix[] = TEXT("---@class ");
+    static const TCHAR FieldPrefix[] = TEXT("---@field ");
+    static const TCHAR FunctionPrefix[] = TEXT("function ");
+    constexpr int32 ClassPrefixLen = UE_ARRAY_COUNT(ClassPrefix) - 1;
+    constexpr int32 FieldPrefixLen = UE_ARRAY_COUNT(FieldPrefix) - 1;
+    constexpr int32 FunctionPrefixLen = UE_ARRAY_COUNT(FunctionPrefix) - 1;
+
+    OutSymbols.Reset();
+    FString CurrentOwner;
+    const TCHAR* Cursor = *Content;
+    const TCHAR* ContentEnd = Cursor + Content.Len();
+    int32 Line = 1;
+    while (Cursor < ContentEnd)
+    {
+        const TCHAR* LineEnd = Cursor;
+        while (LineEnd < ContentEnd && *LineEnd != TEXT('\n'))
+        {
+            ++LineEnd;
+        }
+        if (StartsWith(Cursor, LineEnd, ClassPrefix, ClassPrefixLen))
+        {
+            CurrentOwner = ReadIdentifier(Cursor + ClassPrefixLen, LineEnd);
+            if (!CurrentOwner.IsEmpty())
+            {
+                OutSymbols.Add({ CurrentOwner, FString(), ELuaSymbolKind::Type, Line });
+            }
+        }
+        else if (StartsWith(Cursor, LineEnd, FieldPrefix, FieldPrefixLen))
+        {
+            // 跳过可见性修饰（---@field public Name Type）
+            const TCHAR* NameStart = Cursor + FieldPrefixLen;
+            FString Name = ReadIdentifier(NameStart, LineEnd);
+            if ((Name == TEXT("public") || Name == TEXT("protected") || Name == TEXT("private"))
+                && NameStart + Name.Len() < LineEnd && NameStart[Name.Len()] == TEXT(' '))
+            {
+                NameStart += Name.Len() + 1;
+                Name = ReadIdentifier(NameStart, LineEnd);
+            }
+            if (!Name.IsEmpty())
+            {
+                OutSymbols.Add({ MoveTemp(Name), CurrentOwner, ELuaSymbolKind::Field, Line });
+            }
+        }
+        else if (StartsWith(Cursor, LineEnd, FunctionPrefix, FunctionPrefixLen))
+        {
+            const TCHAR* NameStart = Cursor + FunctionPrefixLen;
+            FString First = ReadIdentifier(NameStart, LineEnd);
+            const TCHAR* Separator = NameStart + First.Len();
+            if (Separator < LineEnd && (*Separator == TEXT(':') || *Separator == TEXT('.')))
+            {
+                FString Name = ReadIdentifier(Separator + 1, LineEnd);
+                if (!Name.IsEmpty())
+                {
+                    OutSymbols.Add({ MoveTemp(Name), MoveTemp(First), ELuaSymbolKind::Function, Line });
+                }
+            }
+            else if (!First.IsEmpty())
+            {
+                OutSymbols.Add({ MoveTemp(First), FString(), ELuaSymbolKind::Function, Line });
+            }
+        }
+        Cursor = LineEnd + 1;
+        ++Line;
+    }
+}
+
+bool FLuaSymbolIndex::Load(const FString& InIndexFilePath)
+{
+    EMMYLUA_LLM_SCOPE(SymbolIndex);
+    IndexFilePath = InIndexFilePath;
+    FileSymbols.Empty();
+    bDirty = false;
+    FString JsonString;
+    if (!FFileHelper::LoadFileToString(JsonString, *IndexFilePath))
+    {
+        bDirty = true;
+        return false;
+    }
+    TSharedPtr<FJsonObject> JsonObject;
+    TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(JsonString);
+    int32 Version = 0;
+    const TSharedPtr<FJsonObject>* FilesObject = nullptr;
+    if (!FJsonSerializer::Deserialize(Reader, JsonObject) || !JsonObject.IsValid()
+        || !JsonObject->TryGetNumberField(TEXT("Version"), Version) || Version != SymbolIndexVersion
+        || !JsonObject->TryGetObjectField(TEXT("Files"), FilesObject))
+    {
+        UE_LOG(LogEmmyLuaIntelliSense, Log, TEXT("[INDEX] Symbol index is outdated: %s"), *IndexFilePath);
+        bDirty = true;
+        return false;
+    }
+    // 每个符号保存为 [kind, name, owner, line]
+    for (const auto& FilePair : (*FilesObject)->Values)
+    {
+        const TArray<TSharedPtr<FJsonValue>>* SymbolArray = nullptr;
+        if (!FilePair.Value->TryGetArray(SymbolArray))
+        {
+            continue;
+        }
+        TArray<FLuaSymbolEntry>& Symbols = FileSymbols.Add(FilePair.Key);
+        Symbols.Reserve(SymbolArray->Num());
+        for (const TSharedPtr<FJsonValue>& SymbolValue : *SymbolArray)
+        {
+            const TArray<TSharedPtr<FJsonValue>>* Fields = nullptr;
+            ELuaSymbolKind Kind;
+            if (SymbolValue->TryGetArray(Fields) && Fields->Num() == 4
+                && SymbolKindFromString((*Fields)[0]->AsString(), Kind))
+            {
+                Symbols.Add({ (*Fields)[1]->AsString(), (*Fields)[2]->AsString(), Kind, (int32)(*Fields)[3]->AsNumber() });
+            }
+        }
+    }
+    UE_LOG(LogEmmyLuaIntelliSense, Log, TEXT("[INDEX] Loaded symbol index: %d files, %d symbols"), FileSymbols.Num(), GetSymbolCount());
+    return true;
+}
+
+void FLuaSymbolIndex::Rebuild(const FString& OutputRoot, const TArray<FString>& ExcludedSubdirs)
+{
+    EMMYLUA_LLM_SCOPE(SymbolIndex);
+    const double StartTime = FPlatformTime::Seconds();
+    FileSymbols.Empty();
+    bDirty = true;
+    TArray<FString> Files;
+    IFileManager::Get().FindFilesRecursive(Files, *OutputRoot, TEXT("*.lua"), true, false);
+    Files.Sort();
+    const FString RootPrefix = OutputRoot / TEXT("");
+    for (const FString& File : Files)
+    {
+        FString RelativePath = File;
+        if (!RelativePath.RemoveFromStart(RootPrefix))
+        {
+            continue;
+        }
+        const bool bExcluded = ExcludedSubdirs.ContainsByPredicate([&RelativePath](const FString& Subdir)
+        {
+            return RelativePath.StartsWith(Subdir / TEXT(""));
+        });
+        FString Content;
+        if (bExcluded || !FFileHelper::LoadFileToString(Content, *File))
+        {
+            continue;
+        }
+        TArray<FLuaSymbolEntry> Symbols;
+        ParseSymbols(Content, Symbols);
+        FileSymbols.Add(MoveTemp(RelativePath), MoveTemp(Symbols));
+    }
+    UE_LOG(LogEmmyLuaIntelliSense, Log, TEXT("[INDEX] Rebuilt symbol index from %s: %d files, %d symbols in %.1f ms"),
+        *OutputRoot, FileSymbols.Num(), GetSymbolCount(), (FPlatformTime::Seconds() - StartTime) * 1000.0);
+}
+
+void FLuaSymbolIndex::Save()
+{
+    if (!bDirty || IndexFilePath.IsEmpty())
+    {
+        return;
+    }
+    TSharedPtr<FJsonObject> FilesObject = MakeShareable(new FJsonObject);
+    TArray<FString> SortedFiles;
+    FileSymbols.GetKeys(SortedFiles);
+    SortedFiles.Sort([](const FString& A, const FString& B)
+    {
+        return A.Compare(B, ESearchCase::CaseSensitive) < 0;
+    });
+    for (const FString& File : SortedFiles)
+    {
+        TArray<TSharedPtr<FJsonValue>> SymbolArray;
+        for (const FLuaSymbolEntry& Symbol : FileSymbols[File])
+        {
+            TArray<TSharedPtr<FJsonValue>> Fields;
+            Fields.Add(MakeShareable(new FJsonValueString(SymbolKindToString(Symbol.Kind))));
+            Fields.Add(MakeShareable(new FJsonValueString(Symbol.Name)));
+            Fields.Add(MakeShareable(new FJsonValueString(Symbol.Owner)));
+            Fields.Add(MakeShareable(new FJsonValueNumber(Symbol.Line)));
+            SymbolArray.Add(MakeShareable(new FJsonValueArray(Fields)));
+        }
+        FilesObject->SetArrayField(File, SymbolArray);
+    }
+    TSharedPtr<FJsonObject> JsonObject = MakeShareable(new FJsonObject);
+    JsonObject->SetNumberField(TEXT("Version"), SymbolIndexVersion);
+    JsonObject->SetObjectField(TEXT("Files"), FilesObject);
+    FString JsonString;
+    TSharedRef<TJsonWriter<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>> Writer = TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>::Create(&JsonString);
+    if (!FJsonSerializer::Serialize(JsonObject.ToSharedRef(), Writer))
+    {
+        UE_LOG(LogEmmyLuaIntelliSense, Warning, TEXT("[INDEX] Failed to serialize symbol index"));
+        return;
+    }
+    IFileManager::Get().MakeDirectory(*FPaths::GetPath(IndexFilePath), true);
+    if (FFileHelper::SaveStringToFile(JsonString, *IndexFilePath, FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM))
+    {
+        bDirty = false;
+        UE_LOG(LogEmmyLuaIntelliSense, Log, TEXT("[INDEX] Saved symbol index: %d files, %d symbols"), FileSymbols.Num(), GetSymbolCount());
+    }
+    else
+    {
+        UE_LOG(LogEmmyLuaIntelliSense, Warning, TEXT("[INDEX] Failed to save symbol index to: %s"), *IndexFilePath);
+    }
+}
+
+void FLuaSymbolIndex::UpdateFile(const FString& RelativePath, const FString& Content)
+{
+    EMMYLUA_LLM_SCOPE(SymbolIndex);
+    TArray<FLuaSymbolEntry> Symbols;
+    ParseSymbols(Content, Symbols);
+    TArray<FLuaSymbolEntry>* Existing = FileSymbols.Find(RelativePath);
+    if (Existing && *Existing == Symbols)
+    {
+        return;
+    }
+    FileSymbols.Add(RelativePath, MoveTemp(Symbols));
+    bDirty = true;
+}
+
+void FLuaSymbolIndex::RemoveFile(const FString& RelativePath)
+{
+    if (FileSymbols.Remove(RelativePath) > 0)
+    {
+        bDirty = true;
+    }
+}
+
+void FLuaSymbolIndex::Reset()
+{
+    if (FileSymbols.Num() > 0)
+    {
+        FileSymbols.Empty();
+        bDirty = true;
+    }
+}
+
+int32 FLuaSymbolIndex::GetSymbolCount() const
+{
+    int32 Count = 0;
+    for (const auto& Pair : FileSymbols)
+    {
+        Count += Pair.Value.Num();
+    }
+    return Count;
+}
+
+SIZE_T FLuaSymbolIndex::GetAllocatedSize() const
+{
+    SIZE_T Size = IndexFilePath.GetAllocatedSize() + FileSymbols.GetAllocatedSize();
+    for (const auto& Pair : FileSymbols)
+    {
+        Size += Pair.Key.GetAllocatedSize() + Pair.Value.GetAllocatedSize();
+        for (const FLuaSymbolEntry& Entry : Pair.Value)
+        {
+            Size += Entry.Name.GetAllocatedSize() + Entry.Owner.GetAllocatedSize();
+        }
+    }
+    return Size;
+}
@@ -0,0 +1,83 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/Class.h"
+#include "UObject/UnrealType.h"
+#include "UObject/UObjectGlobals.h"
+
+/**
+ * 金标准测试和压力测试共用的反射类型构造
+ * 构造的类型不带原生标记（CLASS_Native/RF_MarkAsNative），用DestroyObjects清理后可以安全地GC
+ * AddProperty和AddFunction都插入到链表头部，需要按声明顺序的逆序调用
+ */
+struct FLuaTestTypeFactory
+{
+    /** 设置注释元数据，Key为"Comment"或"ToolTip" */
+    static void SetComment(UField* Field, const TCHAR* Key, const FString& Comment)
+    {
+#if WITH_METADATA
+        Field->SetMetaData(Key, *Comment);
+#endif
+    }
+
+    static void SetComment(FProperty* Property, const TCHAR* Key, const FString& Comment)
+    {
+#if WITH_METADATA
+        Property->SetMetaData(Key, *Comment);
+#endif
+    }
+
+    /** 创建继承SuperClass的类，调用方添加成员后Bind并StaticLink */
+    static UClass* NewClass(UObject* Outer, const FName& Name, UClass* SuperClass)
+    {
+        UClass* Class = NewObject<UClass>(Outer, Name, RF_Public | RF_Transient);
+        Class->SetSuperStruct(SuperClass);
+        Class->ClassFlags |= CLASS_Transient;
+        Class->ClassCastFlags = SuperClass->ClassCastFlags;
+        Class->ClassWithin = SuperClass->ClassWithin;
+        Class->ClassConfigName = SuperClass->ClassConfigName;
+        return Class;
+    }
+
+    /** 把已创建的属性加到Owner（结构体、类或函数参数）上 */
+    static FProperty* AddProperty(UStruct* Owner, FProperty* Property, EPropertyFlags Flags)
+    {
+        Property->SetPropertyFlags(Flags);
+        Owner->AddCppProperty(Property);
+        return Property;
+    }
+
+    template <typename TProperty>
+    static TProperty* AddProperty(UStruct* Owner, const FName& Name, EPropertyFlags Flags)
+    {
+        TProperty* Property = new TProperty(Owner, Name, RF_Public);
+        AddProperty(Owner, Property, Flags);
+        return Property;
+    }
+
+    /** 创建函数并挂到类的Children和函数表上，调用方添加参数后StaticLink */
+    static UFunction* AddFunction(UClass* Class, const FName& Name, EFunctionFlags Flags)
+    {
+        UFunction* Function = NewObject<UFunction>(Class, Name, RF_Public | RF_Transient);
+        Function->FunctionFlags = Flags;
+        Function->Next = Class->Children;
+        Class->Children = Function;
+        Class->AddFunctionToFunctionMap(Function, Function->GetFName());
+        return Function;
+    }
+
+    /** 解除Root并回收构造的对象 */
+    static void DestroyObjects(TArray<UObject*>& Objects)
+    {
+        for (UObject* Object : Objects)
+        {
+            Object->RemoveFromRoot();
+            Object->ClearFlags(RF_Public | RF_Standalone);
+            Object->MarkPendingKill();
+        }
+        Objects.Empty();
+        CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+    }
+};
@@ -0,0 +1,215 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "LuaThrottledPlatformFile.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformProcess.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/ScopeLock.h"
+#include "Templates/UniquePtr.h"
+
+namespace
+{
+    TAutoConsoleVariable<float> CVarSimulatedLatencyMs(
+        TEXT("EmmyLua.IO.SimulatedLatencyMs"),
+        0.0f,
+        TEXT("Testing only: add this many milliseconds to every file operation of the Lua export pipeline. 0 disables"));
+
+    TAutoConsoleVariable<float> CVarSimulatedBandwidthMBps(
+        TEXT("EmmyLua.IO.SimulatedBandwidthMBps"),
+        0.0f,
+        TEXT("Testing only: limit reads and writes of the Lua export pipeline to this many MB/s, shared by all threads. 0 disables"));
+
+    /** 读写时按带宽限速的文件句柄，句柄随包装一起释放 */
+    class FLuaThrottledFileHandle : public IFileHandle
+    {
+    public:
+        FLuaThrottledFileHandle(IFileHandle* InHandle, FLuaThrottledPlatformFile& InPlatformFile)
+            : Handle(InHandle)
+            , PlatformFile(InPlatformFile)
+        {
+        }
+
+        virtual int64 Tell() override { return Handle->Tell(); }
+        virtual bool Seek(int64 NewPosition) override { return Handle->Seek(NewPosition); }
+        virtual bool SeekFromEnd(int64 NewPositionRelativeToEnd = 0) override { return Handle->SeekFromEnd(NewPositionRelativeToEnd); }
+        virtual bool Flush(const bool bFullFlush = false) override { return Handle->Flush(bFullFlush); }
+        virtual bool Truncate(int64 NewSize) override { return Handle->Truncate(NewSize); }
+        virtual int64 Size() override { return Handle->Size(); }
+
+        virtual bool Read(uint8* Destination, int64 BytesToRead) override
+        {
+            PlatformFile.SimulateLatency();
+            PlatformFile.SimulateTransfer(BytesToRead);
+            return Handle->Read(Destination, BytesToRead);
+        }
+
+        virtual bool Write(const uint8* Source, int64 BytesToWrite) override
+        {
+            PlatformFile.SimulateLatency();
+            PlatformFile.SimulateTransfer(BytesToWrite);
+            return Handle->Write(Source, BytesToWrite);
+        }
+
+    private:
+        TUniquePtr<IFileHandle>         Handle;
+        FLuaThrottledPlatformFile&      PlatformFile;
+    };
+}
+
+FLuaThrottledPlatformFile::FLuaThrottledPlatformFile()
+    : LowerLevel(nullptr)
+    , BusyUntil(0.0)
+{
+}
+
+bool FLuaThrottledPlatformFile::IsThrottling()
+{
+    return CVarSimulatedLatencyMs.GetValueOnAnyThread() > 0.0f || CVarSimulatedBandwidthMBps.GetValueOnAnyThread() > 0.0f;
+}
+
+void FLuaThrottledPlatformFile::SimulateLatency() const
+{
+    const float LatencyMs = CVarSimulatedLatencyMs.GetValueOnAnyThread();
+    if (LatencyMs > 0.0f)
+    {
+        FPlatformProcess::Sleep(LatencyMs * 0.001f);
+    }
+}
+
+void FLuaThrottledPlatformFile::SimulateTransfer(int64 Bytes)
+{
+    const float BandwidthMBps = CVarSimulatedBandwidthMBps.GetValueOnAnyThread();
+    if (BandwidthMBps <= 0.0f || Bytes <= 0)
+    {
+        return;
+    }
+    // 在共享的设备时间线上排队：并发的传输依次占用带宽，而不是各自独享
+    double FinishTime;
+    {
+        FScopeLock ScopeLock(&TransferLock);
+        const double StartTime = FMath::Max(FPlatformTime::Seconds(), BusyUntil);
+        BusyUntil = StartTime + double(Bytes) / (double(BandwidthMBps) * 1024.0 * 1024.0);
+        FinishTime = BusyUntil;
+    }
+    const double WaitSeconds = FinishTime - FPlatformTime::Seconds();
+    if (WaitSeconds > 0.0)
+    {
+        FPlatformProcess::Sleep(float(WaitSeconds));
+    }
+}
+
+bool FLuaThrottledPlatformFile::Initialize(IPlatformFile* Inner, const TCHAR* CmdLine)
+{
+    LowerLevel = Inner;
+    return LowerLevel != nullptr;
+}
+
+bool FLuaThrottledPlatformFile::FileExists(const TCHAR* Filename)
+{
+    SimulateLatency();
+    return LowerLevel->FileExists(Filename);
+}
+
+int64 FLuaThrottledPlatformFile::FileSize(const TCHAR* Filename)
+{
+    SimulateLatency();
+    return LowerLevel->FileSize(Filename);
+}
+
+bool FLuaThrottledPlatformFile::DeleteFile(const TCHAR* Filename)
+{
+    SimulateLatency();
+    return LowerLevel->DeleteFile(Filename);
+}
+
+bool FLuaThrottledPlatformFile::IsReadOnly(const TCHAR* Filename)
+{
+    SimulateLatency();
+    return LowerLevel->IsReadOnly(Filename);
+}
+
+bool FLuaThrottledPlatformFile::MoveFile(const TCHAR* To, const TCHAR* From)
+{
+    SimulateLatency();
+    return LowerLevel->MoveFile(To, From);
+}
+
+bool FLuaThrottledPlatformFile::SetReadOnly(const TCHAR* Filename, bool bNewReadOnlyValue)
+{
+    SimulateLatency();
+    return LowerLevel->SetReadOnly(Filename, bNewReadOnlyValue);
+}
+
+FDateTime FLuaThrottledPlatformFile::GetTimeStamp(const TCHAR* Filename)
+{
+    SimulateLatency();
+    return LowerLevel->GetTimeStamp(Filename);
+}
+
+void FLuaThrottledPlatformFile::SetTimeStamp(const TCHAR* Filename, FDateTime DateTime)
+{
+    SimulateLatency();
+    LowerLevel->SetTimeStamp(Filename, DateTime);
+}
+
+FDateTime FLuaThrottledPlatformFile::GetAccessTimeStamp(const TCHAR* Filename)
+{
+    SimulateLatency();
+    return LowerLevel->GetAccessTimeStamp(Filename);
+}
+
+FString FLuaThrottledPlatformFile::GetFilenameOnDisk(const TCHAR* Filename)
+{
+    SimulateLatency();
+    return LowerLevel->GetFilenameOnDisk(Filename);
+}
+
+IFileHandle* FLuaThrottledPlatformFile::OpenRead(const TCHAR* Filename, bool bAllowWrite)
+{
+    SimulateLatency();
+    IFileHandle* Handle = LowerLevel->OpenRead(Filename, bAllowWrite);
+    return Handle ? new FLuaThrottledFileHandle(Handle, *this) : nullptr;
+}
+
+IFileHandle* FLuaThrottledPlatformFile::OpenWrite(const TCHAR* Filename, bool bAppend, bool bAllowRead)
+{
+    SimulateLatency();
+    IFileHandle* Handle = LowerLevel->OpenWrite(Filename, bAppend, bAllowRead);
+    return Handle ? new FLuaThrottledFileHandle(Handle, *this) : nullptr;
+}
+
+bool FLuaThrottledPlatformFile::DirectoryExists(const TCHAR* Directory)
+{
+    SimulateLatency();
+    return LowerLevel->DirectoryExists(Directory);
+}
+
+bool FLuaThrottledPlatformFile::CreateDirectory(const TCHAR* Directory)
+{
+    SimulateLatency();
+    return LowerLevel->CreateDirectory(Directory);
+}
+
+bool FLuaThrottledPlatformFile::DeleteDirectory(const TCHAR* Directory)
+{
+    SimulateLatency();
+    return LowerLevel->DeleteDirectory(Directory);
+}
+
+FFileStatData FLuaThrottledPlatformFile::GetStatData(const TCHAR* FilenameOrDirectory)
+{
+    SimulateLatency();
+    return LowerLevel->GetStatData(FilenameOrDirectory);
+}
+
+bool FLuaThrottledPlatformFile::IterateDirectory(const TCHAR* Directory, FDirectoryVisitor& Visitor)
+{
+    SimulateLatency();
+    return LowerLevel->IterateDirectory(Directory, Visitor);
+}
+
+bool FLuaThrottledPlatformFile::IterateDirectoryStat(const TCHAR* Directory, FDirectoryStatVisitor& Visitor)
+{
+    SimulateLatency();
+    return LowerLevel->IterateDirectoryStat(Directory, Visitor);
+}
@@ -0,0 +1,63 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GenericPlatform/GenericPlatformFile.h"
+#include "HAL/CriticalSection.h"
+
+/**
+ * 模拟慢速存储的文件层，仅用于测试
+ * 按控制台变量给每次文件操作加上固定延迟，并按设定带宽限制读写速度，
+ * 用来在快速的本机磁盘上复现网络盘、机械盘上的导出耗时：
+ *   EmmyLua.IO.SimulatedLatencyMs      每次打开、查询、读写、目录操作的延迟（毫秒）
+ *   EmmyLua.IO.SimulatedBandwidthMBps  读写带宽上限（MB/s），所有线程共享
+ * 只有其中一个不为0时导出管理器才把这一层接入文件链（每轮导出开始时检查）。
+ * 延迟在多个线程之间可以重叠，带宽是整块设备共享的，因此并行和合并写入的收益可以在这一层上直接观察到
+ */
+class FLuaThrottledPlatformFile : public IPlatformFile
+{
+public:
+    FLuaThrottledPlatformFile();
+
+    /** 是否启用了延迟或带宽模拟 */
+    static bool IsThrottling();
+
+    /** 模拟一次请求的延迟 */
+    void SimulateLatency() const;
+
+    /** 模拟传输Bytes字节，按共享带宽排队等待 */
+    void SimulateTransfer(int64 Bytes);
+
+    // Begin IPlatformFile
+    using IPlatformFile::IterateDirectory;
+    using IPlatformFile::IterateDirectoryStat;
+    virtual bool Initialize(IPlatformFile* Inner, const TCHAR* CmdLine) override;
+    virtual IPlatformFile* GetLowerLevel() override { return LowerLevel; }
+    virtual void SetLowerLevel(IPlatformFile* NewLowerLevel) override { LowerLevel = NewLowerLevel; }
+    virtual const TCHAR* GetName() const override { return TEXT("LuaThrottledPlatformFile"); }
+    virtual bool FileExists(const TCHAR* Filename) override;
+    virtual int64 FileSize(const TCHAR* Filename) override;
+    virtual bool DeleteFile(const TCHAR* Filename) override;
+    virtual bool IsReadOnly(const TCHAR* Filename) override;
+    virtual bool MoveFile(const TCHAR* To, const TCHAR* From) override;
+    virtual bool SetReadOnly(const TCHAR* Filename, bool bNewReadOnlyValue) override;
+    virtual FDateTime GetTimeStamp(const TCHAR* Filename) override;
+    virtual void SetTimeStamp(const TCHAR* Filename, FDateTime DateTime) override;
+    virtual FDateTime GetAccessTimeStamp(const TCHAR* Filename) override;
+    virtual FString GetFilenameOnDisk(const TCHAR* Filename) override;
+    virtual IFileHandle* OpenRead(const TCHAR* Filename, bool bAllowWrite = false) override;
+    virtual IFileHandle* OpenWrite(const TCHAR* Filename, bool bAppend = false, bool bAllowRead = false) override;
+    virtual bool DirectoryExists(const TCHAR* Directory) override;
+    virtual bool CreateDirectory(const TCHAR* Directory) override;
+    virtual bool DeleteDirectory(const TCHAR* Directory) override;
+    virtual FFileStatData GetStatData(const TCHAR* FilenameOrDirectory) override;
+    virtual bool IterateDirectory(const TCHAR* Directory, FDirectoryVisitor& Visitor) override;
+    virtual bool IterateDirectoryStat(const TCHAR* Directory, FDirectoryStatVisitor& Visitor) override;
+    // End IPlatformFile
+
+private:
+    IPlatformFile*      LowerLevel;         // 实际执行文件操作的平台文件
+    FCriticalSection    TransferLock;       // 保护BusyUntil
+    double              BusyUntil;          // 模拟设备上一次传输结束的时间
+};
@@ -27,4 +27,5 @@ private:
 
 private:
     bool            bIsInitialized = false;                                     // 防止多次初始化的标志
+    FDelegateHandle PostGarbageCollectHandle;                                   // GC后清空生成器缓存
 };
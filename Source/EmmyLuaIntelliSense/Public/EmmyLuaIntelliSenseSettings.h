@@ -6,6 +6,50 @@
 #include "Engine/DeveloperSettings.h"
 #include "EmmyLuaIntelliSenseSettings.generated.h"
 
+/**
+ * 原生类型的输出布局
+ */
+UENUM()
+enum class EEmmyLuaOutputLayout : uint8
+{
+    // 每个类型一个文件：<OutputDir>/<PackageName>/<TypeName>.lua
+    PerType     UMETA(DisplayName = "One File Per Type"),
+    // 每个模块一个文件（超过大小上限时按块拆分）：<OutputDir>/<PackageName>.lua
+    PerModule   UMETA(DisplayName = "One File Per Module"),
+};
+
+/**
+ * 输出内容配置，控制生成文件的详细程度
+ */
+UENUM()
+enum class EEmmyLuaOutputProfile : uint8
+{
+    // 完整输出：所有属性和函数，带注释
+    Full            UMETA(DisplayName = "Full"),
+    // 与完整输出相同，但不输出注释
+    NoComments      UMETA(DisplayName = "No Comments"),
+    // 只输出蓝图可读的属性和蓝图可调用的函数，带注释
+    BlueprintOnly   UMETA(DisplayName = "BlueprintReadable / BlueprintCallable Only"),
+    // 只输出类型声明、枚举值和函数签名，不输出属性和注释
+    SignaturesOnly  UMETA(DisplayName = "Signatures Only"),
+};
+
+/**
+ * 注解方言，每种方言输出到独立的目录
+ */
+UENUM(meta = (Bitflags))
+enum class EEmmyLuaDialect : uint8
+{
+    // EmmyLua注解，始终导出：<OutputDir>
+    EmmyLua     UMETA(Hidden),
+    // sumneko LuaLS注解：<OutputDir>_LuaLS
+    LuaLS       UMETA(DisplayName = "LuaLS (sumneko)"),
+    // UnLua IntelliSense格式：<OutputDir>_UnLua
+    UnLua       UMETA(DisplayName = "UnLua"),
+
+    Count       UMETA(Hidden),
+};
+
 /**
  * EmmyLua IntelliSense 插件设置
  */
@@ -35,6 +79,62 @@ public:
                 ToolTip = "Only export files that have been modified since last export"))
     bool bEnableIncrementalExport = true;
     
+    // 原生类型的输出布局
+    UPROPERTY(EditAnywhere, config, Category = "Export Settings", 
+        meta = (DisplayName = "Output Layout", 
+                ToolTip = "Write one annotation file per native type, or bundle each module into one file (fewer files for the IDE to index)"))
+    EEmmyLuaOutputLayout OutputLayout = EEmmyLuaOutputLayout::PerType;
+    
+    // 模块打包文件的大小上限（KB），超过后拆分为多个块
+    UPROPERTY(EditAnywhere, config, Category = "Export Settings", 
+        meta = (DisplayName = "Max Bundle Size (KB)", 
+                ToolTip = "Split a module bundle into chunks no larger than this size. 0 means no limit",
+                ClampMin = "0",
+                EditCondition = "OutputLayout == EEmmyLuaOutputLayout::PerModule"))
+    int32 MaxBundleSizeKB = 1024;
+    
+    // 输出内容配置
+    UPROPERTY(EditAnywhere, config, Category = "Export Settings", 
+        meta = (DisplayName = "Output Profile", 
+                ToolTip = "How much to emit per type. Compact profiles produce much smaller output for the IDE to index"))
+    EEmmyLuaOutputProfile OutputProfile = EEmmyLuaOutputProfile::Full;
+    
+    // 除EmmyLua外同时导出的注解方言（同一次遍历渲染所有方言）
+    UPROPERTY(EditAnywhere, config, Category = "Export Settings", 
+        meta = (DisplayName = "Additional Dialects", 
+                ToolTip = "Also render these annotation dialects, each into its own output directory, from the same reflection pass",
+                Bitmask, BitmaskEnum = "EEmmyLuaDialect"))
+    int32 AdditionalDialects = 0;
+
+    // 是否监听编辑时的蓝图/模块变更（录制变更事件期间总是监听）
+    UPROPERTY(EditAnywhere, config, Category = "Export Settings", 
+        meta = (DisplayName = "Watch Editor Changes", 
+                ToolTip = "Queue changed blueprints and modules for export while editing. Changes are always captured while EmmyLua.Record.Start is active"))
+    bool bWatchEditorChanges = false;
+
+    // 编辑时蓝图/模块变更后是否自动增量导出
+    UPROPERTY(EditAnywhere, config, Category = "Export Settings", 
+        meta = (DisplayName = "Auto Export On Change", 
+                ToolTip = "Export changed blueprints and modules automatically, without a progress dialog. Requires Watch Editor Changes. Bursts of changes (Save All, Compile All Blueprints) are merged into one incremental export"))
+    bool bAutoExportOnChange = false;
+    
+    // 变更静默多少秒后处理合并的批次
+    UPROPERTY(EditAnywhere, config, Category = "Export Settings", 
+        meta = (DisplayName = "Change Quiet Period (s)", 
+                ToolTip = "Process a batch of changes once no new change has arrived for this long",
+                ClampMin = "0.1"))
+    float ChangeQuiescenceSeconds = 1.0f;
+    
+    // 合并批次最长等待时间（秒），持续有变更时也会在此时间后处理
+    UPROPERTY(EditAnywhere, config, Category = "Export Settings", 
+        meta = (DisplayName = "Change Max Delay (s)", 
+                ToolTip = "Process a batch of changes at most this long after its first change, even if changes keep arriving",
+                ClampMin = "0.1"))
+    float ChangeMaxDelaySeconds = 10.0f;
+
+    // 获取启用的方言掩码（EmmyLua始终启用）
+    uint32 GetEnabledDialectMask() const;
+    
     // 是否在启动时显示导出通知
     UPROPERTY(EditAnywhere, config, Category = "UI Settings", 
         meta = (DisplayName = "Show Export Notification on Startup", 
@@ -60,6 +160,27 @@ public:
                 ToolTip = "Enable detailed logging for debugging export issues"))
     bool bEnableVerboseLogging = false;
 
+    // 阶段耗时超过历史基线多少倍时提示性能退化
+    UPROPERTY(EditAnywhere, config, Category = "Debug Settings",
+        meta = (DisplayName = "Performance Regression Threshold",
+                ToolTip = "Warn when an export phase takes longer than this multiple of its recent median. 0 disables the check",
+                ClampMin = "0.0"))
+    float PerfRegressionThreshold = 3.0f;
+
+    // 计算历史基线所用的天数
+    UPROPERTY(EditAnywhere, config, Category = "Debug Settings",
+        meta = (DisplayName = "Performance Baseline Days",
+                ToolTip = "Number of days of export history used to compute the median baseline",
+                ClampMin = "1", ClampMax = "30"))
+    int32 PerfBaselineDays = 7;
+
+    // 插件每帧占用游戏线程的时间预算（毫秒）
+    UPROPERTY(EditAnywhere, config, Category = "Debug Settings",
+        meta = (DisplayName = "Game Thread Budget (ms)",
+                ToolTip = "Log a warning, naming the responsible phases, for every frame in which plugin work takes longer than this on the game thread. 0 disables",
+                ClampMin = "0.0"))
+    float GameThreadBudgetMs = 4.0f;
+
     // Begin UDeveloperSettings
     virtual FName GetCategoryName() const override;
     virtual FText GetSectionText() const override;
@@ -0,0 +1,82 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/** 编辑器变更事件类型 */
+enum class ELuaChangeEventType : uint8
+{
+    AssetAdded,             // 新增蓝图资源
+    AssetUpdated,           // 蓝图资源保存
+    AssetRenamed,           // 蓝图资源重命名或移动（OldPath为原路径）
+    AssetRemoved,           // 蓝图资源删除
+    BlueprintCompiled,      // 蓝图编译（未保存时资源文件不变）
+    ModuleLoaded,           // 模块加载（Path为 /Script/<Module>）
+    ModuleUnloaded,         // 模块卸载
+    Count
+};
+
+/** 单个变更事件，所有编辑器回调都转换为事件后交给导出管理器处理 */
+struct FLuaChangeEvent
+{
+    ELuaChangeEventType     Type = ELuaChangeEventType::AssetUpdated;
+    FString                 Path;           // 蓝图对象路径或模块包名
+    FString                 OldPath;        // 重命名前的对象路径
+    double                  Time = 0.0;     // 相对录制开始的秒数
+
+    FLuaChangeEvent() = default;
+    FLuaChangeEvent(ELuaChangeEventType InType, const FString& InPath, const FString& InOldPath = FString())
+        : Type(InType), Path(InPath), OldPath(InOldPath)
+    {
+    }
+
+    static const TCHAR* GetTypeName(ELuaChangeEventType Type);
+    static bool ParseTypeName(const FString& Name, ELuaChangeEventType& OutType);
+};
+
+/** 变更事件合并批次的累计统计 */
+struct FLuaChangeBatchStats
+{
+    int32   Batches = 0;            // 已处理的批次数
+    int32   Events = 0;             // 收到的原始事件数
+    int32   Changes = 0;            // 合并后实际处理的事件数
+    int32   Exports = 0;            // 批次触发的增量导出次数
+    double  ExportSeconds = 0.0;    // 增量导出总耗时
+    double  MaxExportSeconds = 0.0; // 单次增量导出最长耗时
+};
+
+/**
+ * 变更事件录制
+ * 把一次编辑会话的变更事件逐条追加到JSON Lines文件（每行一个事件），
+ * 之后可以用 EmmyLua.Replay 在测试工程上按原有时间间隔重放，复现真实编辑模式下的增量导出工作量
+ */
+class EMMYLUAINTELLISENSE_API FLuaChangeRecorder
+{
+public:
+    ~FLuaChangeRecorder();
+
+    /** 开始录制到文件（覆盖已有文件），已在录制时先结束上一段 */
+    bool Start(const FString& InFilePath);
+
+    /** 结束录制 */
+    void Stop();
+
+    /** 是否正在录制 */
+    bool IsRecording() const { return Writer.IsValid(); }
+
+    /** 录制文件路径，未录制时为空 */
+    const FString& GetFilePath() const { return FilePath; }
+
+    /** 追加一个事件，Time由录制器填写；未录制时忽略 */
+    void Record(const FLuaChangeEvent& Event);
+
+    /** 读取录制文件，无法解析的行会被跳过 */
+    static bool Load(const FString& InFilePath, TArray<FLuaChangeEvent>& OutEvents);
+
+private:
+    TUniquePtr<FArchive>    Writer;             // 录制文件写入器
+    FString                 FilePath;           // 录制文件路径
+    double                  StartTime = 0.0;    // 开始录制的时间
+    int32                   EventCount = 0;     // 已录制的事件数
+};
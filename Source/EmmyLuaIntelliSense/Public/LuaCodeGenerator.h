@@ -4,6 +4,9 @@
 
 #include "CoreMinimal.h"
 #include "Engine/Blueprint.h"
+#include "Containers/StaticArray.h"
+#include "EmmyLuaIntelliSenseSettings.h"
+#include "LuaTypeDescriptor.h"
 
 #ifndef LUACODEGENERATOR_H_INCLUDED
 #define LUACODEGENERATOR_H_INCLUDED
@@ -13,24 +16,37 @@
 #undef FLuaCodeGenerator
 #endif
 
+/** 各方言的渲染结果，按EEmmyLuaDialect索引 */
+using FLuaDialectCode = TStaticArray<FString, static_cast<uint32>(EEmmyLuaDialect::Count)>;
+
 /**
  * Lua代码生成器
- * 负责将UE反射信息转换为Lua代码
+ * 负责将UE反射信息转换为Lua代码：先遍历反射信息生成与方言无关的FLuaTypeDescriptor，
+ * 再由各方言的输出策略渲染，新增方言只需增加渲染，不需要再次遍历
  */
 class EMMYLUAINTELLISENSE_API FEmmyLuaCodeGenerator
 {
 public:
+    /**
+     * 遍历一次类型（蓝图、类、结构体或枚举），渲染DialectMask中启用的所有方言
+     * 结果写入OutCode对应方言的槽位，未启用的方言为空；类型无效时返回false
+     */
+    static bool GenerateType(const UObject* Type, uint32 DialectMask, bool bEmitReturn, FLuaDialectCode& OutCode);
+
+    /** 方言的文件头，模块打包时每个文件输出一次 */
+    static FString GetFilePrologue(EEmmyLuaDialect Dialect);
+
     /** 生成蓝图的Lua代码 */
     static FString GenerateBlueprint(const UBlueprint* Blueprint);
 
-    /** 生成类的Lua代码 */
-    static FString GenerateClass(const UClass* Class);
+    /** 生成类的Lua代码（bEmitReturn为false时不输出结尾的return语句，用于模块打包） */
+    static FString GenerateClass(const UClass* Class, bool bEmitReturn = true);
 
-    /** 生成结构体的Lua代码 */
-    static FString GenerateStruct(const UScriptStruct* Struct);
+    /** 生成结构体的Lua代码（bEmitReturn同上） */
+    static FString GenerateStruct(const UScriptStruct* Struct, bool bEmitReturn = true);
 
-    /** 生成枚举的Lua代码 */
-    static FString GenerateEnum(const UEnum* Enum);
+    /** 生成枚举的Lua代码（bEmitReturn同上） */
+    static FString GenerateEnum(const UEnum* Enum, bool bEmitReturn = true);
 
     /** 生成函数的Lua代码 */
     static FString GenerateFunction(const UFunction* Function, const FString& ClassName = "");
@@ -62,6 +78,9 @@ public:
     /** 转义符号名称 */
     static FString EscapeSymbolName(const FString& Name);
 
+    /** 转义符号名称（原地处理，合法标识符不产生额外分配） */
+    static FString EscapeSymbolName(FString&& Name);
+
     /** 检查函数是否有效 */
     static bool IsValidFunction(const UFunction* Function);
 
@@ -77,21 +96,31 @@ public:
     /** 检查属性是否应该跳过 */
     static bool ShouldSkipProperty(const FProperty* Property);
 
+    /** 清空导出过程中共享的缓存（类型名称驻留表等），每次导出开始时调用 */
+    static void ResetExportCaches();
+
+    /** GC之后清空以对象指针为键的类型名称缓存（分帧导出跨帧时对象地址可能被复用） */
+    static void OnPostGarbageCollect();
+
 private:
-    /** 生成类属性的Lua代码 */
-    static void GenerateClassProperties(const UClass* Class, FString& Code);
-    
-    /** 生成类函数的Lua代码 */
-    static void GenerateClassFunctions(const UClass* Class, FString& Code);
+    /** 从反射信息生成类型描述 */
+    static bool BuildTypeDescriptor(const UObject* Type, FLuaTypeDescriptor& Desc);
+    static bool BuildBlueprintDescriptor(const UBlueprint* Blueprint, FLuaTypeDescriptor& Desc);
+    static bool BuildClassDescriptor(const UClass* Class, FLuaTypeDescriptor& Desc);
+    static bool BuildStructDescriptor(const UScriptStruct* Struct, FLuaTypeDescriptor& Desc);
+    static bool BuildEnumDescriptor(const UEnum* Enum, FLuaTypeDescriptor& Desc);
+
+    /** 收集类自身声明的属性（受输出内容配置限制） */
+    static void CollectClassProperties(const UClass* Class, FLuaTypeDescriptor& Desc);
     
-    /** 生成蓝图特定的Lua代码 */
-    static void GenerateBlueprintSpecific(const UBlueprint* Blueprint, FString& Code);
+    /** 收集类自身声明的函数（受输出内容配置限制） */
+    static void CollectClassFunctions(const UClass* Class, FLuaTypeDescriptor& Desc);
 
-    /** 生成属性的Lua代码 */
-    static void GenerateProperty(const FProperty* Property, FString& Code);
+    /** 生成属性描述（bIncludeComment为false时不读取注释元数据） */
+    static void BuildFieldDescriptor(const FProperty* Property, FLuaFieldDescriptor& Field, bool bIncludeComment);
 
-    /** 生成函数的Lua代码 */
-    static void GenerateFunction(const UFunction* Function, FString& Code, const FString& ClassName = "");
+    /** 生成函数描述（bIncludeComment同上） */
+    static void BuildFunctionDescriptor(const UFunction* Function, FLuaFunctionDescriptor& FunctionDesc, bool bIncludeComment);
 };
 
 #endif // LUACODEGENERATOR_H_INCLUDED
\ No newline at end of file
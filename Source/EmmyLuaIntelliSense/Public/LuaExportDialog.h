@@ -51,6 +51,9 @@ public:
     /** 显示导出失败通知 */
     static TSharedPtr<SNotificationItem> ShowExportFailure(const FString& Message);
 
+    /** 显示导出性能退化警告 */
+    static TSharedPtr<SNotificationItem> ShowPerformanceWarning(const FString& Message);
+
     /** 导出确认回调 */
     static void OnExportConfirmed();
 
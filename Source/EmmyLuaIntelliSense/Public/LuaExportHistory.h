@@ -0,0 +1,54 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/** 单次运行的历史记录 */
+struct FLuaExportRunRecord
+{
+    FString                 RunType;        // 运行类型，如 "Full"、"Scan+Incremental"
+    FDateTime               Time;           // 开始时间（UTC）
+    TMap<FString, double>   PhaseSeconds;   // 阶段名 -> 墙钟时间，"Total"为整轮耗时
+    TMap<FString, int64>    Counts;         // 计数名 -> 数量
+};
+
+/** 阶段耗时相对基线的退化 */
+struct FLuaPhaseRegression
+{
+    FString     Phase;                  // 阶段名
+    double      Seconds = 0.0;          // 本次耗时
+    double      BaselineSeconds = 0.0;  // 基线（同类型运行每条目耗时的中位数 x 本次条目数）
+    int32       BaselineRuns = 0;       // 参与基线计算的运行次数
+};
+
+/**
+ * 导出性能历史
+ * 每轮运行追加一条记录到本地历史文件（超过保留期的记录会被删除），
+ * 并与最近若干天同类型运行的中位数比较，找出明显变慢的阶段
+ */
+class EMMYLUAINTELLISENSE_API FLuaExportHistory
+{
+public:
+    /** 加载历史文件，文件不存在或版本不符时从空历史开始 */
+    void Load(const FString& InHistoryFilePath);
+
+    /** 历史文件路径，未加载时为空 */
+    const FString& GetFilePath() const { return HistoryFilePath; }
+
+    /** 追加一条记录并写回文件 */
+    void Append(FLuaExportRunRecord&& Record);
+
+    /**
+     * 与基线比较，返回耗时超过基线Threshold倍的阶段
+     * 基线为BaselineDays天内、Record之前同类型运行按处理条目数归一化后的中位数，
+     * 换算到Record的条目数后比较；样本不足或耗时过短的阶段不比较
+     */
+    void FindRegressions(const FLuaExportRunRecord& Record, int32 BaselineDays, float Threshold, TArray<FLuaPhaseRegression>& OutRegressions) const;
+
+private:
+    void Save() const;
+
+    FString                         HistoryFilePath;
+    TArray<FLuaExportRunRecord>     Records;        // 按时间顺序
+};
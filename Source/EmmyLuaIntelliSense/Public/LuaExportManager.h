@@ -4,10 +4,59 @@
 
 #include "CoreMinimal.h"
 #include "AssetRegistry/AssetRegistryModule.h"
+#include "Modules/ModuleManager.h"
+#include "Misc/SecureHash.h"
+#include "Containers/Queue.h"
+#include "Misc/Optional.h"
+#include "HAL/ThreadSafeBool.h"
+#include "Async/TaskGraphInterfaces.h"
 #include "Engine/Blueprint.h"
 #include "EditorSubsystem.h"
+#include "LuaCodeGenerator.h"
+#include "LuaSymbolIndex.h"
+#include "LuaExportReport.h"
+#include "LuaExportPlatformFile.h"
+#include "LuaChangeRecorder.h"
 #include "LuaExportManager.generated.h"
 
+/** 异步扫描的单条结果，只保留路径和指纹，不持有FAssetData */
+struct FLuaScanRecord
+{
+    FName                           ObjectPath;         // 蓝图对象路径或原生类型路径
+    TWeakObjectPtr<const UField>    NativeType;         // 原生类型，蓝图为空
+    FSHAHash                        Fingerprint;        // 分析阶段计算的指纹，未计算时为全零
+    bool                            bPending = false;   // 分析后是否需要导出
+};
+
+/**
+ * 异步扫描结果
+ * 收集、分析、提交各阶段依次独占同一份数据，阶段之间只传递共享指针，交接开销与结果规模无关
+ */
+struct FLuaScanResults
+{
+    TArray<FLuaScanRecord>  Blueprints;
+    TArray<FLuaScanRecord>  NativeTypes;
+};
+typedef TSharedRef<FLuaScanResults, ESPMode::ThreadSafe> FLuaScanResultsRef;
+
+/** 资产注册表发现阶段预先计算的蓝图指纹，扫描使用前按文件时间戳校验 */
+struct FLuaPrefetchedFingerprint
+{
+    FSHAHash    Hash;
+    FDateTime   TimeStamp;      // 计算指纹之前读取的文件时间戳
+};
+
+/** 输出重定向期间保存的导出状态，结束重定向时恢复 */
+struct FLuaSavedOutputState
+{
+    FString                 OutputDir;
+    FString                 ExportCacheFilePath;
+    FString                 CachedOutputSignature;
+    TMap<FName, FSHAHash>   ExportedFilesHashCache;
+    FLuaSymbolIndex         SymbolIndex;
+    bool                    bExportCacheDirty = false;
+};
+
 /**
  * 增量导出管理器
  * 负责监听UE反射代码变化并管理Lua文件的增量导出
@@ -17,14 +66,16 @@ class EMMYLUAINTELLISENSE_API ULuaExportManager : public UEditorSubsystem
 {
     GENERATED_BODY()
 
+    friend struct FLuaExportTestAccess;
+
 private:
     bool                                    bInitialized;                                    // 是否已初始化
     FString                                 OutputDir;                                       // 输出目录
     TSet<FString>                           PendingBlueprints;                              // 待导出的蓝图资源
     TSet<TWeakObjectPtr<const UField>>      PendingNativeTypes;                              // 待导出的原生类型
     FString                                 ExportCacheFilePath;                             // 导出状态缓存文件路径
-    TMap<FString, FString>                  ExportedFilesHashCache;                         // 已导出文件的哈希值缓存
-    mutable TMap<const UField*, FString>    FieldHashCache;                                  // UField的Hash缓存
+    TMap<FName, FSHAHash>                   ExportedFilesHashCache;                         // 已导出文件的哈希值缓存（对象路径 -> SHA1摘要）
+    mutable TMap<const UField*, FSHAHash>   FieldHashCache;                                  // UField的Hash缓存
     mutable TMap<const UField*, double>    FieldHashCacheTimestamp;                         // UField Hash缓存的时间戳
     bool                                    bIsAsyncScanningInProgress;                      // 异步扫描相关
     TSharedPtr<class SNotificationItem>     ScanProgressNotification;                        // 扫描进度通知
@@ -35,6 +86,41 @@ private:
     int32                                   CurrentBlueprintIndex;                           // 分帧处理相关
     int32                                   CurrentNativeTypeIndex;                          // 分帧处理相关
     FTimerHandle                            FramedProcessingTimerHandle;                     // 分帧处理相关
+    bool                                    bExportCacheDirty;                               // 导出缓存是否有未保存的修改
+    int32                                   WrittenFileCount;                                // 本次导出实际写入的文件数
+    int32                                   UnchangedFileCount;                              // 本次导出内容未变化而跳过写入的文件数
+    TSet<FString>                           DirtyBundleModules;                              // 模块打包模式下待重新打包的模块
+    TMap<FName, FSHAHash>                   PendingBundleHashes;                             // 模块打包模式下待打包类型的哈希，模块写入后才更新导出缓存
+    FString                                 CachedOutputSignature;                           // 导出缓存对应的输出配置签名
+    FLuaSymbolIndex                         SymbolIndex;                                     // 导出符号索引
+    mutable FLuaExportReport                ExportReport;                                    // 本轮扫描/导出的性能报告
+    FString                                 ExportReportFilePath;                            // 性能报告文件路径
+    TUniquePtr<FLuaExportPlatformFile>      ExportFile;                                      // 导出管线的文件层，文件操作计入性能报告
+    TUniquePtr<IPlatformFile>               ThrottledFile;                                   // 慢速存储模拟层（测试用），设置了模拟延迟或带宽时才创建并接到ExportFile下层
+    FLuaChangeRecorder                      ChangeRecorder;                                  // 变更事件录制
+    TSet<TWeakObjectPtr<UBlueprint>>        CompilingBlueprints;                             // 本轮编译中的蓝图，编译完成后转为变更事件
+    TMap<FString, FLuaChangeEvent>          CoalescedChanges;                                // 合并窗口内的变更事件，同一路径只保留一条
+    int32                                   CoalescedEventCount;                             // 合并窗口内收到的原始事件数
+    double                                  FirstChangeTime;                                 // 合并窗口内第一个事件的时间
+    double                                  LastChangeTime;                                  // 合并窗口内最后一个事件的时间
+    FDelegateHandle                         CoalesceTickerHandle;                            // 合并窗口的检查定时器
+    bool                                    bIsFlushingChanges;                              // 正在处理合并的批次（导出进度框内可能重入）
+    FLuaChangeBatchStats                    ChangeBatchStats;                                // 合并批次的累计统计
+    TQueue<FName, EQueueMode::Spsc>         PrefetchQueue;                                   // 发现阶段待预先计算指纹的蓝图
+    TMap<FName, FLuaPrefetchedFingerprint>  PrefetchedFingerprints;                          // 发现阶段预先计算的蓝图指纹
+    mutable FCriticalSection                PrefetchLock;                                    // 保护PrefetchedFingerprints
+    FThreadSafeBool                         bPrefetchRunning;                                // 预计算任务是否在运行
+    FGraphEventRef                          PrefetchTask;                                    // 最近一次启动的预计算任务（以上一次为前置），关闭时等待它结束
+    FThreadSafeBool                         bPrefetchStopRequested;                          // 请求预计算任务退出
+    FDelegateHandle                         AssetAddedHandle;                                // 编辑器回调句柄
+    FDelegateHandle                         AssetRemovedHandle;                              // 编辑器回调句柄
+    FDelegateHandle                         AssetRenamedHandle;                              // 编辑器回调句柄
+    FDelegateHandle                         AssetUpdatedHandle;                              // 编辑器回调句柄
+    FDelegateHandle                         BlueprintPreCompileHandle;                       // 编辑器回调句柄
+    FDelegateHandle                         BlueprintCompiledHandle;                         // 编辑器回调句柄
+    FDelegateHandle                         ModulesChangedHandle;                            // 编辑器回调句柄
+    TSet<FName>                             SyntheticTypePackages;                           // 压力测试合成类型所在的包，其中的类型不带原生标记也按原生类型收集
+    TOptional<FLuaSavedOutputState>         SavedOutputState;                                // 输出重定向前的导出状态，未重定向时为空
 
     // 缓存失效时间（秒）
     static constexpr double HASH_CACHE_EXPIRE_TIME = 300.0; // 5分钟
@@ -54,10 +140,26 @@ public:
     // 导出相关
     // ---------------------------------------------------------
     void            ExportAll();                                                 // 执行全量导出
-    void            ExportIncremental();                                         // 执行增量导出
+    void            ExportIncremental(bool bInteractive = true);                 // 执行增量导出（bInteractive为false时不显示进度框和完成通知）
     bool            HasPendingChanges() const;                                  // 检查是否有待导出的变更
     void            ClearPendingChanges();                                      // 清除待导出的变更记录
 
+    // ---------------------------------------------------------
+    // 变更事件
+    // ---------------------------------------------------------
+    void            HandleChangeEvent(const FLuaChangeEvent& Event);            // 处理变更事件（编辑器回调和重放共用的入口），先进入合并窗口
+    void            FlushChangeEvents(bool bExport = true);                     // 立即处理合并窗口内的事件，并按需增量导出
+    const FLuaChangeBatchStats& GetChangeBatchStats() const { return ChangeBatchStats; } // 获取合并批次统计
+    void            ResetChangeBatchStats() { ChangeBatchStats = FLuaChangeBatchStats(); } // 清空合并批次统计
+    FLuaChangeRecorder& GetChangeRecorder() { return ChangeRecorder; }           // 获取变更事件录制器
+
+    // ---------------------------------------------------------
+    // 输出重定向
+    // ---------------------------------------------------------
+    void            BeginOutputRedirect(const FString& RootDir);                // 把输出目录和导出缓存临时指向RootDir（重放和测试使用），不影响工程的正式输出
+    void            EndOutputRedirect();                                        // 恢复重定向前的输出目录和导出缓存
+    bool            IsOutputRedirected() const { return SavedOutputState.IsSet(); } // 是否处于输出重定向中
+
     // ---------------------------------------------------------
     // 待处理文件查询
     // ---------------------------------------------------------
@@ -72,6 +174,7 @@ public:
     void            ScanExistingAssets();                                       // 扫描现有资源并添加到待导出列表
     void            ScanExistingAssetsAsync();                                 // 异步扫描现有资源并添加到待导出列表
     void            CancelAsyncScan();                                          // 取消异步扫描
+    void            DiscardPrefetchedFingerprints();                            // 不进行启动扫描时停止并释放发现阶段预先计算的指纹
 
     // ---------------------------------------------------------
     // 分帧处理相关
@@ -86,15 +189,24 @@ private:
     // 核心导出功能
     // ---------------------------------------------------------
     bool            AddToPendingBlueprints(const FAssetData& AssetData);        // 添加蓝图到待导出列表
+    void            AddToPendingNativeTypes(const UField* Field);                // 添加原生类型到待导出列表
+    void            RemoveExportedModule(const FString& ModuleName);            // 删除模块已导出的文件和缓存记录
+    void            RemoveExportedBlueprint(const FString& AssetPath);           // 删除蓝图已导出的文件和缓存记录
     void            ExportBlueprint(const UBlueprint* Blueprint);             // 导出单个蓝图
+    static FString  GetBlueprintFileName(const FString& BlueprintPath, const UBlueprint* Blueprint); // 蓝图导出文件名（导出和删除共用）
     void            ExportNativeType(const UField* Field);                      // 导出单个原生类型
     void            ExportUETypes(const TArray<const UField*>& Types);          // 导出UE核心类型
     void            CollectNativeTypes(TArray<const UField*>& Types);            // 收集所有原生类型
+    bool            IsExportableNativeType(const UField* Field) const;           // 是否为需要导出的原生类、结构体或枚举（全量扫描和模块加载共用）
+    bool            GenerateNativeTypeCode(const UField* Field, bool bEmitReturn, FLuaDialectCode& OutCode) const; // 生成原生类型所有启用方言的Lua代码
+    void            FlushModuleBundles(const TArray<const UField*>& AllNativeTypes); // 重新打包所有待处理的模块
+    void            SaveModuleBundle(const FString& ModuleName, const TArray<const UField*>& ModuleTypes); // 打包并保存单个模块
 
     // ---------------------------------------------------------
     // 资源判断和验证
     // ---------------------------------------------------------
     static bool     IsBlueprint(const FAssetData& AssetData);                    // 判断是否为蓝图资源
+    UBlueprint*     LoadBlueprint(const FString& ObjectPath) const;             // 加载蓝图资源
     bool            ShouldExportBlueprint(const FAssetData& AssetData, bool bLoad = false) const; // 判断蓝图是否应该导出
     bool            IsValidFieldForExport(const UField* Field, FString& OutFieldName) const; // 验证UField是否有效且名称合法
     bool            ShouldExcludeFromExport(const FString& AssetPath) const;    // 检查路径是否应该被排除在导出之外
@@ -102,10 +214,12 @@ private:
     // ---------------------------------------------------------
     // 文件操作
     // ---------------------------------------------------------
-    void            SaveFile(const FString& ModuleName, const FString& FileName, const FString& Content); // 保存文件
-    void            DeleteFile(const FString& ModuleName, const FString& FileName); // 删除文件
+    void            SaveFile(const FString& ModuleName, const FString& FileName, const FString& Content, EEmmyLuaDialect Dialect = EEmmyLuaDialect::EmmyLua); // 保存文件
+    void            DeleteFile(const FString& ModuleName, const FString& FileName, EEmmyLuaDialect Dialect = EEmmyLuaDialect::EmmyLua); // 删除文件
     FString         GetOutputDirectory() const;                                 // 获取输出目录
-    void            CopyUELibFolder() const;                                    // 拷贝UELib文件夹到输出目录
+    FString         GetDialectOutputDir(EEmmyLuaDialect Dialect) const;         // 获取方言的输出根目录
+    static FString  GetRelativeOutputPath(const FString& ModuleName, const FString& FileName); // 获取相对输出目录的文件路径
+    void            CopyUELibFolder(const FString& TargetRootDir) const;        // 拷贝UELib文件夹到输出目录
 
     // ---------------------------------------------------------
     // 缓存管理
@@ -113,18 +227,25 @@ private:
     void            LoadExportCache();                                          // 加载导出缓存
     void            SaveExportCache();                                          // 保存导出缓存
     bool            ShouldReexport(const FString& AssetPath, const FString& AssetFilePath) const; // 检查文件是否需要重新导出（基于哈希值）
-    bool            ShouldReexportByHash(const FString& AssetPath, const FString& AssetHash) const; // 检查文件是否需要重新导出（基于哈希值）
-    void            UpdateExportCacheByHash(const FString& AssetPath, const FString& AssetHash); // 更新导出缓存中的Hash值
-    FString         GetCachedFieldHash(const UField* Field) const;               // 获取UField的缓存哈希值（带缓存优化）
+    bool            ShouldReexportByHash(FName AssetPath, const FSHAHash& AssetHash) const; // 检查文件是否需要重新导出（基于哈希值）
+    void            UpdateExportCacheByHash(FName AssetPath, const FSHAHash& AssetHash); // 更新导出缓存中的Hash值
+    FSHAHash        GetCachedFieldHash(const UField* Field) const;               // 获取UField的缓存哈希值（带缓存优化）
     void            CleanupExpiredHashCache() const;                             // 清理过期的Hash缓存
+    FString         GetOutputSignature() const;                                 // 获取影响输出内容的配置签名
+    void            ValidateOutputSignature();                                  // 输出配置变化时使导出缓存失效
+    void            BeginExportReport(const TCHAR* RunType);                    // 开始本轮性能报告
+    void            UpdateSimulatedStorageLayer();                              // 按慢速存储模拟的控制台变量接入或移除模拟层
+    void            FinishExportReport(bool bCancelled = false);                // 结束本轮性能报告，性能退化时提示
+    void            ReportRetainedMemory() const;                               // 把各缓存和列表仍占用的内存记到性能报告
 
     // ---------------------------------------------------------
     // 哈希计算
     // ---------------------------------------------------------
-    FString         CalculateFileHash(const FString& FilePath) const;           // 计算文件的哈希值
-    FString         CalculateClassStructureHash(const UClass* Class) const;     // 计算UE类结构签名哈希值
-    FString         GetAssetHash(const FString& AssetPath) const;                // 获取资源的哈希值
-    FString         GetAssetHash(const UField* Field) const;                    // 获取UField的哈希值（用于原生类型）
+    FSHAHash        CalculateFileHash(const FString& FilePath, const TCHAR* PhaseName = TEXT("HashFile")) const; // 计算文件的哈希值，失败时为全零；耗时计入报告的PhaseName阶段
+    FSHAHash        CalculateClassStructureHash(const UClass* Class) const;     // 计算UE类结构签名哈希值
+    FSHAHash        GetAssetHash(const FString& AssetPath) const;                // 获取资源的哈希值
+    bool            ResolveAssetFilePath(const FString& AssetPath, FString& OutFilePath) const; // 获取资源对应的.uasset文件路径
+    FSHAHash        GetAssetHash(const UField* Field) const;                    // 获取UField的哈希值（用于原生类型）
 
     // ---------------------------------------------------------
     // 辅助功能
@@ -132,8 +253,30 @@ private:
     FString         GenerateUnLuaDefinitions() const;                           // 生成UnLua特定的定义
     void            LoadExcludedPathsFromFile(TArray<FString>& OutExcludedPaths) const; // 从JSON文件加载排除路径列表
 
+    // ---------------------------------------------------------
+    // 编辑器回调（转换为变更事件）
+    // ---------------------------------------------------------
+    void            RegisterChangeEvents();                                     // 注册编辑器回调
+    void            UnregisterChangeEvents();                                   // 注销编辑器回调
+    bool            IsWatchingChanges() const;                                  // 是否把编辑器回调转为变更事件（设置开启或正在录制）
+    bool            IsDiscoveringAssets() const;                                // 启动时资产注册表是否仍在发现资产
+    void            ApplyChangeEvent(const FLuaChangeEvent& Event);             // 把合并后的事件更新到待导出列表
+    static bool     CanScanOnStartup();                                         // 当前环境是否会进行启动扫描（预计算指纹的前提）
+    void            QueueFingerprintPrefetch(const FAssetData& AssetData);      // 发现阶段把蓝图加入指纹预计算队列
+    void            RunFingerprintPrefetch();                                   // 后台线程：依次计算队列中蓝图的指纹
+    FSHAHash        GetPrefetchedAssetHash(FName ObjectPath, const FString& AssetPath, bool& bOutPrefetched) const; // 优先使用时间戳未变的预计算指纹
+    bool            TickChangeCoalescing(float DeltaTime);                      // 检查合并窗口是否到期
+    void            OnAssetAdded(const FAssetData& AssetData);                  // 资产新增回调
+    void            OnAssetRemoved(const FAssetData& AssetData);                // 资产删除回调
+    void            OnAssetRenamed(const FAssetData& AssetData, const FString& OldObjectPath); // 资产重命名回调
+    void            OnAssetUpdated(const FAssetData& AssetData);                // 资产保存回调
+    void            OnBlueprintPreCompile(UBlueprint* Blueprint);               // 蓝图开始编译回调
+    void            OnBlueprintCompiled();                                      // 蓝图编译完成回调
+    void            OnModulesChanged(FName ModuleName, EModuleChangeReason Reason); // 模块加载/卸载回调
+
     // ---------------------------------------------------------
     // 异步扫描辅助功能
     // ---------------------------------------------------------
-    void            OnAsyncScanCompleted(const TArray<FAssetData>& BlueprintAssets, const TArray<const UField*>& NativeTypes); // 异步扫描完成回调
+    void            OnAsyncScanCompleted(FLuaScanResultsRef Results);           // 异步扫描完成回调
+    void            FinishCancelledScan(const TCHAR* Message);                  // 扫描被取消后结束报告、关闭进度通知并清除扫描标记（游戏线程）
 };
@@ -0,0 +1,57 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GenericPlatform/GenericPlatformFile.h"
+
+class FLuaExportReport;
+
+/**
+ * 导出管线使用的文件层
+ * 包装下层IPlatformFile，把每次打开、查询、读写的次数、字节数和耗时按当前阶段和目录记到导出报告中，
+ * 用来找出多余的文件查询和读取。只有导出管理器通过它访问文件，不会安装到全局平台文件链上
+ */
+class EMMYLUAINTELLISENSE_API FLuaExportPlatformFile : public IPlatformFile
+{
+public:
+    explicit FLuaExportPlatformFile(FLuaExportReport& InReport);
+
+    // ---------------------------------------------------------
+    // 整文件读写辅助（对应FFileHelper，但经过本文件层）
+    // ---------------------------------------------------------
+    bool            LoadFileToArray(TArray<uint8>& OutData, const TCHAR* Filename);                  // 读取整个文件
+    bool            LoadFileToString(FString& OutString, const TCHAR* Filename);                     // 读取整个文件并按BOM/UTF-8解码
+    bool            SaveStringToFile(const FString& Content, const TCHAR* Filename);                 // 以不带BOM的UTF-8写入整个文件
+
+    // Begin IPlatformFile
+    using IPlatformFile::IterateDirectory;
+    using IPlatformFile::IterateDirectoryStat;
+    virtual bool Initialize(IPlatformFile* Inner, const TCHAR* CmdLine) override;
+    virtual IPlatformFile* GetLowerLevel() override { return LowerLevel; }
+    virtual void SetLowerLevel(IPlatformFile* NewLowerLevel) override { LowerLevel = NewLowerLevel; }
+    virtual const TCHAR* GetName() const override { return TEXT("LuaExportPlatformFile"); }
+    virtual bool FileExists(const TCHAR* Filename) override;
+    virtual int64 FileSize(const TCHAR* Filename) override;
+    virtual bool DeleteFile(const TCHAR* Filename) override;
+    virtual bool IsReadOnly(const TCHAR* Filename) override;
+    virtual bool MoveFile(const TCHAR* To, const TCHAR* From) override;
+    virtual bool SetReadOnly(const TCHAR* Filename, bool bNewReadOnlyValue) override;
+    virtual FDateTime GetTimeStamp(const TCHAR* Filename) override;
+    virtual void SetTimeStamp(const TCHAR* Filename, FDateTime DateTime) override;
+    virtual FDateTime GetAccessTimeStamp(const TCHAR* Filename) override;
+    virtual FString GetFilenameOnDisk(const TCHAR* Filename) override;
+    virtual IFileHandle* OpenRead(const TCHAR* Filename, bool bAllowWrite = false) override;
+    virtual IFileHandle* OpenWrite(const TCHAR* Filename, bool bAppend = false, bool bAllowRead = false) override;
+    virtual bool DirectoryExists(const TCHAR* Directory) override;
+    virtual bool CreateDirectory(const TCHAR* Directory) override;
+    virtual bool DeleteDirectory(const TCHAR* Directory) override;
+    virtual FFileStatData GetStatData(const TCHAR* FilenameOrDirectory) override;
+    virtual bool IterateDirectory(const TCHAR* Directory, FDirectoryVisitor& Visitor) override;
+    virtual bool IterateDirectoryStat(const TCHAR* Directory, FDirectoryStatVisitor& Visitor) override;
+    // End IPlatformFile
+
+private:
+    IPlatformFile*      LowerLevel;     // 实际执行文件操作的平台文件
+    FLuaExportReport&   Report;         // 记录文件操作的报告
+};
@@ -0,0 +1,145 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/CriticalSection.h"
+#include "LuaExportHistory.h"
+
+/** 导出项分类 */
+enum class ELuaExportCategory : uint8
+{
+    Blueprint,
+    NativeType,
+    Count
+};
+
+/** 文件操作类型 */
+enum class ELuaFileOperation : uint8
+{
+    Open,           // 打开文件句柄
+    Stat,           // 存在性、大小、时间戳等查询
+    Read,           // 从句柄读取
+    Write,          // 向句柄写入
+    Directory,      // 创建、删除、遍历目录
+    Modify,         // 删除、移动文件和修改属性
+    Count
+};
+
+/**
+ * 单次扫描/导出的性能报告
+ * 统计各分类的扫描、跳过和导出数量、缓存命中率、按阶段和目录的文件操作、各阶段耗时、
+ * 本轮峰值内存和结束时插件仍持有的内存，以及最耗时的类型，结束时写入JSON文件，用于判断慢在I/O、反射还是蓝图加载
+ * 每轮结果同时追加到历史文件，并与最近几天的中位数比较以发现性能退化
+ * 扫描在后台线程进行，所有接口都是线程安全的
+ */
+class EMMYLUAINTELLISENSE_API FLuaExportReport
+{
+public:
+    /** 阶段计时作用域：累计墙钟时间和当前线程的CPU时间，报告未开始时不计时 */
+    class EMMYLUAINTELLISENSE_API FScopedPhase
+    {
+    public:
+        FScopedPhase(FLuaExportReport& InReport, const TCHAR* InPhaseName);
+        ~FScopedPhase();
+
+    private:
+        FLuaExportReport*   Report;             // 报告未开始时为空
+        const TCHAR*        PhaseName;          // 阶段名称（静态字符串）
+        const TCHAR*        OuterPhaseName;     // 当前线程上外层阶段的名称
+        double              StartWallTime;      // 开始时的墙钟时间
+        double              StartCPUTime;       // 开始时的线程CPU时间
+    };
+
+    /** 开始一轮统计；已在统计中时把RunType追加到本轮的类型上（如扫描后紧接增量导出） */
+    void Begin(const TCHAR* RunType);
+
+    /** 本轮是否正在统计 */
+    bool IsActive() const;
+
+    void AddScanned(ELuaExportCategory Category, int32 Count = 1);
+    void AddSkipped(ELuaExportCategory Category, int32 Count = 1);
+    void AddExported(ELuaExportCategory Category, int32 Count = 1);
+    void AddCacheHit();
+    void AddCacheMiss();
+    void AddFileWritten();
+    void AddFileUnchanged();
+
+    /**
+     * 记录一次文件操作，按当前线程最内层的阶段和Path所在目录归类
+     * Bytes为读写的字节数，其他操作传0
+     */
+    void AddFileOperation(ELuaFileOperation Operation, const TCHAR* Path, int64 Bytes, double Seconds);
+
+    /** 记录结束时插件仍持有的内存（字节），Name为容器分组名，同名覆盖 */
+    void SetRetainedMemory(const TCHAR* Name, int64 Bytes);
+
+    /** 记录单个类型的导出耗时，用于统计最耗时的类型 */
+    void RecordTypeCost(const FString& TypePath, double Seconds);
+
+    /** 生成用于通知的一行摘要 */
+    FString GetSummary() const;
+
+    /**
+     * 结束本轮统计并写入报告文件，bCancelled表示本轮被用户取消
+     * 未取消的运行会追加到同目录的ExportHistory.json，返回相对历史基线明显变慢的阶段
+     */
+    TArray<FLuaPhaseRegression> Finish(const FString& ReportFilePath, bool bCancelled = false);
+
+private:
+    /** 单个阶段的累计耗时 */
+    struct FPhaseTime
+    {
+        double  WallSeconds = 0.0;
+        double  CPUSeconds = 0.0;
+        int32   Calls = 0;
+    };
+
+    /** 单个分类的计数 */
+    struct FCategoryCounts
+    {
+        int32   Scanned = 0;
+        int32   Skipped = 0;
+        int32   Exported = 0;
+    };
+
+    /** 一组文件操作的累计 */
+    struct FFileIOCounts
+    {
+        int32   Operations[static_cast<int32>(ELuaFileOperation::Count)] = {};
+        int64   BytesRead = 0;
+        int64   BytesWritten = 0;
+        double  Seconds = 0.0;
+
+        int32 GetTotalOperations() const;
+    };
+
+    static TSharedPtr<class FJsonObject> FileIOToJson(const FFileIOCounts& Counts);
+
+    void AddPhaseTime(const TCHAR* PhaseName, double WallSeconds, double CPUSeconds);
+    void SampleMemory();
+    FLuaExportRunRecord BuildRunRecord() const;
+    FString BuildJson(bool bCancelled, const TArray<FLuaPhaseRegression>& Regressions) const;
+
+    mutable FCriticalSection                    Lock;
+    bool                                        bActive = false;
+    FString                                     RunType;                // 本轮类型，如 "Scan+Incremental"
+    FDateTime                                   StartTime;              // 本轮开始时间
+    double                                      StartWallTime = 0.0;    // 本轮开始时的墙钟时间
+    uint64                                      StartUsedPhysical = 0;  // 本轮开始时的物理内存占用
+    uint64                                      RunPeakUsedPhysical = 0;// 本轮阶段结束时采样到的最大物理内存占用
+    double                                      LastMemorySampleTime = 0.0;
+    TMap<FString, int64>                        RetainedMemory;         // 容器分组 -> 结束时仍持有的字节数
+    FCategoryCounts                             Categories[static_cast<int32>(ELuaExportCategory::Count)];
+    int32                                       CacheHits = 0;
+    int32                                       CacheMisses = 0;
+    FFileIOCounts                               FileIO;                 // 本轮全部文件操作
+    TMap<FString, FFileIOCounts>                FileIOByPhase;          // 最内层阶段名 -> 文件操作
+    TMap<FString, FFileIOCounts>                FileIOByDirectory;      // 目录 -> 文件操作
+    int32                                       FilesWritten = 0;
+    int32                                       FilesUnchanged = 0;
+    TMap<FString, FPhaseTime>                   Phases;                 // 阶段名 -> 累计耗时（嵌套阶段各自包含子阶段）
+    TArray<TPair<FString, double>>              TypeCosts;              // 类型路径 -> 导出耗时
+    FCriticalSection                            HistoryLock;            // 保护History，历史文件读写不持有Lock
+    FLuaExportHistory                           History;                // 历史记录，首次结束时加载
+};
@@ -0,0 +1,76 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/** 符号类型 */
+enum class ELuaSymbolKind : uint8
+{
+    Type,       // ---@class
+    Field,      // ---@field
+    Function,   // function Owner:Name() / function Owner.Name()
+};
+
+/** 单个导出符号 */
+struct FLuaSymbolEntry
+{
+    FString         Name;       // 符号名
+    FString         Owner;      // 所属类型（类型本身为空）
+    ELuaSymbolKind  Kind;       // 符号类型
+    int32           Line;       // 所在行号（从1开始）
+
+    bool operator==(const FLuaSymbolEntry& Other) const
+    {
+        return Kind == Other.Kind && Line == Other.Line
+            && Name.Equals(Other.Name, ESearchCase::CaseSensitive)
+            && Owner.Equals(Other.Owner, ESearchCase::CaseSensitive);
+    }
+};
+
+/**
+ * Lua符号索引
+ * 记录每个导出文件中定义的类型、字段和函数及其行号，
+ * IDE插件和编辑器工具可以直接读取索引进行跳转和补全，无需解析整个存根目录
+ */
+class EMMYLUAINTELLISENSE_API FLuaSymbolIndex
+{
+public:
+    /** 从索引文件加载，文件不存在或版本不匹配时从空索引开始并返回false */
+    bool Load(const FString& InIndexFilePath);
+
+    /**
+     * 扫描输出目录中已有的.lua文件重建索引
+     * 导出时哈希缓存未变的类型不会经过SaveFile，索引缺失或过期时只能从磁盘上的输出补建
+     */
+    void Rebuild(const FString& OutputRoot, const TArray<FString>& ExcludedSubdirs);
+
+    /** 索引有变化时写入索引文件 */
+    void Save();
+
+    /** 用文件内容更新该文件的符号（RelativePath为相对输出目录的路径） */
+    void UpdateFile(const FString& RelativePath, const FString& Content);
+
+    /** 移除文件的符号 */
+    void RemoveFile(const FString& RelativePath);
+
+    /** 清空索引 */
+    void Reset();
+
+    /** 索引中是否已有该文件 */
+    bool ContainsFile(const FString& RelativePath) const { return FileSymbols.Contains(RelativePath); }
+
+    /** 获取符号总数 */
+    int32 GetSymbolCount() const;
+
+    /** 索引占用的堆内存（字节） */
+    SIZE_T GetAllocatedSize() const;
+
+    /** 从生成的Lua代码中解析符号 */
+    static void ParseSymbols(const FString& Content, TArray<FLuaSymbolEntry>& OutSymbols);
+
+private:
+    FString                                 IndexFilePath;      // 索引文件路径
+    TMap<FString, TArray<FLuaSymbolEntry>>  FileSymbols;        // 文件 -> 符号列表
+    bool                                    bDirty = false;     // 是否有未保存的修改
+};
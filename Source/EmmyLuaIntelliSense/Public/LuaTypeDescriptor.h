@@ -0,0 +1,62 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/** 类型描述的种类 */
+enum class ELuaTypeKind : uint8
+{
+    Blueprint,
+    Class,
+    Struct,
+    Enum,
+};
+
+/** 字段（属性）描述 */
+struct FLuaFieldDescriptor
+{
+    FString     Name;           // 已转义的字段名
+    FString     Type;           // 字段类型名
+    FString     Comment;        // 已转义的注释
+};
+
+/** 函数参数描述 */
+struct FLuaParamDescriptor
+{
+    FString     Name;           // 已转义的参数名
+    FString     Type;           // 参数类型名
+};
+
+/** 函数描述 */
+struct FLuaFunctionDescriptor
+{
+    FString                         Name;           // 已转义的函数名
+    FString                         Comment;        // 已转义的注释
+    TArray<FLuaParamDescriptor>     Params;         // 输入参数
+    FString                         ReturnType;     // 返回值类型，无返回值时为空
+    bool                            bStatic = false;// 是否为静态函数
+};
+
+/** 枚举值描述 */
+struct FLuaEnumValueDescriptor
+{
+    FString     Name;           // 已转义的枚举值名
+    int64       Value = 0;      // 枚举值
+};
+
+/**
+ * 与注解方言无关的类型描述
+ * 由反射信息遍历一次生成，再交给各方言的输出策略渲染
+ */
+struct FLuaTypeDescriptor
+{
+    ELuaTypeKind                        Kind = ELuaTypeKind::Class;
+    FString                             Name;           // 类型名
+    FString                             SuperName;      // 父类型名，没有父类型时为空
+    FString                             Comment;        // 已转义的注释
+    FString                             FunctionOwner;  // 函数定义所用的表名（蓝图为生成类名）
+    TArray<FLuaFieldDescriptor>         Fields;
+    TArray<FLuaFunctionDescriptor>      Functions;
+    TArray<FLuaEnumValueDescriptor>     EnumValues;
+};